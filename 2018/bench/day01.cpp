@@ -0,0 +1,142 @@
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "PrefixSums.hpp"
+#include "day01.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day01 {
+
+static void BM_parseFrequencyChanges(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseFrequencyChanges(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_parseFrequencyChanges)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Complexity();
+
+// Parsing with the prefix sums of the changes in the same pass
+static void BM_readFrequencyLog(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(readFrequencyLog(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_readFrequencyLog)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Complexity();
+
+static void BM_sum(benchmark::State& state)
+{
+    std::vector<int> values = parseFrequencyChanges(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sum(values));
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_sum)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Complexity();
+
+static void BM_prefixSums(benchmark::State& state)
+{
+    std::vector<int> values = parseFrequencyChanges(generateInput(state.range(0), benchmarking::defaultSeed));
+    std::vector<long> sums(values.size());
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(simd::prefixSums(values, 0, sums.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_prefixSums)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Complexity();
+
+static void BM_findFirstDuplicateFrequency(benchmark::State& state)
+{
+    std::vector<int> values = parseFrequencyChanges(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findFirstDuplicateFrequency(values));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_findFirstDuplicateFrequency)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond)->Complexity();
+
+static void BM_findFirstRepeatInClosedForm(benchmark::State& state)
+{
+    std::vector<int> values = parseFrequencyChanges(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findFirstRepeatInClosedForm(values));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_findFirstRepeatInClosedForm)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond)->Complexity();
+
+// The simulation with each visited set on its own
+template<typename Visited>
+static void BM_simulateFirstRepeat(benchmark::State& state)
+{
+    FrequencyLog log = readFrequencyLog(generateInput(state.range(0), benchmarking::defaultSeed));
+    SimulationBounds bounds(log);
+
+    for (auto _ : state)
+    {
+        std::optional<long> repeated;
+        if constexpr (std::is_same_v<Visited, FrequencyBitmap>)
+        {
+            FrequencyBitmap visited(bounds.lowest, bounds.highest);
+            repeated = simulateFirstRepeat(log, visited, bounds.passes);
+        }
+        else
+        {
+            Visited visited(log.getChanges().size());
+            repeated = simulateFirstRepeat(log, visited, bounds.passes);
+        }
+        benchmark::DoNotOptimize(repeated);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_simulateFirstRepeat<FrequencyBitmap>)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond)->Complexity();
+BENCHMARK(BM_simulateFirstRepeat<FrequencyHashSet>)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond)->Complexity();
+
+// Frequencies 0, p, 2p, ... and a drift of 1: each frequency comes back
+// only after p passes
+static std::vector<int> generateManyPasses(size_t count, int passes)
+{
+    std::vector<int> values(count - 1, passes);
+    values.push_back(1 - static_cast<int>(count - 1) * passes);
+    return values;
+}
+
+static void BM_findFirstDuplicateFrequencyManyPasses(benchmark::State& state)
+{
+    std::vector<int> values = generateManyPasses(state.range(0), 1 << 16);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findFirstDuplicateFrequency(values));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_findFirstDuplicateFrequencyManyPasses)->RangeMultiplier(8)->Range(1 << 10, 1 << 14)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oNLogN);
+
+}
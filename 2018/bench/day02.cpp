@@ -0,0 +1,67 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day02.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day02 {
+
+static void BM_parseIds(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseIds(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_parseIds)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+
+static void BM_calculateChecksum(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    std::vector<std::string_view> ids = parseIds(text);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(calculateChecksum(ids));
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_calculateChecksum)->RangeMultiplier(8)->Range(1 << 8, 1 << 17)->Complexity();
+
+static void BM_findWordsWhichDifferByOneLetter(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    std::vector<std::string_view> ids = parseIds(text);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findWordsWhichDifferByOneLetter(ids));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_findWordsWhichDifferByOneLetter)->RangeMultiplier(4)->Range(1 << 8, 1 << 20)->Complexity(benchmark::oN);
+
+static void BM_findAllPairsWhichDifferByOneLetter(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    std::vector<std::string_view> ids = parseIds(text);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findPairsWhichDifferByOneLetter(ids, Matches::all));
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_findAllPairsWhichDifferByOneLetter)->RangeMultiplier(4)->Range(1 << 8, 1 << 20)->Complexity(benchmark::oN);
+
+}
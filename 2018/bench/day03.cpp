@@ -0,0 +1,50 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day03.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day03 {
+
+static void BM_parseClaims(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseClaims(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_parseClaims)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+
+static void BM_calculateOverlap(benchmark::State& state)
+{
+    std::vector<Rect> claims = parseClaims(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(calculateOverlap(claims));
+    }
+    state.SetItemsProcessed(state.iterations() * claims.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_calculateOverlap)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Unit(benchmark::kMillisecond)->Complexity();
+
+static void BM_findFirstNotOverlapping(benchmark::State& state)
+{
+    std::vector<Rect> claims = parseClaims(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findFirstNotOverlapping(claims));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_findFirstNotOverlapping)->RangeMultiplier(4)->Range(1 << 8, 1 << 12)->Unit(benchmark::kMillisecond)->Complexity();
+
+}
@@ -0,0 +1,49 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day04.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day04 {
+
+static void BM_parseLog(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseLog(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_parseLog)->RangeMultiplier(8)->Range(1 << 6, 1 << 14)->Unit(benchmark::kMillisecond)->Complexity();
+
+static void BM_whoSleptMost(benchmark::State& state)
+{
+    GuardLog log = parseLog(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        int id = log.whoSleptMost();
+        benchmark::DoNotOptimize(log.getGuards().at(id).getMostSleptMinute());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_whoSleptMost)->RangeMultiplier(8)->Range(1 << 6, 1 << 14)->Unit(benchmark::kMillisecond)->Complexity();
+
+static void BM_whoIsMostFrequentlySleepingOnSameMinute(benchmark::State& state)
+{
+    GuardLog log = parseLog(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(log.whoIsMostFrequentlySleepingOnSameMinute());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_whoIsMostFrequentlySleepingOnSameMinute)->RangeMultiplier(8)->Range(1 << 6, 1 << 14)->Unit(benchmark::kMillisecond)->Complexity();
+
+}
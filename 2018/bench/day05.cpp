@@ -0,0 +1,40 @@
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day05.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day05 {
+
+static void BM_findPolymer(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    std::string_view polymer = std::string_view(text).substr(0, state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findPolymer(polymer));
+    }
+    state.SetBytesProcessed(state.iterations() * polymer.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_findPolymer)->RangeMultiplier(4)->Range(1 << 8, 1 << 18)->Complexity();
+
+static void BM_findShortestPolymer(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    std::string_view polymer = std::string_view(text).substr(0, state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(findShortestPolymer(polymer));
+    }
+    state.SetBytesProcessed(state.iterations() * polymer.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_findShortestPolymer)->RangeMultiplier(4)->Range(1 << 8, 1 << 16)->Unit(benchmark::kMillisecond)->Complexity();
+
+}
@@ -0,0 +1,51 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day06.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day06 {
+
+static void BM_parseCoordinates(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseCoordinates(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_parseCoordinates)->RangeMultiplier(8)->Range(1 << 6, 1 << 18)->Complexity();
+
+static void BM_largestFiniteArea(benchmark::State& state)
+{
+    std::vector<Point> coordinates = parseCoordinates(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        Map map(coordinates);
+        benchmark::DoNotOptimize(map.getLargestFiniteAreaAroundOneCoordinate());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_largestFiniteArea)->RangeMultiplier(2)->Range(16, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+static void BM_areaWithMaxDistanceToEachCoordinate(benchmark::State& state)
+{
+    std::vector<Point> coordinates = parseCoordinates(generateInput(state.range(0), benchmarking::defaultSeed));
+    Map map(coordinates);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.getAreaWithMaxDistanceToEachCoordinate(10000));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_areaWithMaxDistanceToEachCoordinate)->RangeMultiplier(2)->Range(16, 256)->Unit(benchmark::kMillisecond)->Complexity();
+
+}
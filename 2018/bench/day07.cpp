@@ -0,0 +1,47 @@
+#include <map>
+#include <set>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day07.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day07 {
+
+static void BM_parseInput(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseInput(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_parseInput)->DenseRange(6, 26, 10);
+
+static void BM_sortSteps(benchmark::State& state)
+{
+    Steps steps = parseInput(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sortSteps(steps));
+    }
+}
+BENCHMARK(BM_sortSteps)->DenseRange(6, 26, 10);
+
+static void BM_processInParallel(benchmark::State& state)
+{
+    Steps steps = parseInput(generateInput(26, benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(processInParallel(steps, state.range(0), 60));
+    }
+}
+BENCHMARK(BM_processInParallel)->DenseRange(1, 9, 4);
+
+}
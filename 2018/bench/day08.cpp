@@ -0,0 +1,40 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day08.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day08 {
+
+static void BM_parseTree(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseTree(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_parseTree)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+
+static void BM_Parser(benchmark::State& state)
+{
+    std::vector<int> tree = parseTree(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        Parser p(tree);
+        benchmark::DoNotOptimize(p.getSumOfMetadata());
+        benchmark::DoNotOptimize(p.getRootValue());
+    }
+    state.SetItemsProcessed(state.iterations() * tree.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Parser)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+
+}
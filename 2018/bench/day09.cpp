@@ -0,0 +1,18 @@
+#include <benchmark/benchmark.h>
+
+#include "day09.hpp"
+
+namespace aoc2018::day09 {
+
+static void BM_getHighscore(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(getHighscore(473, state.range(0)));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_getHighscore)->RangeMultiplier(10)->Range(70904, 70904 * 100)->Unit(benchmark::kMillisecond)->Complexity();
+
+}
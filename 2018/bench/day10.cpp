@@ -0,0 +1,38 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day10.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day10 {
+
+static void BM_parsePoints(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parsePoints(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_parsePoints)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+
+static void BM_waitForMessage(benchmark::State& state)
+{
+    const std::vector<Point> initial = parsePoints(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        std::vector<Point> points = initial;
+        benchmark::DoNotOptimize(waitForMessage(points));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_waitForMessage)->RangeMultiplier(4)->Range(1 << 8, 1 << 12)->Unit(benchmark::kMillisecond)->Complexity();
+
+}
@@ -0,0 +1,18 @@
+#include <benchmark/benchmark.h>
+
+#include "day11.hpp"
+
+namespace aoc2018::day11 {
+
+static void BM_PowerGrid(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        PowerGrid grid(state.range(0));
+        benchmark::DoNotOptimize(grid.getSquareWithHighestPowerBySize(3));
+        benchmark::DoNotOptimize(grid.getSquareWithHighestPower());
+    }
+}
+BENCHMARK(BM_PowerGrid)->Arg(18)->Arg(5719)->Unit(benchmark::kMillisecond);
+
+}
@@ -0,0 +1,41 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day12.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day12 {
+
+static void BM_parsePots(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parsePots(text).getSum());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_parsePots)->RangeMultiplier(8)->Range(1 << 7, 1 << 16)->Complexity();
+
+static void BM_advance(benchmark::State& state)
+{
+    const Pots initial = parsePots(generateInput(state.range(0), benchmarking::defaultSeed));
+
+    for (auto _ : state)
+    {
+        Pots pots = initial;
+        for (int generation = 0; generation < 20; ++generation)
+        {
+            pots.advance();
+        }
+        benchmark::DoNotOptimize(pots.getSum());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_advance)->RangeMultiplier(4)->Range(1 << 7, 1 << 13)->Unit(benchmark::kMillisecond)->Complexity();
+
+}
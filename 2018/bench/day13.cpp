@@ -0,0 +1,50 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day13.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day13 {
+
+static void BM_read(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    Rails rails;
+    Carts carts;
+
+    for (auto _ : state)
+    {
+        carts.clear();
+        MapReader::read(text, carts, rails);
+        benchmark::DoNotOptimize(carts.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_read)->RangeMultiplier(2)->Range(16, 512)->Complexity();
+
+static void BM_tick(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    Navigator navigator;
+    Rails rails;
+    Carts initial;
+    MapReader::read(text, initial, rails);
+
+    for (auto _ : state)
+    {
+        Carts carts = initial;
+        Carts crashed;
+        for (int tick = 0; tick < 1000; ++tick)
+        {
+            navigator.tick(carts, crashed, rails);
+        }
+        benchmark::DoNotOptimize(carts.data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_tick)->RangeMultiplier(2)->Range(16, 512)->Unit(benchmark::kMillisecond)->Complexity();
+
+}
@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+
+#include "day14.hpp"
+
+namespace aoc2018::day14 {
+
+static void BM_Recipes(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        Recipes recipes(state.range(0));
+        benchmark::DoNotOptimize(recipes.get(state.range(0) - 10));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Recipes)->RangeMultiplier(8)->Range(1 << 12, 20231900)->Unit(benchmark::kMillisecond);
+
+static void BM_find(benchmark::State& state)
+{
+    Recipes recipes(20231900);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(recipes.find({5, 0, 5, 9, 6, 1}));
+    }
+}
+BENCHMARK(BM_find)->Unit(benchmark::kMillisecond);
+
+}
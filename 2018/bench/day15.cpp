@@ -0,0 +1,44 @@
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day15.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day15 {
+
+// The generated caves hold one unit per row and the map has room for 31
+// units, which caps the size of the caves.
+
+static void BM_readMap(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        Map map(text);
+        benchmark::DoNotOptimize(map.getUnits().data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_readMap)->DenseRange(8, 31, 8)->Complexity();
+
+static void BM_runGame(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    const Map initial(text);
+
+    for (auto _ : state)
+    {
+        Map map(initial);
+        Game game(map);
+        game.run();
+        benchmark::DoNotOptimize(game.getOutcome());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_runGame)->DenseRange(8, 31, 8)->Unit(benchmark::kMillisecond)->Complexity();
+
+}
@@ -0,0 +1,85 @@
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day16.hpp"
+#include "generators.hpp"
+
+namespace aoc2018::day16 {
+
+static void BM_parse(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        std::vector<Sample> samples;
+        std::vector<Instruction> instructions;
+        parse(text, samples, instructions);
+        benchmark::DoNotOptimize(instructions.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_parse)->RangeMultiplier(8)->Range(1 << 8, 1 << 17)->Complexity();
+
+static void BM_matchOpCodes(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    std::vector<Sample> samples;
+    std::vector<Instruction> instructions;
+    parse(text, samples, instructions);
+
+    for (auto _ : state)
+    {
+        Candidates candidates;
+        for (const auto& sample : samples)
+        {
+            for (const auto& op : OpCodeMatcher::getMachingOpCodes(sample))
+            {
+                candidates[sample.instruction[0]].insert(op);
+            }
+        }
+        benchmark::DoNotOptimize(buildOpCodeTable(candidates));
+    }
+    state.SetItemsProcessed(state.iterations() * samples.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_matchOpCodes)->RangeMultiplier(8)->Range(1 << 8, 1 << 17)->Complexity();
+
+static void BM_runProgram(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    std::vector<Sample> samples;
+    std::vector<Instruction> instructions;
+    parse(text, samples, instructions);
+
+    Candidates candidates;
+    for (const auto& sample : samples)
+    {
+        for (const auto& op : OpCodeMatcher::getMachingOpCodes(sample))
+        {
+            candidates[sample.instruction[0]].insert(op);
+        }
+    }
+    auto ops = buildOpCodeTable(candidates);
+
+    for (auto _ : state)
+    {
+        Machine machine;
+        for (const auto& inst : instructions)
+        {
+            machine.run(ops[inst[0]], inst[1], inst[2], inst[3]);
+        }
+        benchmark::DoNotOptimize(machine.registers[0]);
+    }
+    state.SetItemsProcessed(state.iterations() * instructions.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_runProgram)->RangeMultiplier(8)->Range(1 << 8, 1 << 17)->Complexity();
+
+}
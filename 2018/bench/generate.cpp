@@ -0,0 +1,58 @@
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "Scanner.hpp"
+#include "generators.hpp"
+
+// Writes a synthetic puzzle input to stdout:
+//   aoc2018_generate <day> <size> [seed]
+int main(int argc, char* argv[])
+{
+    using Generator = std::function<std::string(size_t, std::uint64_t)>;
+    const std::map<int, Generator> generators = {
+        {1, aoc2018::day01::generateInput},
+        {2, aoc2018::day02::generateInput},
+        {3, aoc2018::day03::generateInput},
+        {4, aoc2018::day04::generateInput},
+        {5, aoc2018::day05::generateInput},
+        {6, aoc2018::day06::generateInput},
+        {7, aoc2018::day07::generateInput},
+        {8, aoc2018::day08::generateInput},
+        {10, aoc2018::day10::generateInput},
+        {12, aoc2018::day12::generateInput},
+        {13, aoc2018::day13::generateInput},
+        {15, aoc2018::day15::generateInput},
+        {16, aoc2018::day16::generateInput}
+    };
+
+    if (argc < 3 || argc > 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <day> <size> [seed]" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        int day = scanner::toInteger<int>(argv[1]);
+        size_t size = scanner::toInteger<size_t>(argv[2]);
+        std::uint64_t seed = argc > 3 ? scanner::toInteger<std::uint64_t>(argv[3]) : 1;
+
+        auto generator = generators.find(day);
+        if (generator == generators.end())
+        {
+            std::cerr << "No generator for day " << day << std::endl;
+            return 1;
+        }
+        std::cout << generator->second(size, seed);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
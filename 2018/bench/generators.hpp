@@ -0,0 +1,626 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Random.hpp"
+#include "day16.hpp"
+
+// Synthetic puzzle inputs of arbitrary size. Every generator takes a size
+// and a seed and returns the same text for the same arguments, in the
+// format of the real input of that day. Days 9, 11 and 14 are left out
+// because their whole input is a number that is passed to the solver
+// directly.
+
+namespace aoc2018::day01 {
+
+// count frequency changes. The running frequencies of the first pass are
+// all distinct and the drift of a pass is below count, so there are two of
+// them with the same remainder and a repeat is found after a few passes.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    count = std::max<size_t>(count, 2);
+    long drift = count / 2;
+    long range = 4 * count;
+
+    std::unordered_set<long> used = {0, drift};
+    std::vector<long> frequencies;
+    while (frequencies.size() < count - 1)
+    {
+        long f = random.between(-range, range);
+        if (used.insert(f).second)
+        {
+            frequencies.push_back(f);
+        }
+    }
+    frequencies.push_back(drift);
+
+    std::string text;
+    long previous = 0;
+    for (long f : frequencies)
+    {
+        long change = f - previous;
+        text += change < 0 ? "-" : "+";
+        text += std::to_string(std::abs(change));
+        text += '\n';
+        previous = f;
+    }
+    return text;
+}
+
+}
+
+
+namespace aoc2018::day02 {
+
+// count box ids of 26 letters, exactly one pair of them differs by one
+// letter.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    count = std::max<size_t>(count, 2);
+
+    std::vector<std::string> ids(count - 1, std::string(26, 'a'));
+    for (auto& id : ids)
+    {
+        for (auto& c : id)
+        {
+            c = random.between('a', 'z');
+        }
+    }
+
+    std::string twin = random.pick(ids);
+    char& changed = twin[random.between(0, 25)];
+    changed = 'a' + (changed - 'a' + random.between(1, 25)) % 26;
+    ids.insert(ids.begin() + random.between<size_t>(0, ids.size()), twin);
+
+    std::string text;
+    for (const auto& id : ids)
+    {
+        text += id;
+        text += '\n';
+    }
+    return text;
+}
+
+}
+
+
+namespace aoc2018::day03 {
+
+// count claims on the 1000x1000 fabric.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    std::ostringstream text;
+
+    for (size_t id = 1; id <= count; ++id)
+    {
+        int w = random.between(5, 29);
+        int h = random.between(5, 29);
+        int x = random.between(0, 1000 - w);
+        int y = random.between(0, 1000 - h);
+        text << '#' << id << " @ " << x << ',' << y << ": " << w << 'x' << h << '\n';
+    }
+    return text.str();
+}
+
+}
+
+
+namespace aoc2018::day04 {
+
+// Shuffled log of count shifts, at most 27552 of them. The dates stay
+// within 1518-1599 so that they survive the two digit year workaround of
+// LogEntry.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    constexpr size_t daysPerYear = 12 * 28;
+    constexpr size_t maxShifts = (1599 - 1518 + 1) * daysPerYear;
+
+    benchmarking::Random random(seed);
+    count = std::min(count, maxShifts);
+
+    std::vector<int> guards(std::max<size_t>(count / 20, 10));
+    for (auto& id : guards)
+    {
+        id = random.between(10, 3500);
+    }
+
+    std::vector<std::string> entries;
+    for (size_t shift = 0; shift < count; ++shift)
+    {
+        std::ostringstream date;
+        date.fill('0');
+        date << '[' << 1518 + shift / daysPerYear << '-'
+             << std::setw(2) << shift / 28 % 12 + 1 << '-'
+             << std::setw(2) << shift % 28 + 1 << " 00:";
+
+        auto entry = [&entries, &date](int minute, const std::string& action) {
+            std::ostringstream line;
+            line.fill('0');
+            line << date.str() << std::setw(2) << minute << "] " << action;
+            entries.push_back(line.str());
+        };
+
+        entry(random.between(0, 5), "Guard #" + std::to_string(random.pick(guards)) + " begins shift");
+        for (int minute = random.between(6, 15); minute < 50 && random.chance(0.7); )
+        {
+            int asleep = minute + random.between(0, 5);
+            int awake = asleep + random.between(1, 59 - asleep);
+            entry(asleep, "falls asleep");
+            entry(awake, "wakes up");
+            minute = awake + 1;
+        }
+    }
+
+    random.shuffle(entries.begin(), entries.end());
+
+    std::string text;
+    for (const auto& e : entries)
+    {
+        text += e;
+        text += '\n';
+    }
+    return text;
+}
+
+}
+
+
+namespace aoc2018::day05 {
+
+// Polymer of length units. Most units are followed at some point by their
+// reacting counterpart, so the reduction collapses long nested chains
+// like the real input does.
+inline std::string generateInput(size_t length, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    std::string polymer;
+    std::vector<char> unmatched;
+    polymer.reserve(length + 1);
+
+    while (polymer.size() < length)
+    {
+        if (!unmatched.empty() && random.chance(0.45))
+        {
+            char c = unmatched.back();
+            unmatched.pop_back();
+            polymer.push_back(c ^ 0x20);
+        }
+        else
+        {
+            char c = random.between('a', 'z');
+            c = random.chance(0.5) ? c : c ^ 0x20;
+            polymer.push_back(c);
+            unmatched.push_back(c);
+        }
+    }
+    polymer.push_back('\n');
+    return polymer;
+}
+
+}
+
+
+namespace aoc2018::day06 {
+
+// count distinct coordinates. The area grows with the count to keep the
+// density of the real input.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    int extent = 50 + static_cast<int>(50 * std::sqrt(count));
+    std::set<std::pair<int, int>> used;
+    std::ostringstream text;
+
+    while (used.size() < count)
+    {
+        int x = random.between(0, extent);
+        int y = random.between(0, extent);
+        if (used.insert({x, y}).second)
+        {
+            text << x << ", " << y << '\n';
+        }
+    }
+    return text.str();
+}
+
+}
+
+
+namespace aoc2018::day07 {
+
+// Random dependency graph between count steps, steps are letters so there
+// are at most 26 of them.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    count = std::clamp<size_t>(count, 2, 26);
+
+    std::string order(count, 'A');
+    std::iota(order.begin(), order.end(), 'A');
+    random.shuffle(order.begin(), order.end());
+
+    std::vector<std::string> lines;
+    for (size_t i = 1; i < count; ++i)
+    {
+        std::set<char> dependencies;
+        int n = random.between(1, 3);
+        for (int d = 0; d < n; ++d)
+        {
+            dependencies.insert(order[random.between<size_t>(0, i - 1)]);
+        }
+        for (char d : dependencies)
+        {
+            lines.push_back(std::string("Step ") + d + " must be finished before step " + order[i] + " can begin.");
+        }
+    }
+    random.shuffle(lines.begin(), lines.end());
+
+    std::string text;
+    for (const auto& l : lines)
+    {
+        text += l;
+        text += '\n';
+    }
+    return text;
+}
+
+}
+
+
+namespace aoc2018::day08 {
+
+inline void generateNode(benchmarking::Random& random, size_t nodes, std::string& text)
+{
+    size_t children = nodes > 1 ? random.between<size_t>(1, std::min<size_t>(nodes - 1, 7)) : 0;
+    int metadata = random.between(1, 11);
+    text += std::to_string(children) + ' ' + std::to_string(metadata) + ' ';
+
+    // Every child gets one node plus a random share of the rest
+    std::vector<size_t> cuts(children + 1, 0);
+    cuts.back() = nodes - 1 - children;
+    for (size_t i = 1; i < children; ++i)
+    {
+        cuts[i] = random.between<size_t>(0, cuts.back());
+    }
+    std::sort(cuts.begin(), cuts.end());
+    for (size_t i = 0; i < children; ++i)
+    {
+        generateNode(random, cuts[i + 1] - cuts[i] + 1, text);
+    }
+
+    for (int i = 0; i < metadata; ++i)
+    {
+        text += std::to_string(random.between(1, 9)) + ' ';
+    }
+}
+
+// Tree of count nodes on a single line.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    std::string text;
+    generateNode(random, std::max<size_t>(count, 1), text);
+    text.back() = '\n';
+    return text;
+}
+
+}
+
+
+namespace aoc2018::day10 {
+
+// count points that line up into vertical bars after about 10000 seconds.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    constexpr int bars = 8;
+    constexpr int barLength = 10;
+
+    benchmarking::Random random(seed);
+    int seconds = random.between(9000, 10999);
+    count = std::max<size_t>(count, bars * barLength);
+
+    std::ostringstream text;
+    for (size_t i = 0; i < count; ++i)
+    {
+        int cell = i % (bars * barLength);
+        int x = 20 + 6 * (cell / barLength);
+        int y = 20 + cell % barLength;
+        int vx = random.between(-5, 5);
+        int vy = random.between(-5, 5);
+        text << "position=<" << std::setw(6) << x - seconds * vx << ", " << std::setw(6) << y - seconds * vy
+             << "> velocity=<" << std::setw(2) << vx << ", " << std::setw(2) << vy << ">\n";
+    }
+    return text.str();
+}
+
+}
+
+
+namespace aoc2018::day12 {
+
+// Initial state of length pots and a full table of 32 rules.
+inline std::string generateInput(size_t pots, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    std::string text = "initial state: ";
+    for (size_t i = 0; i < pots; ++i)
+    {
+        text += random.chance(0.5) ? '#' : '.';
+    }
+    text += "\n\n";
+
+    for (int rule = 0; rule < 32; ++rule)
+    {
+        for (int bit = 4; bit >= 0; --bit)
+        {
+            text += (rule >> bit) & 1 ? '#' : '.';
+        }
+        // An empty neighbourhood must stay empty or the row grows forever
+        text += rule != 0 && random.chance(0.5) ? " => #\n" : " => .\n";
+    }
+    return text;
+}
+
+}
+
+
+namespace aoc2018::day13 {
+
+// size x size map tiled with pairs of overlapping loops, roughly every
+// other pair carries a cart.
+inline std::string generateInput(size_t size, std::uint64_t seed)
+{
+    constexpr int step = 4;
+    constexpr int tile = 3 * step + 2;
+
+    benchmarking::Random random(seed);
+    int side = std::max<int>(size, tile);
+    std::vector<std::string> map(side, std::string(side, ' '));
+
+    auto set = [&map](int x, int y, char c) {
+        char& cell = map[y][x];
+        cell = (cell == '-' && c == '|') || (cell == '|' && c == '-') ? '+' : c;
+    };
+
+    auto loop = [&set](int x0, int y0, int x1, int y1) {
+        for (int x = x0 + 1; x < x1; ++x)
+        {
+            set(x, y0, '-');
+            set(x, y1, '-');
+        }
+        for (int y = y0 + 1; y < y1; ++y)
+        {
+            set(x0, y, '|');
+            set(x1, y, '|');
+        }
+        set(x0, y0, '/');
+        set(x1, y0, '\\');
+        set(x0, y1, '\\');
+        set(x1, y1, '/');
+    };
+
+    for (int ty = 0; ty + tile <= side; ty += tile)
+    {
+        for (int tx = 0; tx + tile <= side; tx += tile)
+        {
+            loop(tx, ty, tx + 2 * step, ty + 2 * step);
+            loop(tx + step, ty + step, tx + 3 * step, ty + 3 * step);
+
+            if (random.chance(0.5))
+            {
+                int x = tx + random.between(1, 2 * step - 1);
+                int y = ty + (random.chance(0.5) ? 0 : 2 * step);
+                if (map[y][x] == '-')
+                {
+                    map[y][x] = random.chance(0.5) ? '>' : '<';
+                }
+            }
+        }
+    }
+
+    std::string text;
+    for (const auto& line : map)
+    {
+        text += line;
+        text += '\n';
+    }
+    return text;
+}
+
+}
+
+
+namespace aoc2018::day15 {
+
+// size x size cave with random walls and size units, all the open cells
+// are connected.
+inline std::string generateInput(size_t size, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    int side = std::max<int>(size, 7);
+    std::vector<std::string> cave(side, std::string(side, '#'));
+
+    for (int y = 1; y < side - 1; ++y)
+    {
+        for (int x = 1; x < side - 1; ++x)
+        {
+            cave[y][x] = random.chance(0.3) ? '#' : '.';
+        }
+    }
+
+    // Keep the open cells reachable from the centre, wall up the rest
+    int centre = side / 2;
+    cave[centre][centre] = '.';
+    std::vector<std::pair<int, int>> open = {{centre, centre}};
+    cave[centre][centre] = 'o';
+    for (size_t i = 0; i < open.size(); ++i)
+    {
+        auto [x, y] = open[i];
+        for (auto [dx, dy] : {std::pair(0, -1), std::pair(-1, 0), std::pair(1, 0), std::pair(0, 1)})
+        {
+            if (cave[y + dy][x + dx] == '.')
+            {
+                cave[y + dy][x + dx] = 'o';
+                open.push_back({x + dx, y + dy});
+            }
+        }
+    }
+    for (auto& row : cave)
+    {
+        std::replace(row.begin(), row.end(), '.', '#');
+        std::replace(row.begin(), row.end(), 'o', '.');
+    }
+
+    random.shuffle(open.begin(), open.end());
+    size_t units = std::min<size_t>(side, open.size());
+    for (size_t i = 0; i < units; ++i)
+    {
+        auto [x, y] = open[i];
+        cave[y][x] = i < 2 ? "GE"[i] : (random.chance(0.5) ? 'G' : 'E');
+    }
+
+    std::string text;
+    for (const auto& row : cave)
+    {
+        text += row;
+        text += '\n';
+    }
+    return text;
+}
+
+}
+
+
+namespace aoc2018::day16 {
+
+// At least 16 samples followed by a program of count instructions. The opcode
+// numbers are a random permutation and the samples are chosen so that the
+// permutation can be found by elimination: every sample of an opcode only
+// matches that opcode and the ones that can be identified before it.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    constexpr int numOfOpCodes = getNumOfOpCodes();
+
+    benchmarking::Random random(seed);
+    std::array<OpCode, numOfOpCodes> opcodes;
+    for (int i = 0; i < numOfOpCodes; ++i)
+    {
+        opcodes[i] = static_cast<OpCode>(i);
+    }
+    random.shuffle(opcodes.begin(), opcodes.end());
+
+    auto draw = [&random, &opcodes](int number) {
+        Sample sample;
+        sample.instruction = {number, random.between(0, 3), random.between(0, 3), random.between(0, 3)};
+        Machine machine;
+        for (auto& r : machine.registers)
+        {
+            r = random.between(0, 3);
+        }
+        sample.registersBefore = machine.registers;
+        machine.run(opcodes[number], sample.instruction[1], sample.instruction[2], sample.instruction[3]);
+        sample.registersAfter = machine.registers;
+        return sample;
+    };
+
+    // Order in which the opcodes become identifiable, with one sample
+    // proving each step
+    std::set<OpCode> known;
+    std::array<Sample, numOfOpCodes> witnesses;
+    std::array<std::set<OpCode>, numOfOpCodes> allowed;
+    while (known.size() < numOfOpCodes)
+    {
+        int number = random.between(0, numOfOpCodes - 1);
+        if (known.count(opcodes[number]))
+        {
+            continue;
+        }
+        Sample sample = draw(number);
+        std::set<OpCode> unknown;
+        for (OpCode op : OpCodeMatcher::getMachingOpCodes(sample))
+        {
+            if (!known.count(op))
+            {
+                unknown.insert(op);
+            }
+        }
+        if (unknown.size() == 1)
+        {
+            known.insert(opcodes[number]);
+            witnesses[number] = sample;
+            allowed[number] = known;
+        }
+    }
+
+    auto registers = [](const Registers& r) {
+        std::string text = "[";
+        for (size_t i = 0; i < r.size(); ++i)
+        {
+            text += i == 0 ? "" : ", ";
+            text += std::to_string(r[i]);
+        }
+        return text + "]";
+    };
+
+    auto instruction = [](const Instruction& i) {
+        std::string text;
+        for (size_t n = 0; n < i.size(); ++n)
+        {
+            text += n == 0 ? "" : " ";
+            text += std::to_string(i[n]);
+        }
+        return text;
+    };
+
+    std::vector<Sample> samples(witnesses.begin(), witnesses.end());
+    while (samples.size() < count)
+    {
+        int number = random.between(0, numOfOpCodes - 1);
+        Sample sample = witnesses[number];
+        for (int attempt = 0; attempt < 100; ++attempt)
+        {
+            Sample candidate = draw(number);
+            auto matches = OpCodeMatcher::getMachingOpCodes(candidate);
+            if (std::all_of(matches.begin(), matches.end(),
+                    [&](OpCode op) { return allowed[number].count(op) > 0; }))
+            {
+                sample = candidate;
+                break;
+            }
+        }
+        samples.push_back(sample);
+    }
+    random.shuffle(samples.begin(), samples.end());
+
+    std::string text;
+    for (const auto& sample : samples)
+    {
+        text += "Before: " + registers(sample.registersBefore) + '\n';
+        text += instruction(sample.instruction) + '\n';
+        text += "After:  " + registers(sample.registersAfter) + "\n\n";
+    }
+
+    text += "\n\n";
+    for (size_t s = 0; s < count; ++s)
+    {
+        Instruction i = {random.between(0, numOfOpCodes - 1), random.between(0, 3), random.between(0, 3), random.between(0, 3)};
+        text += instruction(i) + '\n';
+    }
+    return text;
+}
+
+}
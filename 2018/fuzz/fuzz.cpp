@@ -0,0 +1,145 @@
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Fuzzing.hpp"
+#include "Scanner.hpp"
+#include "targets.hpp"
+
+namespace
+{
+void printUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [--seconds <s>] [--cases <n>] [--seed <n>] [--max-size <n>] [<day>...]\n"
+        << "       " << name << " --replay <case seed> <size> <day>\n"
+        << "  Checks the optimised solvers of the days, default all, against their\n"
+        << "  reference oracles on random cases and prints the minimal counterexample\n"
+        << "  of the first failure.\n"
+        << "  --seconds <s>   fuzz every day for s seconds (default 1)\n"
+        << "  --cases <n>     stop a day after n cases (default: no limit)\n"
+        << "  --seed <n>      seed of the run (default 1)\n"
+        << "  --max-size <n>  largest case size (default 64)\n"
+        << "  --replay        check the single case of a failure again" << std::endl;
+}
+
+
+// Fuzzes or replays one day, true if every case passed
+using Run = std::function<bool(const fuzzing::Options&, const std::optional<std::pair<std::uint64_t, size_t>>&)>;
+
+template<typename Target>
+Run makeRun(std::string name)
+{
+    return [name](const fuzzing::Options& options, const std::optional<std::pair<std::uint64_t, size_t>>& replay) {
+        Target target;
+        if (replay)
+        {
+            auto input = fuzzing::generateCase(target, replay->first, replay->second);
+            auto message = fuzzing::checkCase(target, input);
+            std::cout << name << "  " << (message ? *message : "ok") << '\n' << target.format(input);
+            return !message;
+        }
+        auto outcome = fuzzing::fuzz(target, options);
+        std::cout << fuzzing::describe(name, target, outcome) << std::flush;
+        return !outcome.failure;
+    };
+}
+}
+
+
+int main(int argc, char* argv[])
+{
+    const std::map<int, Run> targets = {
+        {1, makeRun<aoc2018::day01::FuzzTarget>("day01")},
+        {2, makeRun<aoc2018::day02::FuzzTarget>("day02")},
+        {5, makeRun<aoc2018::day05::FuzzTarget>("day05")},
+        {9, makeRun<aoc2018::day09::FuzzTarget>("day09")},
+        {12, makeRun<aoc2018::day12::FuzzTarget>("day12")}
+    };
+
+    fuzzing::Options options;
+    options.numOfCases = SIZE_MAX;
+    options.timeLimit = std::chrono::seconds(1);
+    std::optional<std::pair<std::uint64_t, size_t>> replay;
+    std::vector<int> days;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg(argv[i]);
+            if (arg == "--seconds" && i + 1 < argc)
+            {
+                options.timeLimit = std::chrono::seconds(scanner::toInteger<int>(argv[++i]));
+            }
+            else if (arg == "--cases" && i + 1 < argc)
+            {
+                options.numOfCases = scanner::toInteger<size_t>(argv[++i]);
+            }
+            else if (arg == "--seed" && i + 1 < argc)
+            {
+                options.seed = scanner::toInteger<std::uint64_t>(argv[++i]);
+            }
+            else if (arg == "--max-size" && i + 1 < argc)
+            {
+                options.maxSize = scanner::toInteger<size_t>(argv[++i]);
+            }
+            else if (arg == "--replay" && i + 2 < argc)
+            {
+                std::uint64_t seed = scanner::toInteger<std::uint64_t>(argv[++i]);
+                replay.emplace(seed, scanner::toInteger<size_t>(argv[++i]));
+            }
+            else if (arg == "--help" || arg == "-h")
+            {
+                printUsage(argv[0]);
+                return 0;
+            }
+            else if (arg.starts_with("--"))
+            {
+                std::cerr << "Unknown option " << arg << std::endl;
+                printUsage(argv[0]);
+                return 2;
+            }
+            else
+            {
+                days.push_back(scanner::toInteger<int>(arg));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (replay && days.size() != 1)
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (days.empty())
+    {
+        for (const auto& [day, run] : targets)
+        {
+            days.push_back(day);
+        }
+    }
+
+    bool passed = true;
+    for (int day : days)
+    {
+        auto target = targets.find(day);
+        if (target == targets.end())
+        {
+            std::cerr << "No fuzz target for day " << day << std::endl;
+            return 2;
+        }
+        passed = target->second(options, replay) && passed;
+    }
+    return passed ? 0 : 1;
+}
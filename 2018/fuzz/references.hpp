@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Reference oracles for the differential fuzzing of the solvers. When a
+// solver is rewritten for speed, its previous implementation moves here
+// unchanged and keeps checking the new one. Days without one have the most
+// direct transcription of the puzzle text, written for being obviously
+// right rather than fast.
+
+namespace aoc2018::day01::reference {
+
+inline long sum(const std::vector<int>& values)
+{
+    long total = 0;
+    for (int change : values)
+    {
+        total += change;
+    }
+    return total;
+}
+
+
+// The loop of the implementation before the day was rewritten for speed.
+// That one ran until a frequency repeats, this one gives up after twice as
+// many passes as the changes add up to in absolute value. The frequencies
+// of a pass are never further apart than that, and every pass moves them
+// by the drift, so no repeat takes that many passes.
+inline std::optional<long> findFirstRepeat(const std::vector<int>& values)
+{
+    long magnitude = 0;
+    for (int change : values)
+    {
+        magnitude += std::abs(change);
+    }
+    long maxChanges = 2 * (magnitude + 2) * static_cast<long>(values.size());
+
+    std::set<long> frequencies;
+    long freq = 0;
+
+    for (long i = 0; i < maxChanges; ++i)
+    {
+        if (frequencies.count(freq) == 0)
+        {
+            frequencies.insert(freq);
+        }
+        else
+        {
+            return freq;
+        }
+        freq += values[i % values.size()];
+    }
+    return std::nullopt;
+}
+
+}
+
+
+namespace aoc2018::day02::reference {
+
+// Letters counted in a map, each count compared
+inline int calculateChecksum(const std::vector<std::string>& ids)
+{
+    int twice = 0;
+    int threeTimes = 0;
+    for (const auto& id : ids)
+    {
+        std::map<char, int> letters;
+        for (char c : id)
+        {
+            letters[c]++;
+        }
+        bool hasTwice = false;
+        bool hasThreeTimes = false;
+        for (const auto& [letter, count] : letters)
+        {
+            hasTwice = hasTwice || count == 2;
+            hasThreeTimes = hasThreeTimes || count == 3;
+        }
+        twice += hasTwice;
+        threeTimes += hasThreeTimes;
+    }
+    return twice * threeTimes;
+}
+
+
+// Every pair of IDs compared letter by letter
+inline std::vector<std::pair<size_t, size_t>> findPairsWhichDifferByOneLetter(const std::vector<std::string>& ids)
+{
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        for (size_t j = i + 1; j < ids.size(); ++j)
+        {
+            if (ids[i].size() != ids[j].size())
+            {
+                continue;
+            }
+            int differences = 0;
+            for (size_t k = 0; k < ids[i].size(); ++k)
+            {
+                differences += ids[i][k] != ids[j][k];
+            }
+            if (differences == 1)
+            {
+                pairs.emplace_back(i, j);
+            }
+        }
+    }
+    return pairs;
+}
+
+}
+
+
+namespace aoc2018::day05::reference {
+
+// The implementation before the days were rewritten for speed
+
+inline bool doesReact(char a, char b)
+{
+    return (islower(a) && (toupper(a) == b)) ||
+        (isupper(a) && (tolower(a) == b));
+}
+
+inline size_t findReactingUnits(const std::string& str, size_t begin)
+{
+    char prev = ' ';
+    for (size_t i = begin; i < str.size(); ++i)
+    {
+        char c = str[i];
+        if (i > 0 && doesReact(prev, c))
+        {
+            return i - 1;
+        }
+        prev = c;
+    }
+    return std::string::npos;
+}
+
+inline std::string findPolymer(const std::string& str)
+{
+    std::string polymer = str;
+    size_t begin = 0;
+    size_t pos = 0;
+    while((pos = findReactingUnits(polymer, begin)) != std::string::npos)
+    {
+        begin = pos > 0 ? pos - 1 : pos;
+        polymer.erase(pos, 2);
+    }
+    return polymer;
+}
+
+inline size_t findShortestPolymer(const std::string& str)
+{
+    std::vector<size_t> sizes;
+    for (char c = 'a'; c <= 'z'; c++)
+    {
+        std::string candidate = str;
+        candidate.erase(std::remove_if(candidate.begin(), candidate.end(),
+            [&](char r) -> bool {
+                return ((c == r) || (c == tolower(r)));
+            }), candidate.end());
+        sizes.push_back(findPolymer(candidate).size());
+    }
+    std::sort(sizes.begin(), sizes.end());
+    return sizes.front();
+}
+
+}
+
+
+namespace aoc2018::day09::reference {
+
+// The implementation before the days were rewritten for speed
+
+inline void incrementByTwo(std::list<int>::iterator& it, std::list<int>& container)
+{
+    it++;
+    if (it == container.end())
+    {
+        it = container.begin();
+    }
+    it++;
+}
+
+
+inline void decrement(std::list<int>::iterator& it, std::list<int>& container)
+{
+    if (it == container.begin())
+    {
+        it = container.end();
+    }
+    it--;
+}
+
+
+inline long int getHighscore(int numOfPlayers, int rounds)
+{
+    std::list<int> marbles = {0};
+    std::vector<long int> scores(numOfPlayers);
+    int player = 0;
+    auto current = marbles.begin();
+
+    for (int i = 1; i <= rounds; ++i)
+    {
+        if (i % 23 != 0)
+        {
+            incrementByTwo(current, marbles);
+            current = marbles.insert(current, i);
+        }
+        else
+        {
+            for (int j = 0; j < 7; ++j)
+            {
+                decrement(current, marbles);
+            }
+            auto pick = current;
+            current++;
+            scores[player] += i + *pick;
+            marbles.erase(pick);
+        }
+        player = (player + 1) % numOfPlayers;
+    }
+
+    std::sort(scores.begin(), scores.end());
+    return scores.back();
+}
+
+}
+
+
+namespace aoc2018::day12::reference {
+
+// The implementation before the days were rewritten for speed
+
+class Pots
+{
+public:
+    Pots(const std::string& initial)
+    {
+        for (size_t i = 0; i < initial.size(); ++i)
+        {
+            if (initial[i] == PLANT_SYMBOL)
+            {
+                plants.insert(i);
+            }
+        }
+    }
+
+    void addRule(const std::string& rule)
+    {
+        rules.push_back({});
+        auto& r = rules.back();
+        assert(r.size() == rule.size());
+        for (size_t i = 0; i < rule.size(); ++i)
+        {
+            r[i] = rule[i] == PLANT_SYMBOL;
+        }
+    }
+
+    // Fixed along with the engine: nothing grows once all plants are gone
+    void advance()
+    {
+        if (plants.empty())
+        {
+            return;
+        }
+        std::set<int> nextGen;
+
+        int min = *plants.begin();
+        int max = *plants.rbegin();
+
+        // Fixed along with the engine: up to two pots right of the last plant
+        for (int i = min - 2; i <= max + 2; ++i)
+        {
+            for (auto& rule : rules)
+            {
+                if (isMatching(rule, i))
+                {
+                    nextGen.insert(i);
+                    break;
+                }
+            }
+        }
+
+        plants.swap(nextGen);
+    }
+
+    int getSum() const
+    {
+        return std::accumulate(plants.begin(), plants.end(), 0);
+    }
+
+private:
+    static const int RULE_SIZE = 5;
+    static const char PLANT_SYMBOL = '#';
+    std::vector<std::array<bool, RULE_SIZE>> rules;
+    std::set<int> plants;
+
+    bool isMatching(const std::array<bool, RULE_SIZE>& rule, int i) const
+    {
+        int offset = -2;
+        for (auto b : rule)
+        {
+            if (b != (plants.count(i + offset) > 0))
+            {
+                return false;
+            }
+            offset++;
+        }
+        return true;
+    }
+};
+
+
+// The sum after advancing generation by generation, the original solution
+// extrapolated only in its test
+inline long getSumAfter(std::string_view initial, const std::vector<std::string>& rules, long generations)
+{
+    Pots pots{std::string(initial)};
+    for (const auto& rule : rules)
+    {
+        pots.addRule(rule);
+    }
+    for (long generation = 0; generation < generations; ++generation)
+    {
+        pots.advance();
+    }
+    return pots.getSum();
+}
+
+}
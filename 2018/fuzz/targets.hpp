@@ -0,0 +1,407 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Fuzzing.hpp"
+#include "StreamInput.hpp"
+#include "day01.hpp"
+#include "day02.hpp"
+#include "day05.hpp"
+#include "day09.hpp"
+#include "day12.hpp"
+#include "references.hpp"
+
+// Fuzz targets: small random cases of a day, checked against the reference
+// oracles. See Fuzzing.hpp for what a target provides.
+
+namespace aoc2018::day01 {
+
+// Changes with a small drift, so that repeats take many passes or never
+// happen. The engines are the parser with its prefix sums, the closed form
+// and the simulation with both visited sets.
+struct FuzzTarget
+{
+    using Case = std::vector<int>;
+
+    Case generate(benchmarking::Random& random, size_t size) const
+    {
+        int range = random.between(1, 20);
+        Case values(size);
+        for (auto& change : values)
+        {
+            change = random.between(-range, range);
+        }
+        return values;
+    }
+
+    std::optional<std::string> check(const Case& values) const
+    {
+        auto expected = reference::findFirstRepeat(values);
+        auto compare = [&expected](const char* engine, const std::optional<long>& actual) -> std::optional<std::string> {
+            if (expected == actual)
+            {
+                return std::nullopt;
+            }
+            auto toText = [](const std::optional<long>& repeated) {
+                return repeated ? std::to_string(*repeated) : std::string("no repeat");
+            };
+            return engine + (": expected " + toText(expected)) + ", got " + toText(actual);
+        };
+
+        FrequencyLog log = readFrequencyLog(format(values));
+        if (auto error = fuzzing::expectEqual(reference::sum(values), log.getDrift()))
+        {
+            return "readFrequencyLog: " + *error;
+        }
+        if (auto error = compare("findFirstRepeatInClosedForm", findFirstRepeatInClosedForm(log)))
+        {
+            return error;
+        }
+        if (auto error = compare("findFirstRepeat", findFirstRepeat(log)))
+        {
+            return error;
+        }
+        if (values.empty())
+        {
+            return std::nullopt;
+        }
+        SimulationBounds bounds(log);
+        FrequencyBitmap bitmap(bounds.lowest, bounds.highest);
+        if (auto error = compare("FrequencyBitmap", simulateFirstRepeat(log, bitmap, bounds.passes)))
+        {
+            return error;
+        }
+        FrequencyHashSet hashSet;
+        return compare("FrequencyHashSet", simulateFirstRepeat(log, hashSet, bounds.passes));
+    }
+
+    std::vector<Case> shrink(const Case& values) const
+    {
+        auto candidates = fuzzing::removeChunks(values);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i] != 0)
+            {
+                candidates.push_back(values);
+                candidates.back()[i] += values[i] > 0 ? -1 : 1;
+            }
+        }
+        return candidates;
+    }
+
+    std::string format(const Case& values) const
+    {
+        std::string text;
+        for (int change : values)
+        {
+            text += change < 0 ? "" : "+";
+            text += std::to_string(change);
+            text += '\n';
+        }
+        return text;
+    }
+};
+
+}
+
+
+namespace aoc2018::day02 {
+
+// IDs of a few lengths over a few letters, so that many of them differ by
+// one letter and letters repeat. The engines are calculateChecksum and
+// findPairsWhichDifferByOneLetter, for all pairs and for the first one.
+struct FuzzTarget
+{
+    using Case = std::vector<std::string>;
+
+    Case generate(benchmarking::Random& random, size_t size) const
+    {
+        int maxLength = random.between(1, 6);
+        char lastLetter = static_cast<char>('a' + random.between(1, 4));
+        Case ids(size);
+        for (auto& id : ids)
+        {
+            id.resize(random.between(maxLength - 1, maxLength));
+            for (auto& c : id)
+            {
+                c = random.between('a', lastLetter);
+            }
+        }
+        return ids;
+    }
+
+    std::optional<std::string> check(const Case& ids) const
+    {
+        std::vector<std::string_view> views(ids.begin(), ids.end());
+        if (auto error = fuzzing::expectEqual(reference::calculateChecksum(ids), calculateChecksum(views)))
+        {
+            return "calculateChecksum: " + *error;
+        }
+
+        auto expected = reference::findPairsWhichDifferByOneLetter(ids);
+        auto pairs = findPairsWhichDifferByOneLetter(views);
+        if (expected != pairs)
+        {
+            return "findPairsWhichDifferByOneLetter: expected " + formatPairs(expected) + ", got " + formatPairs(pairs);
+        }
+        expected.resize(std::min<size_t>(expected.size(), 1));
+        pairs = findPairsWhichDifferByOneLetter(views, Matches::first);
+        if (expected != pairs)
+        {
+            return "findPairsWhichDifferByOneLetter first: expected " + formatPairs(expected) + ", got " + formatPairs(pairs);
+        }
+        return std::nullopt;
+    }
+
+    std::vector<Case> shrink(const Case& ids) const
+    {
+        auto candidates = fuzzing::removeChunks(ids);
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            for (auto& id : fuzzing::removeChunks(ids[i], 1))
+            {
+                candidates.push_back(ids);
+                candidates.back()[i] = std::move(id);
+            }
+        }
+        return candidates;
+    }
+
+    std::string format(const Case& ids) const
+    {
+        std::string text;
+        for (const auto& id : ids)
+        {
+            text += id;
+            text += '\n';
+        }
+        return text;
+    }
+
+    static std::string formatPairs(const std::vector<std::pair<size_t, size_t>>& pairs)
+    {
+        std::string text = "{";
+        for (auto [first, second] : pairs)
+        {
+            text += ' ';
+            text += std::to_string(first);
+            text += '-';
+            text += std::to_string(second);
+        }
+        text += " }";
+        return text;
+    }
+};
+
+}
+
+
+namespace aoc2018::day05 {
+
+// Polymers of a few unit types, so that most units react. The engines are
+// findPolymer, findShortestPolymer and the streaming Reactor.
+struct FuzzTarget
+{
+    using Case = std::string;
+
+    Case generate(benchmarking::Random& random, size_t size) const
+    {
+        char lastType = static_cast<char>('a' + random.between(0, 3));
+        std::string polymer(size, ' ');
+        for (auto& unit : polymer)
+        {
+            unit = random.between('a', lastType);
+            if (random.chance(0.5))
+            {
+                unit ^= 0x20;
+            }
+        }
+        return polymer;
+    }
+
+    std::optional<std::string> check(const Case& polymer) const
+    {
+        std::string expected = reference::findPolymer(polymer);
+        if (auto error = fuzzing::expectEqual(expected, findPolymer(polymer)))
+        {
+            return "findPolymer: " + *error;
+        }
+
+        size_t shortest = reference::findShortestPolymer(polymer);
+        if (auto error = fuzzing::expectEqual(shortest, findShortestPolymer(polymer)))
+        {
+            return "findShortestPolymer: " + *error;
+        }
+
+        puzzleInputs::ChunkReader input(polymer, 3);
+        auto [length, streamedShortest] = solveStreaming(input);
+        if (auto error = fuzzing::expectEqual(expected.size(), length))
+        {
+            return "solveStreaming part 1: " + *error;
+        }
+        if (auto error = fuzzing::expectEqual(shortest, streamedShortest))
+        {
+            return "solveStreaming part 2: " + *error;
+        }
+        return std::nullopt;
+    }
+
+    std::vector<Case> shrink(const Case& polymer) const
+    {
+        return fuzzing::removeChunks(polymer);
+    }
+
+    std::string format(const Case& polymer) const
+    {
+        return polymer + '\n';
+    }
+};
+
+}
+
+
+namespace aoc2018::day09 {
+
+// Games of up to a few marbles per size step, the engine is getHighscore
+struct FuzzTarget
+{
+    using Case = Game;
+
+    Case generate(benchmarking::Random& random, size_t size) const
+    {
+        int maxMarble = static_cast<int>(std::min<size_t>(size * 40, 5000));
+        return Game{random.between(1, 30), random.between(1, maxMarble)};
+    }
+
+    std::optional<std::string> check(const Case& game) const
+    {
+        return fuzzing::expectEqual(reference::getHighscore(game.numOfPlayers, game.lastMarble),
+            getHighscore(game.numOfPlayers, game.lastMarble));
+    }
+
+    std::vector<Case> shrink(const Case& game) const
+    {
+        std::vector<Case> candidates;
+        for (int lastMarble : fuzzing::shrinkInteger(game.lastMarble, 1))
+        {
+            candidates.push_back({game.numOfPlayers, lastMarble});
+        }
+        for (int numOfPlayers : fuzzing::shrinkInteger(game.numOfPlayers, 1))
+        {
+            candidates.push_back({numOfPlayers, game.lastMarble});
+        }
+        return candidates;
+    }
+
+    std::string format(const Case& game) const
+    {
+        return std::to_string(game.numOfPlayers) + " players; last marble is worth "
+            + std::to_string(game.lastMarble) + " points\n";
+    }
+};
+
+}
+
+
+namespace aoc2018::day12 {
+
+// Random initial states and rule sets, "....." never grows a plant like in
+// the puzzle. The engines are Pots::advance through parsePots and the
+// extrapolation of getSumAfter.
+struct FuzzTarget
+{
+    struct Case
+    {
+        std::string initial;
+        std::vector<std::string> rules;
+        long generations;
+    };
+
+    Case generate(benchmarking::Random& random, size_t size) const
+    {
+        Case pots;
+        pots.initial.resize(std::min<size_t>(size, 40));
+        for (auto& pot : pots.initial)
+        {
+            pot = random.chance(0.4) ? '#' : '.';
+        }
+        double density = static_cast<double>(random.between(1, 9)) / 10;
+        for (unsigned pattern = 1; pattern < 32; ++pattern)
+        {
+            if (random.chance(density))
+            {
+                std::string rule;
+                for (int bit = 4; bit >= 0; --bit)
+                {
+                    rule += (pattern >> bit) & 1 ? '#' : '.';
+                }
+                pots.rules.push_back(rule);
+            }
+        }
+        pots.generations = random.between(0L, static_cast<long>(size));
+        return pots;
+    }
+
+    std::optional<std::string> check(const Case& pots) const
+    {
+        long expected = reference::getSumAfter(pots.initial, pots.rules, pots.generations);
+        Pots parsed = parsePots(formatInput(pots));
+        if (auto error = fuzzing::expectEqual(expected, getSumAfter(parsed, pots.generations)))
+        {
+            return "getSumAfter: " + *error;
+        }
+
+        for (long generation = 0; generation < pots.generations; ++generation)
+        {
+            parsed.advance();
+        }
+        if (auto error = fuzzing::expectEqual(expected, static_cast<long>(parsed.getSum())))
+        {
+            return "advance: " + *error;
+        }
+        return std::nullopt;
+    }
+
+    std::vector<Case> shrink(const Case& pots) const
+    {
+        std::vector<Case> candidates;
+        for (long generations : fuzzing::shrinkInteger(pots.generations, 0L))
+        {
+            candidates.push_back({pots.initial, pots.rules, generations});
+        }
+        for (auto& rules : fuzzing::removeChunks(pots.rules))
+        {
+            candidates.push_back({pots.initial, std::move(rules), pots.generations});
+        }
+        for (auto& initial : fuzzing::removeChunks(pots.initial, 1))
+        {
+            candidates.push_back({std::move(initial), pots.rules, pots.generations});
+        }
+        return candidates;
+    }
+
+    std::string format(const Case& pots) const
+    {
+        return formatInput(pots) + "after " + std::to_string(pots.generations) + " generations\n";
+    }
+
+    std::string formatInput(const Case& pots) const
+    {
+        std::string text = "initial state: ";
+        text += pots.initial;
+        text += "\n\n";
+        for (const auto& rule : pots.rules)
+        {
+            text += rule;
+            text += " => #\n";
+        }
+        return text;
+    }
+};
+
+}
@@ -1,52 +1,52 @@
-#include <fstream>
+#include <climits>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
-#include <set>
-#include <filesystem>
 
 #include <gtest/gtest.h>
 
 #include "PuzzleInputs.hpp"
+#include "day01.hpp"
+#include "targets.hpp"
 
 namespace aoc2018::day01 {
 
-static int sum(const std::vector<int>& values)
+TEST(Day01, sum)
 {
-    int s = 0;
-
-    for (auto& i : values)
-    {
-        s += i;
-    }
-
-    return s;
+    EXPECT_EQ(3, sum({1, 1, 1}));
+    // Beyond int
+    EXPECT_EQ(3L * INT_MAX, sum({INT_MAX, INT_MAX, INT_MAX}));
 }
 
-static int findFirstDuplicateFrequency(const std::vector<int>& values)
+TEST(Day01, frequencyLog)
 {
-    std::set<int> frequencies;
-    int freq = 0;
+    FrequencyLog log = readFrequencyLog("+1\n-2\n+3\n+1\n");
+    EXPECT_EQ((std::vector<int>{1, -2, 3, 1}), log.getChanges());
+    EXPECT_EQ((std::vector<long>{0, 1, -1, 2, 3}), log.getFrequencies());
+    EXPECT_EQ(3, log.getDrift());
 
-    while (true)
+    EXPECT_EQ(0, readFrequencyLog("").getDrift());
+    EXPECT_EQ(1u, FrequencyLog().getFrequencies().size());
+
+    // Across blocks of the parser
+    std::string text;
+    std::vector<int> changes;
+    for (int i = 0; i < 3 * static_cast<int>(frequencyBlockSize) + 5; ++i)
     {
-        for (auto& d : values)
-        {
-            if (frequencies.count(freq) == 0)
-            {
-                frequencies.insert(freq);
-            }
-            else
-            {
-                return freq;
-            }
-            freq += d;
-        }
+        changes.push_back(i % 7 - 3);
+        text += std::to_string(changes.back()) + '\n';
     }
-}
-
-TEST(Day01, sum)
-{
-    EXPECT_EQ(3, sum({1, 1, 1}));
+    log = readFrequencyLog(text);
+    EXPECT_EQ(changes, log.getChanges());
+    long frequency = 0;
+    for (size_t i = 0; i < changes.size(); ++i)
+    {
+        ASSERT_EQ(frequency, log.getFrequencies()[i]);
+        frequency += changes[i];
+    }
+    EXPECT_EQ(frequency, log.getDrift());
+    EXPECT_EQ(sum(changes), log.getDrift());
 }
 
 TEST(Day01, duplicates)
@@ -58,24 +58,92 @@ TEST(Day01, duplicates)
     EXPECT_EQ(14, findFirstDuplicateFrequency({7, 7, -2, -7, -4}));
 }
 
-TEST(Day01, solution)
+TEST(Day01, repeatsAfterManyPasses)
+{
+    // Ten million passes until 10000000 comes back
+    EXPECT_EQ(10000000, findFirstDuplicateFrequency({10000000, -9999999}));
+    EXPECT_EQ(-10000000, findFirstDuplicateFrequency({-10000000, 9999999}));
+    // -3 reaches 0 after three passes, before 0 reaches 4 after four
+    EXPECT_EQ(0, findFirstDuplicateFrequency({4, -7, 4}));
+    // 0 reaches 1 and 1 reaches 2 after one pass, 0 comes first
+    EXPECT_EQ(1, findFirstDuplicateFrequency({2, -1, 0}));
+    EXPECT_EQ(0, findFirstDuplicateFrequency({2, -2, 5, -5}));
+}
+
+TEST(Day01, neverRepeats)
+{
+    EXPECT_FALSE(findFirstRepeat({}));
+    EXPECT_FALSE(findFirstRepeat({1}));
+    EXPECT_FALSE(findFirstRepeat({1, 1}));
+    EXPECT_FALSE(findFirstRepeat({3, -1}));
+    EXPECT_FALSE(findFirstRepeatInClosedForm({3, -1}));
+    EXPECT_FALSE(findFirstRepeatInClosedForm({}));
+    EXPECT_THROW(findFirstDuplicateFrequency({5, 2}), std::runtime_error);
+    EXPECT_EQ(0, findFirstRepeat({0}));
+}
+
+TEST(Day01, visitedSets)
 {
-    std::ifstream input(puzzleInputs::getInputDirectory() /  "day01_input.txt");
-    EXPECT_TRUE(input.is_open());
-    std::vector<int> values;
-    std::string line;
-    while (std::getline(input, line))
+    FrequencyBitmap bitmap(-100, 100);
+    FrequencyHashSet hashSet(2);
+    for (long frequency : {-100L, 0L, 100L, 63L, 64L, -37L})
     {
-        std::stringstream ss(line);
-        std::string num;
-        while (std::getline(ss, num, ' '))
-        {
-            values.push_back(std::stoi(num));
-        }
+        EXPECT_TRUE(bitmap.insert(frequency));
+        EXPECT_TRUE(hashSet.insert(frequency));
     }
+    for (long frequency : {-100L, 0L, 100L, 63L, 64L, -37L})
+    {
+        EXPECT_FALSE(bitmap.insert(frequency));
+        EXPECT_FALSE(hashSet.insert(frequency));
+    }
+
+    // The table grows past its initial size
+    for (long frequency = 1000; frequency < 3000; frequency += 3)
+    {
+        EXPECT_TRUE(hashSet.insert(frequency));
+    }
+    EXPECT_FALSE(hashSet.insert(2998));
+}
+
+TEST(Day01, simulation)
+{
+    SimulationBounds bounds({3, -1, -1});
+    EXPECT_EQ(5, bounds.passes);
+    EXPECT_EQ(0, bounds.lowest);
+    EXPECT_EQ(7, bounds.highest);
+    EXPECT_TRUE(bounds.fitsBitmap(3));
+    EXPECT_FALSE(SimulationBounds({1 << 30, -(1 << 30) + 1}).fitsBitmap(2));
+
+    EXPECT_EQ(3, simulateFirstRepeat({3, -1, -1}));
+    EXPECT_EQ(1000, simulateFirstRepeat({1000, -999}));
+    EXPECT_FALSE(simulateFirstRepeat({5, 2}));
+    EXPECT_FALSE(simulateFirstRepeat({}));
+}
+
+TEST(Day01, matchesReference)
+{
+    FuzzTarget target;
+    auto outcome = fuzzing::fuzz(target, {.numOfCases = 2000});
+    EXPECT_FALSE(outcome.failure) << fuzzing::describe("day01", target, outcome);
+}
+
+TEST(Day01, streaming)
+{
+    puzzleInputs::ChunkReader input("+1\n-2\n+3\n+1\n", 3);
+    EXPECT_EQ(std::make_pair(3L, 2L), solveStreaming(input));
+}
+
+TEST(Day01, solution)
+{
+    auto input = puzzleInputs::openInput("day01_input.txt");
+    std::vector<int> values = parseFrequencyChanges(input.view());
 
     EXPECT_EQ(420, sum(values));
     EXPECT_EQ(227, findFirstDuplicateFrequency(values));
+
+    FrequencyLog log = readFrequencyLog(input.view());
+    EXPECT_EQ(420, log.getDrift());
+    EXPECT_EQ(227, findFirstDuplicateFrequency(log));
 }
 
 }
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "PrefixSums.hpp"
+#include "Scanner.hpp"
+#include "StreamInput.hpp"
+
+namespace aoc2018::day01 {
+
+inline long sum(const std::vector<int>& values)
+{
+    return simd::sum(values);
+}
+
+
+// The changes and the frequency before each of them, the sums of the
+// changes so far. Every repeat engine works on the frequencies of the
+// first pass, the later passes only shift them by the drift.
+class FrequencyLog
+{
+public:
+    FrequencyLog() = default;
+
+    // Implicit, so that the engines take the plain changes as well
+    FrequencyLog(std::vector<int> changesIn) :
+        changes(std::move(changesIn)),
+        frequencies(changes.size() + 1)
+    {
+        frequencies.back() = simd::prefixSums(changes, 0, frequencies.data());
+    }
+
+    FrequencyLog(std::initializer_list<int> changesIn) :
+        FrequencyLog(std::vector<int>(changesIn))
+    {
+    }
+
+    const std::vector<int>& getChanges() const
+    {
+        return changes;
+    }
+
+    // One more than the changes, the last one is the frequency after the
+    // first pass
+    const std::vector<long>& getFrequencies() const
+    {
+        return frequencies;
+    }
+
+    long getDrift() const
+    {
+        return frequencies.back();
+    }
+
+    void add(int change)
+    {
+        changes.push_back(change);
+    }
+
+    // Sums the changes added since the last call into the frequencies
+    void addFrequencies()
+    {
+        size_t first = frequencies.size() - 1;
+        long frequency = frequencies.back();
+        frequencies.resize(changes.size() + 1);
+        std::span<const int> added(changes.data() + first, changes.size() - first);
+        frequencies.back() = simd::prefixSums(added, frequency, frequencies.data() + first);
+    }
+
+private:
+    std::vector<int> changes;
+    std::vector<long> frequencies{0};
+};
+
+// Pass k over the changes visits the frequencies of the first pass shifted
+// by k times the drift, the sum of all changes. A frequency p_j of the first
+// pass comes back from p_i when p_j - p_i is k >= 0 times the drift, at
+// change i of pass k. Among the frequencies that are equal modulo the
+// drift, sorted by value, each one reaches its neighbour in the direction
+// of the drift first, so the earliest of these neighbours is the answer.
+// O(n log n) however many passes the repeat takes; nullopt if no frequency
+// is ever reached twice.
+inline std::optional<long> findFirstRepeatInClosedForm(const FrequencyLog& log)
+{
+    struct Frequency
+    {
+        long residue;
+        long value;
+        size_t index;
+
+        bool operator<(const Frequency& other) const
+        {
+            return std::tie(residue, value, index) < std::tie(other.residue, other.value, other.index);
+        }
+    };
+
+    long drift = log.getDrift();
+    // Without drift only equal frequencies meet, all in the same group
+    long modulus = std::abs(drift);
+
+    size_t numOfChanges = log.getChanges().size();
+    std::vector<Frequency> frequencies;
+    frequencies.reserve(numOfChanges);
+    for (size_t i = 0; i < numOfChanges; ++i)
+    {
+        long frequency = log.getFrequencies()[i];
+        long residue = modulus ? (frequency % modulus + modulus) % modulus : 0;
+        frequencies.push_back({residue, frequency, i});
+    }
+    std::sort(frequencies.begin(), frequencies.end());
+
+    // The pass and the change within it, earlier repeats compare less
+    std::optional<std::pair<long, size_t>> first;
+    long repeated = 0;
+    auto reach = [&](long pass, size_t index, long value) {
+        if (!first || std::make_pair(pass, index) < *first)
+        {
+            first = std::make_pair(pass, index);
+            repeated = value;
+        }
+    };
+
+    for (size_t i = 1; i < frequencies.size(); ++i)
+    {
+        const Frequency& lower = frequencies[i - 1];
+        const Frequency& upper = frequencies[i];
+        if (lower.residue != upper.residue)
+        {
+            continue;
+        }
+        if (lower.value == upper.value)
+        {
+            // Within the first pass, at the later of the two
+            reach(0, upper.index, upper.value);
+        }
+        else if (drift > 0)
+        {
+            reach((upper.value - lower.value) / drift, lower.index, upper.value);
+        }
+        else if (drift < 0)
+        {
+            reach((upper.value - lower.value) / -drift, upper.index, lower.value);
+        }
+    }
+
+    if (!first && drift == 0 && numOfChanges > 0)
+    {
+        // The second pass starts where the first one did
+        return 0;
+    }
+    if (!first)
+    {
+        return std::nullopt;
+    }
+    return repeated;
+}
+
+
+// Frequencies seen by the simulation, as bits over the range the
+// simulation can reach. Dense and without hashing, for ranges that are not
+// much larger than the number of frequencies.
+class FrequencyBitmap
+{
+public:
+    FrequencyBitmap(long lowest, long highest) :
+        offset(lowest),
+        bits(static_cast<size_t>(highest - lowest) / 64 + 1, 0)
+    {
+    }
+
+    // False if the frequency was seen before
+    bool insert(long frequency)
+    {
+        auto index = static_cast<std::uint64_t>(frequency - offset);
+        std::uint64_t& word = bits[index / 64];
+        std::uint64_t bit = std::uint64_t(1) << (index % 64);
+        bool inserted = !(word & bit);
+        word |= bit;
+        return inserted;
+    }
+
+private:
+    long offset;
+    std::vector<std::uint64_t> bits;
+};
+
+
+// Frequencies seen by the simulation in a flat open addressing table with
+// linear probing, for ranges too sparse for a bitmap. At most half full.
+class FrequencyHashSet
+{
+public:
+    explicit FrequencyHashSet(size_t expected = 16)
+    {
+        size_t capacity = std::bit_ceil(std::max<size_t>(expected * 2, 16));
+        slots.assign(capacity, empty);
+        shift = 64 - std::countr_zero(capacity);
+    }
+
+    // False if the frequency was seen before
+    bool insert(long frequency)
+    {
+        if (2 * (size + 1) > slots.size())
+        {
+            grow();
+        }
+        size_t mask = slots.size() - 1;
+        for (size_t i = getSlot(frequency); ; i = (i + 1) & mask)
+        {
+            if (slots[i] == frequency)
+            {
+                return false;
+            }
+            if (slots[i] == empty)
+            {
+                slots[i] = frequency;
+                ++size;
+                return true;
+            }
+        }
+    }
+
+private:
+    // Out of reach of any sum of int changes the simulation could hold
+    static constexpr long empty = std::numeric_limits<long>::min();
+
+    size_t getSlot(long frequency) const
+    {
+        return static_cast<size_t>((static_cast<std::uint64_t>(frequency) * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    void grow()
+    {
+        std::vector<long> old(slots.size() * 2, empty);
+        old.swap(slots);
+        --shift;
+        size = 0;
+        for (long frequency : old)
+        {
+            if (frequency != empty)
+            {
+                insert(frequency);
+            }
+        }
+    }
+
+    std::vector<long> slots;
+    int shift{0};
+    size_t size{0};
+};
+
+
+// What the simulation can reach: once the passes are further apart than
+// the frequencies of one pass, no frequency comes back.
+struct SimulationBounds
+{
+    long passes{0};
+    long lowest{0};
+    long highest{0};
+
+    explicit SimulationBounds(const FrequencyLog& log)
+    {
+        long drift = log.getDrift();
+        auto [firstLowest, firstHighest] = std::minmax_element(log.getFrequencies().begin(), log.getFrequencies().end());
+        passes = drift == 0 ? 2 : (*firstHighest - *firstLowest) / std::abs(drift) + 2;
+        lowest = *firstLowest + std::min(0L, (passes - 1) * drift);
+        highest = *firstHighest + std::max(0L, (passes - 1) * drift);
+    }
+
+    // Bits of a bitmap over the reachable range, not larger than
+    // maxBitsPerValue times the number of changes or the table of a hash set
+    // would be smaller
+    bool fitsBitmap(size_t numOfValues, long maxBitsPerValue = 256) const
+    {
+        return highest - lowest < maxBitsPerValue * static_cast<long>(numOfValues) + 4096;
+    }
+};
+
+
+// Goes through the frequencies pass after pass and stops at the first one
+// that visited has seen before, or once no frequency can come back. Faster
+// than the closed form when the repeat comes within a few passes.
+template<typename Visited>
+std::optional<long> simulateFirstRepeat(const FrequencyLog& log, Visited& visited, long passes)
+{
+    std::span<const long> frequencies(log.getFrequencies().data(), log.getChanges().size());
+    for (long pass = 0; pass < passes; ++pass)
+    {
+        long shift = pass * log.getDrift();
+        for (long frequency : frequencies)
+        {
+            if (!visited.insert(shift + frequency))
+            {
+                return shift + frequency;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+
+// With a bitmap where the reachable range is dense enough, otherwise with
+// a hash set
+inline std::optional<long> simulateFirstRepeat(const FrequencyLog& log)
+{
+    size_t numOfChanges = log.getChanges().size();
+    if (numOfChanges == 0)
+    {
+        return std::nullopt;
+    }
+    SimulationBounds bounds(log);
+    if (bounds.fitsBitmap(numOfChanges))
+    {
+        FrequencyBitmap visited(bounds.lowest, bounds.highest);
+        return simulateFirstRepeat(log, visited, bounds.passes);
+    }
+    FrequencyHashSet visited(numOfChanges);
+    return simulateFirstRepeat(log, visited, bounds.passes);
+}
+
+
+// The simulation for a few passes, then the closed form, which does not
+// depend on the number of passes.
+inline std::optional<long> findFirstRepeat(const FrequencyLog& log)
+{
+    constexpr long maxSimulatedPasses = 4;
+    size_t numOfChanges = log.getChanges().size();
+    if (numOfChanges == 0)
+    {
+        return std::nullopt;
+    }
+    SimulationBounds bounds(log);
+    if (bounds.fitsBitmap(numOfChanges))
+    {
+        FrequencyBitmap visited(bounds.lowest, bounds.highest);
+        if (auto repeated = simulateFirstRepeat(log, visited, std::min(bounds.passes, maxSimulatedPasses)))
+        {
+            return repeated;
+        }
+        if (bounds.passes <= maxSimulatedPasses)
+        {
+            return std::nullopt;
+        }
+    }
+    return findFirstRepeatInClosedForm(log);
+}
+
+
+inline long findFirstDuplicateFrequency(const FrequencyLog& log)
+{
+    if (auto repeated = findFirstRepeat(log))
+    {
+        return *repeated;
+    }
+    throw std::runtime_error("The frequency never repeats");
+}
+
+inline std::vector<int> parseFrequencyChanges(std::string_view input)
+{
+    scanner::Scanner scanner(input);
+    std::vector<int> values;
+    while (scanner.hasMore())
+    {
+        values.push_back(scanner.integer<int>());
+    }
+    return values;
+}
+
+
+// Changes are summed in blocks while they are parsed, so that the prefix
+// sums run over changes that are still in the cache, in the same pass over
+// the input.
+constexpr size_t frequencyBlockSize = 4096;
+
+
+inline FrequencyLog readFrequencyLog(std::string_view input)
+{
+    scanner::Scanner scanner(input);
+    FrequencyLog log;
+    while (scanner.hasMore())
+    {
+        log.add(scanner.integer<int>());
+        if (log.getChanges().size() % frequencyBlockSize == 0)
+        {
+            log.addFrequencies();
+        }
+    }
+    log.addFrequencies();
+    return log;
+}
+
+
+// Reads the changes as they arrive. The first repeated frequency needs
+// every change, the drift is the last frequency.
+inline std::pair<long, long> solveStreaming(puzzleInputs::ChunkReader& input)
+{
+    puzzleInputs::LineReader lines(input);
+    FrequencyLog log;
+    while (auto line = lines.next())
+    {
+        scanner::Scanner scanner(*line);
+        while (scanner.hasMore())
+        {
+            log.add(scanner.integer<int>());
+            if (log.getChanges().size() % frequencyBlockSize == 0)
+            {
+                log.addFrequencies();
+            }
+        }
+    }
+    log.addFrequencies();
+    return {log.getDrift(), findFirstDuplicateFrequency(log)};
+}
+
+}
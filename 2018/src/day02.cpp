@@ -1,131 +1,18 @@
-#include <fstream>
+#include <algorithm>
+#include <cstddef>
 #include <string>
-#include <map>
-#include <vector>
-#include <assert.h>
+#include <string_view>
 #include <utility>
-#include <filesystem>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "PuzzleInputs.hpp"
-
-using LetterDistribution = std::map<char, int>;
-using StringPair = std::pair<std::string, std::string>;
-
+#include "day02.hpp"
+#include "targets.hpp"
 
 namespace aoc2018::day02 {
 
-static LetterDistribution getLetterDistribution(std::string word)
-{
-    LetterDistribution letters;
-
-    for (auto& c : word)
-    {
-        if (letters.count(c) == 0)
-        {
-            letters[c] = 1;
-        }
-        else
-        {
-            letters[c]++;
-        }
-    }
-
-    return letters;
-}
-
-static bool containsLetterNTimes(const LetterDistribution& d, int n)
-{
-    for (auto& c : d)
-    {
-        if (c.second == n)
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
-static bool containsLetterTwice(const LetterDistribution& d)
-{
-    return containsLetterNTimes(d, 2);
-}
-
-static bool containsLetterThreeTimes(const LetterDistribution& d)
-{
-    return containsLetterNTimes(d, 3);
-}
-
-static int calculateChecksum(const std::vector<std::string>& ids)
-{
-    int twice = 0;
-    int threeTimes = 0;
-
-    for (auto& id : ids)
-    {
-        LetterDistribution d = getLetterDistribution(id);
-        if (containsLetterTwice(d))
-        {
-            twice++;
-        }
-        if (containsLetterThreeTimes(d))
-        {
-            threeTimes++;
-        }
-    }
-
-    return twice * threeTimes;
-}
-
-static bool differByOneLetter(const std::string& a, const std::string& b)
-{
-    int matches = 0;
-    assert(a.size() == b.size());
-    for (unsigned int i = 0; i < a.size(); ++i)
-    {
-        if (a[i] != b[i])
-        {
-            matches++;
-        }
-    }
-    return matches == 1;
-}
-
-static StringPair findWordsWhichDifferByOneLetter(const std::vector<std::string>& words)
-{
-    for (unsigned int listPos = 0; listPos < words.size(); ++listPos)
-    {
-        for (unsigned int candidatePos = listPos + 1; candidatePos < words.size(); ++candidatePos)
-        {
-            const std::string& word = words[listPos];
-            const std::string& candidate = words[candidatePos];
-            if (differByOneLetter(word, candidate))
-            {
-                return StringPair(word, candidate);
-            }
-        }
-    }
-    return StringPair();
-}
-
-static std::string removeDifferentLetters(StringPair words)
-{
-    assert(words.first.size() == words.second.size());
-
-    for (unsigned int i = 0; i < words.first.size(); ++i)
-    {
-        if (words.first[i] != words.second[i])
-        {
-            words.first.erase(i, 1);
-            words.second.erase(i, 1);
-            return removeDifferentLetters({words.first, words.second});
-        }
-    }
-
-    return words.first;
-}
-
 TEST(Day02, containsLetterTwice)
 {
     EXPECT_TRUE(containsLetterTwice(getLetterDistribution("bababc")));
@@ -148,6 +35,22 @@ TEST(Day02, containsLetterThreeTimes)
     EXPECT_FALSE(containsLetterThreeTimes(getLetterDistribution("abcdee")));
 }
 
+TEST(Day02, letterCounts)
+{
+    // Counts stop at 255 instead of wrapping around to 2
+    std::string word(257, 'a');
+    EXPECT_FALSE(containsLetterTwice(getLetterDistribution(word)));
+    word += "zz";
+    EXPECT_TRUE(containsLetterTwice(getLetterDistribution(word)));
+    EXPECT_TRUE(containsLetterNTimes(getLetterDistribution("zzzzz"), 5));
+
+    // Any character counts, not only lowercase letters
+    EXPECT_TRUE(containsLetterTwice(getLetterDistribution("a-b-")));
+    EXPECT_TRUE(containsLetterThreeTimes(getLetterDistribution("aBBcB")));
+    EXPECT_FALSE(containsLetterTwice(getLetterDistribution("aAbB\xff")));
+    EXPECT_TRUE(containsLetterTwice(getLetterDistribution("\xff\x01\xff")));
+}
+
 TEST(Day02, checksum)
 {
     EXPECT_EQ(12, calculateChecksum(
@@ -162,6 +65,72 @@ TEST(Day02, differByOneLetter)
     ASSERT_EQ("fguij", ids.second);
 }
 
+TEST(Day02, allPairs)
+{
+    std::vector<std::string_view> ids = {"abc", "abd", "xbc", "abc", "abcd", "abce", "xyz", "abd"};
+    using Pairs = std::vector<std::pair<size_t, size_t>>;
+    EXPECT_EQ((Pairs{{0, 1}, {0, 2}, {0, 7}, {1, 3}, {2, 3}, {3, 7}, {4, 5}}), findPairsWhichDifferByOneLetter(ids));
+    EXPECT_EQ((Pairs{{0, 1}}), findPairsWhichDifferByOneLetter(ids, Matches::first));
+    EXPECT_TRUE(findPairsWhichDifferByOneLetter({"abc", "abc", "cba", ""}).empty());
+    EXPECT_TRUE(findPairsWhichDifferByOneLetter({}).empty());
+    EXPECT_EQ((Pairs{{0, 1}}), findPairsWhichDifferByOneLetter({"a", "b"}));
+
+    EXPECT_EQ(StringPair(), findWordsWhichDifferByOneLetter({"abc", "xyz"}));
+}
+
+TEST(Day02, duplicatePairs)
+{
+    // Copies of two IDs that differ by one letter, among IDs of other
+    // lengths that match nothing
+    std::vector<std::string_view> ids;
+    for (int i = 0; i < 300; ++i)
+    {
+        ids.push_back(i % 3 == 0 ? "abcd" : i % 3 == 1 ? "abed" : i % 2 == 0 ? "ab" : "abcdefgh");
+    }
+    auto pairs = findPairsWhichDifferByOneLetter(ids);
+    ASSERT_EQ(100u * 100u, pairs.size());
+    EXPECT_TRUE(std::is_sorted(pairs.begin(), pairs.end()));
+    for (auto [first, second] : pairs)
+    {
+        EXPECT_LT(first, second);
+        EXPECT_EQ(1u, first % 3 + second % 3);
+    }
+    EXPECT_EQ((std::pair<size_t, size_t>{0, 1}), pairs.front());
+    EXPECT_EQ((std::pair<size_t, size_t>{297, 298}), pairs.back());
+    EXPECT_EQ((std::vector<std::pair<size_t, size_t>>{{0, 1}}), findPairsWhichDifferByOneLetter(ids, Matches::first));
+
+    EXPECT_TRUE(findPairsWhichDifferByOneLetter(std::vector<std::string_view>(5000, "abc")).empty());
+}
+
+TEST(Day02, firstPair)
+{
+    // The least pair, by its first ID and then by its second
+    std::vector<std::string_view> ids = {"aaa", "xyz", "xyw", "aab"};
+    EXPECT_EQ((std::vector<std::pair<size_t, size_t>>{{0, 3}}), findPairsWhichDifferByOneLetter(ids, Matches::first));
+    ids = {"ab", "cd", "ce", "xb", "cf"};
+    EXPECT_EQ((std::vector<std::pair<size_t, size_t>>{{0, 3}}), findPairsWhichDifferByOneLetter(ids, Matches::first));
+    ids = {"cd", "ab", "ce", "xb", "cf", "ce"};
+    EXPECT_EQ((std::vector<std::pair<size_t, size_t>>{{0, 2}}), findPairsWhichDifferByOneLetter(ids, Matches::first));
+
+    // Found at the last position, after a pair of later IDs at the first
+    std::vector<std::string> many;
+    for (int i = 0; i < 5000; ++i)
+    {
+        many.push_back(std::to_string(1000000 + 11 * i));
+    }
+    many.push_back("2000011");
+    many.push_back("1000001");
+    std::vector<std::string_view> views(many.begin(), many.end());
+    EXPECT_EQ((std::vector<std::pair<size_t, size_t>>{{0, 5001}}), findPairsWhichDifferByOneLetter(views, Matches::first));
+}
+
+TEST(Day02, matchesReference)
+{
+    FuzzTarget target;
+    auto outcome = fuzzing::fuzz(target, {.numOfCases = 2000});
+    EXPECT_FALSE(outcome.failure) << fuzzing::describe("day02", target, outcome);
+}
+
 TEST(Day02, removeDifferentLetters)
 {
     StringPair ids = findWordsWhichDifferByOneLetter(
@@ -170,17 +139,44 @@ TEST(Day02, removeDifferentLetters)
     ASSERT_EQ("aaccc", removeDifferentLetters({"aabbccbbbc", "aaddccdddc", }));
 }
 
-TEST(Day02, solution)
+TEST(Day02, streaming)
+{
+    puzzleInputs::ChunkReader input("abcde\nfghij\nklmno\npqrst\nfguij\naxcye\nwvxyz\n", 4);
+    EXPECT_EQ(std::make_pair(0, std::string("fgij")), solveStreaming(input));
+
+    puzzleInputs::ChunkReader ids("abcdef\nbababc\nabbcde\nabcccd\naabcdd\nabcdee\nababab\n", 5);
+    EXPECT_EQ(12, solveStreaming(ids).first);
+}
+
+TEST(Day02, windowsLineEndings)
 {
-    std::ifstream input(puzzleInputs::getInputDirectory() / "day02_input.txt");
-    EXPECT_TRUE(input.is_open());
-    std::vector<std::string> ids;
-    std::string id;
+    std::string_view text = "abcde\r\nfghij\r\nklmno\r\npqrst\r\nfguij\r\naxcye\r\nwvxyz\r\n";
+    EXPECT_EQ("fgij", removeDifferentLetters(findWordsWhichDifferByOneLetter(parseIds(text))));
+    puzzleInputs::ChunkReader input(text, 3);
+    EXPECT_EQ(std::make_pair(0, std::string("fgij")), solveStreaming(input));
+}
 
-    while (std::getline(input, id))
+TEST(Day02, checksumOverBatches)
+{
+    // More IDs than one batch of histograms, with a partial batch left over
+    std::vector<std::string_view> ids;
+    for (int i = 0; i < 100; ++i)
     {
-        ids.push_back(id);
+        ids.push_back(i % 3 == 0 ? "aabbbc" : i % 3 == 1 ? "abcdee" : "abcdef");
     }
+    EXPECT_EQ(67 * 34, calculateChecksum(ids));
+}
+
+TEST(Day02, checksumOfOtherCharacters)
+{
+    // IDs with other characters than a to z between the batched ones
+    EXPECT_EQ(3 * 3, calculateChecksum({"aabbbc", "AAb", "x1y11", "abcdef", "a-a-a\r"}));
+}
+
+TEST(Day02, solution)
+{
+    auto input = puzzleInputs::openInput("day02_input.txt");
+    std::vector<std::string_view> ids = parseIds(input.view());
 
     EXPECT_EQ(7657, calculateChecksum(ids));
     EXPECT_EQ("ivjhcadokeltwgsfsmqwrbnuy",
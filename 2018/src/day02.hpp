@@ -0,0 +1,438 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ByteSearch.hpp"
+#include "MappedInput.hpp"
+#include "StreamInput.hpp"
+
+namespace aoc2018::day02 {
+
+using StringPair = std::pair<std::string, std::string>;
+
+// Occurrences of each letter of a box ID in a byte per letter, padded to a
+// block that is searched with one compare for each count. Counts stop at
+// 255, so IDs of any length fit.
+using LetterCounts = std::array<std::uint8_t, simd::byteBlockSize>;
+
+// Counts the letters a to z, false if the word has any other character
+inline bool countLetters(std::string_view word, LetterCounts& counts)
+{
+    constexpr unsigned numOfLetters = 26;
+    for (char c : word)
+    {
+        auto letter = static_cast<unsigned>(c - 'a');
+        if (letter >= numOfLetters)
+        {
+            return false;
+        }
+        std::uint8_t& count = counts[letter];
+        count += count != 255;
+    }
+    return true;
+}
+
+
+// Occurrences of every character of a word, in a byte per character value.
+// Box IDs are lowercase letters, other characters count all the same.
+class LetterDistribution
+{
+public:
+    explicit LetterDistribution(std::string_view word)
+    {
+        for (char c : word)
+        {
+            std::uint8_t& count = counts[static_cast<unsigned char>(c)];
+            count += count != 255;
+        }
+    }
+
+    bool containsLetterNTimes(int n) const
+    {
+        assert(n > 0 && n < 255);
+        return simd::countBlocksWithByte(counts.data(), numOfBlocks, static_cast<std::uint8_t>(n)) != 0;
+    }
+
+private:
+    static constexpr size_t numOfBlocks = 256 / simd::byteBlockSize;
+
+    alignas(simd::byteBlockSize) std::array<std::uint8_t, 256> counts{};
+};
+
+
+inline LetterDistribution getLetterDistribution(std::string_view word)
+{
+    return LetterDistribution(word);
+}
+
+inline bool containsLetterNTimes(const LetterDistribution& d, int n)
+{
+    return d.containsLetterNTimes(n);
+}
+
+inline bool containsLetterTwice(const LetterDistribution& d)
+{
+    return containsLetterNTimes(d, 2);
+}
+
+inline bool containsLetterThreeTimes(const LetterDistribution& d)
+{
+    return containsLetterNTimes(d, 3);
+}
+
+
+// The checksum over IDs as they come, without keeping them. The letters of
+// a batch of IDs are counted into consecutive blocks, which are then
+// searched for twos and threes in one kernel call each. IDs with other
+// characters than a to z are counted on their own.
+class ChecksumCounter
+{
+public:
+    void add(std::string_view id)
+    {
+        LetterCounts& counts = batch[batchCount];
+        counts.fill(0);
+        if (!countLetters(id, counts))
+        {
+            LetterDistribution d(id);
+            twice += containsLetterTwice(d);
+            threeTimes += containsLetterThreeTimes(d);
+            return;
+        }
+        if (++batchCount == batchSize)
+        {
+            twice += countInBatch(2);
+            threeTimes += countInBatch(3);
+            batchCount = 0;
+        }
+    }
+
+    int getChecksum() const
+    {
+        return (twice + countInBatch(2)) * (threeTimes + countInBatch(3));
+    }
+
+private:
+    static constexpr size_t batchSize = 64;
+
+    int countInBatch(std::uint8_t n) const
+    {
+        return static_cast<int>(simd::countBlocksWithByte(batch.front().data(), batchCount, n));
+    }
+
+    alignas(simd::byteBlockSize) std::array<LetterCounts, batchSize> batch;
+    size_t batchCount{0};
+    int twice{0};
+    int threeTimes{0};
+};
+
+
+inline int calculateChecksum(const std::vector<std::string_view>& ids)
+{
+    ChecksumCounter counter;
+    for (auto& id : ids)
+    {
+        counter.add(id);
+    }
+    return counter.getChecksum();
+}
+
+
+namespace detail {
+
+constexpr std::uint64_t idHashBase = 0x100000001B3ull;
+constexpr std::uint32_t noId = UINT32_MAX;
+
+// The polynomial hash of an ID, which starts from the length so that IDs
+// of different lengths never match
+inline std::uint64_t hashId(std::string_view id)
+{
+    std::uint64_t hash = id.size();
+    for (char c : id)
+    {
+        hash = hash * idHashBase + static_cast<unsigned char>(c);
+    }
+    return hash;
+}
+
+inline size_t getSlot(std::uint64_t key, int shift)
+{
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+
+// The IDs before end grouped by equality. Groups are numbered in the order
+// of their first IDs, which stand for the whole group.
+struct EqualIds
+{
+    std::vector<std::string_view> distinct;
+    std::vector<std::uint64_t> hashes;
+    std::vector<std::uint32_t> firsts;
+    std::vector<std::uint32_t> groups;
+};
+
+inline EqualIds groupEqualIds(const std::vector<std::string_view>& ids, const std::vector<std::uint64_t>& hashes, size_t end)
+{
+    // The hash is kept in the slot, so that only a hit reads the group
+    struct Slot
+    {
+        std::uint64_t hash{0};
+        std::uint32_t group{noId};
+    };
+    size_t capacity = std::bit_ceil(std::max<size_t>(end * 2, 16));
+    int shift = 64 - std::countr_zero(capacity);
+    std::vector<Slot> slots(capacity);
+
+    EqualIds equal;
+    equal.groups.resize(end);
+    for (size_t i = 0; i < end; ++i)
+    {
+        size_t slot = getSlot(hashes[i], shift);
+        while (slots[slot].group != noId
+            && (slots[slot].hash != hashes[i] || equal.distinct[slots[slot].group] != ids[i]))
+        {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        if (slots[slot].group == noId)
+        {
+            slots[slot] = {hashes[i], static_cast<std::uint32_t>(equal.firsts.size())};
+            equal.distinct.push_back(ids[i]);
+            equal.hashes.push_back(hashes[i]);
+            equal.firsts.push_back(static_cast<std::uint32_t>(i));
+        }
+        equal.groups[i] = slots[slot].group;
+    }
+    return equal;
+}
+
+
+// Calls found(i, j), i < j, for each pair of IDs at Hamming distance one,
+// where the IDs are distinct. Two IDs of the same length differ in exactly
+// one letter when they are equal with the letter at some position masked,
+// so for each position the IDs are grouped by a hash of the ID without that
+// letter, which is the hash of the whole ID minus the term of the letter.
+// Only IDs in the same group are compared, O(n * L) expected. found may
+// narrow the limits of the scan for the positions that are left.
+struct ScanLimits
+{
+    // IDs from here on are only looked up, not added to the groups
+    size_t added{SIZE_MAX};
+    // IDs from here on are skipped
+    size_t scanned{SIZE_MAX};
+};
+
+template <typename Found>
+void forEachPairWhichDiffersByOneLetter(const std::vector<std::string_view>& ids, const std::vector<std::uint64_t>& hashes,
+    ScanLimits& limits, Found found)
+{
+    size_t maxLength = 0;
+    for (auto id : ids)
+    {
+        maxLength = std::max(maxLength, id.size());
+    }
+    // powers[k] is the weight of the letter k places before the end
+    std::vector<std::uint64_t> powers(maxLength + 1, 1);
+    for (size_t k = 1; k <= maxLength; ++k)
+    {
+        powers[k] = powers[k - 1] * idHashBase;
+    }
+
+    // An open addressing table from masked hashes to the last ID with it,
+    // the IDs before it follow through previous
+    size_t capacity = std::bit_ceil(std::max<size_t>(ids.size() * 2, 16));
+    int shift = 64 - std::countr_zero(capacity);
+    std::vector<std::uint32_t> heads(capacity);
+    std::vector<std::uint32_t> previous(ids.size());
+    std::vector<std::uint64_t> masked(ids.size());
+
+    auto differOnlyAt = [](std::string_view a, std::string_view b, size_t position) {
+        return a.size() == b.size() && a[position] != b[position]
+            && a.substr(0, position) == b.substr(0, position)
+            && a.substr(position + 1) == b.substr(position + 1);
+    };
+
+    for (size_t position = 0; position < maxLength; ++position)
+    {
+        std::fill(heads.begin(), heads.end(), noId);
+        for (size_t i = 0; i < ids.size() && i < limits.scanned; ++i)
+        {
+            std::string_view id = ids[i];
+            if (id.size() <= position)
+            {
+                continue;
+            }
+            std::uint64_t key = hashes[i] - static_cast<unsigned char>(id[position]) * powers[id.size() - 1 - position];
+            masked[i] = key;
+
+            size_t slot = getSlot(key, shift);
+            while (heads[slot] != noId && masked[heads[slot]] != key)
+            {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            for (std::uint32_t j = heads[slot]; j != noId; j = previous[j])
+            {
+                if (differOnlyAt(ids[j], id, position))
+                {
+                    found(j, i);
+                }
+            }
+            if (i < limits.added)
+            {
+                previous[i] = heads[slot];
+                heads[slot] = static_cast<std::uint32_t>(i);
+            }
+        }
+    }
+}
+
+}
+
+
+enum class Matches
+{
+    first,
+    all
+};
+
+
+// Pairs of IDs at Hamming distance one, as indices (i, j), i < j, sorted.
+// Equal IDs are searched once, through the first of them, and their pairs
+// are then repeated for every copy, so duplicates cost no more than the
+// pairs they add. The first pair is the least one. Any later ID may still
+// pair with an earlier one, so all of them are looked at; but once a pair
+// is found, the IDs after its first are no longer added to the groups, and
+// once it starts at the very first ID, the scan stops at its second.
+inline std::vector<std::pair<size_t, size_t>> findPairsWhichDifferByOneLetter(
+    const std::vector<std::string_view>& ids, Matches matches = Matches::all)
+{
+    std::vector<std::uint64_t> hashes(ids.size());
+    std::transform(ids.begin(), ids.end(), hashes.begin(), detail::hashId);
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    detail::EqualIds equal = detail::groupEqualIds(ids, hashes, ids.size());
+    detail::ScanLimits limits;
+    if (matches == Matches::first)
+    {
+        // Groups are numbered in the order of their first IDs, and the
+        // least pair between two groups is the one of their first IDs
+        std::optional<std::pair<size_t, size_t>> least;
+        detail::forEachPairWhichDiffersByOneLetter(equal.distinct, equal.hashes, limits, [&](size_t i, size_t j) {
+            if (!least || std::make_pair(i, j) < *least)
+            {
+                least = {i, j};
+                limits.added = i + 1;
+                limits.scanned = i == 0 ? j : limits.scanned;
+            }
+        });
+        if (least)
+        {
+            pairs.emplace_back(equal.firsts[least->first], equal.firsts[least->second]);
+        }
+        return pairs;
+    }
+
+    std::vector<std::pair<size_t, size_t>> distinctPairs;
+    detail::forEachPairWhichDiffersByOneLetter(equal.distinct, equal.hashes, limits, [&distinctPairs](size_t i, size_t j) {
+        distinctPairs.emplace_back(i, j);
+    });
+    if (distinctPairs.empty())
+    {
+        return pairs;
+    }
+
+    // The indices of each group in ascending order, the ones of group g
+    // are members[starts[g], starts[g + 1])
+    std::vector<std::uint32_t> starts(equal.distinct.size() + 1);
+    for (std::uint32_t group : equal.groups)
+    {
+        ++starts[group + 1];
+    }
+    std::partial_sum(starts.begin(), starts.end(), starts.begin());
+    std::vector<std::uint32_t> members(ids.size());
+    std::vector<std::uint32_t> next(starts.begin(), starts.end() - 1);
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        members[next[equal.groups[i]]++] = static_cast<std::uint32_t>(i);
+    }
+
+    for (auto [i, j] : distinctPairs)
+    {
+        for (std::uint32_t k = starts[i]; k < starts[i + 1]; ++k)
+        {
+            for (std::uint32_t l = starts[j]; l < starts[j + 1]; ++l)
+            {
+                pairs.emplace_back(std::min(members[k], members[l]), std::max(members[k], members[l]));
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+
+// The first ID that differs by one letter from a later one, and the first
+// of these later ones
+inline StringPair findWordsWhichDifferByOneLetter(const std::vector<std::string_view>& words)
+{
+    auto pairs = findPairsWhichDifferByOneLetter(words, Matches::first);
+    if (pairs.empty())
+    {
+        return StringPair();
+    }
+    return StringPair(words[pairs.front().first], words[pairs.front().second]);
+}
+
+inline std::string removeDifferentLetters(StringPair words)
+{
+    assert(words.first.size() == words.second.size());
+
+    for (unsigned int i = 0; i < words.first.size(); ++i)
+    {
+        if (words.first[i] != words.second[i])
+        {
+            words.first.erase(i, 1);
+            words.second.erase(i, 1);
+            return removeDifferentLetters({words.first, words.second});
+        }
+    }
+
+    return words.first;
+}
+
+inline std::vector<std::string_view> parseIds(std::string_view input)
+{
+    puzzleInputs::Lines lines(input);
+    return std::vector<std::string_view>(lines.begin(), lines.end());
+}
+
+
+// The checksum in a single pass over the IDs as they arrive, the IDs are
+// kept for the pair that differs by one letter
+inline std::pair<int, std::string> solveStreaming(puzzleInputs::ChunkReader& input)
+{
+    puzzleInputs::LineReader lines(input);
+    ChecksumCounter counter;
+    std::vector<std::string> ids;
+    while (auto line = lines.next())
+    {
+        if (!line->empty())
+        {
+            counter.add(*line);
+            ids.emplace_back(*line);
+        }
+    }
+    std::vector<std::string_view> views(ids.begin(), ids.end());
+    return {counter.getChecksum(), removeDifferentLetters(findWordsWhichDifferByOneLetter(views))};
+}
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include "Grid.hpp"
+#include "MappedInput.hpp"
+#include "Scanner.hpp"
+
+namespace aoc2018::day03 {
+
+using Canvas = grid::Grid<int>;
+
+
+class Rect
+{
+public:
+    int id;
+    int x;
+    int y;
+    int w;
+    int h;
+
+    bool operator!=(const Rect& other) const
+    {
+        return id != other.id;
+    }
+};
+
+inline Rect parseRect(std::string_view str)
+{
+    scanner::Scanner s(str);
+    Rect r;
+    s.expect('#');
+    r.id = s.integer<int>();
+    s.expect('@');
+    r.x  = s.integer<int>();
+    s.expect(',');
+    r.y  = s.integer<int>();
+    s.expect(':');
+    r.w  = s.integer<int>();
+    s.expect('x');
+    r.h  = s.integer<int>();
+    return r;
+}
+
+
+// The canvas is as large as the claims need, each cell counts the claims
+// covering it.
+inline Canvas createCanvas(const std::vector<Rect>& rects)
+{
+    int width = 0;
+    int height = 0;
+    for (auto& r : rects)
+    {
+        width = std::max(width, r.x + r.w);
+        height = std::max(height, r.y + r.h);
+    }
+
+    Canvas canvas(width, height, 0);
+    for (auto& r : rects)
+    {
+        for (int y = r.y; y < r.y + r.h; ++y)
+        {
+            for (int& v : canvas.row(y).subspan(r.x, r.w))
+            {
+                v++;
+            }
+        }
+    }
+    return canvas;
+}
+
+inline int calculateOverlap(const std::vector<Rect>& rects)
+{
+    Canvas canvas = createCanvas(rects);
+    return std::count_if(canvas.getCells().begin(), canvas.getCells().end(),
+        [](int v) { return v > 1; });
+}
+
+inline bool isOverlapping(const Rect& a, const Rect& b)
+{
+    return (a.x + a.w > b.x) && (a.x < b.x + b.w) &&
+        (a.y + a.h > b.y) && (a.y < b.y + b.h);
+}
+
+inline int findFirstNotOverlapping(const std::vector<Rect>& rects)
+{
+    for (auto& a : rects)
+    {
+        bool overlaps = false;
+
+        for (auto& b : rects)
+        {
+            if (a != b && isOverlapping(a, b))
+            {
+                overlaps = true;
+            }
+        }
+        if (!overlaps)
+        {
+            return a.id;
+        }
+    }
+    return -1;
+}
+
+inline std::vector<Rect> parseClaims(std::string_view input)
+{
+    std::vector<Rect> claims;
+    for (std::string_view claim : puzzleInputs::Lines(input))
+    {
+        claims.push_back(parseRect(claim));
+    }
+    return claims;
+}
+
+}
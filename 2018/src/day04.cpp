@@ -1,300 +1,17 @@
-#include <iomanip>
-#include <fstream>
-#include <sstream>
-#include <chrono>
-#include <functional>
-#include <filesystem>
-
 #include <gtest/gtest.h>
 
 #include "PuzzleInputs.hpp"
+#include "day04.hpp"
 
 namespace aoc2018::day04 {
 
-enum class Action
-{
-    BeginShift,
-    FallAsleep,
-    WakeUp
-};
-
-
-class Guard
-{
-public:
-    static const int INVALID_ID = -1;
-
-    Guard() :
-        isAsleep(false)
-    {
-    }
-
-    static bool isValidId(int id)
-    {
-        return id > INVALID_ID;
-    }
-
-    int getTotalSleepMinutes() const
-    {
-        int minutes = 0;
-
-        for (auto& s : sleeptimes)
-        {
-            minutes += (int)std::difftime(s.second, s.first) / 60;
-        }
-
-        return minutes;
-    }
-
-    int getMostSleptMinute() const
-    {
-        return getMostSleptMinuteAndCount().first;
-    }
-
-    std::pair<int, int> getMostSleptMinuteAndCount() const
-    {
-        std::map<int, int> minutes;
-        for (auto& s : sleeptimes)
-        {
-            auto cur = std::chrono::system_clock::from_time_t(s.first);
-            auto end = std::chrono::system_clock::from_time_t(s.second);
-            while (cur < end)
-            {
-                time_t t = std::chrono::system_clock::to_time_t(cur);
-                std::tm* tm = std::localtime(&t);
-                minutes[tm->tm_min]++;
-                cur += std::chrono::minutes(1);
-            }
-        }
-
-        std::pair<int, int> ret;
-        for (auto& m : minutes)
-        {
-            if (m.second > ret.second)
-            {
-                ret = m;
-            }
-        }
-        return ret;
-    }
-
-    void sleep(const time_t timestamp)
-    {
-        assert(!isAsleep);
-        isAsleep = true;
-        sleeptimes.push_back({timestamp, 0});
-    }
-
-    void wakeUp(const time_t timestamp)
-    {
-        assert(isAsleep);
-        isAsleep = false;
-        sleeptimes.back().second = timestamp;
-    }
-
-
-private:
-    bool isAsleep;
-    std::vector<std::pair<time_t, time_t>> sleeptimes;
-};
-
-
-class LogEntry
-{
-public:
-    LogEntry(const std::string& line) :
-        guardId(Guard::INVALID_ID)
-    {
-        setTimestamp(line);
-        setAction(line);
-    }
-
-    bool operator<(const LogEntry& other) const
-    {
-        return timestamp < other.timestamp;
-    }
-
-    time_t getTimestamp() const
-    {
-        return timestamp;
-    }
-
-    Action getAction() const
-    {
-        return action;
-    }
-
-    int getGuardId() const
-    {
-        return guardId;
-    }
-
-private:
-    void setTimestamp(const std::string& str)
-    {
-        std::stringstream ss(applyYearWorkaround(str.substr(1)));
-        std::tm t = {};
-        ss >> std::get_time(&t, "%Y-%m-%d %H:%M");
-        timestamp = std::mktime(&t);
-    }
-
-    // negative time_t represents error
-    std::string applyYearWorkaround(const std::string& str)
-    {
-        std::string fixed = str;
-        fixed.replace(0, 2, "20");
-        return fixed;
-    }
-
-    void setAction(const std::string& str)
-    {
-        if (str.find("begins shift") != std::string::npos)
-        {
-            action = Action::BeginShift;
-            setGuardId(str);
-        }
-        else if (str.find("falls asleep") != std::string::npos)
-        {
-            action = Action::FallAsleep;
-        }
-        else
-        {
-            action = Action::WakeUp;
-        }
-    }
-
-    void setGuardId(const std::string& str)
-    {
-        size_t begin = str.find('#');
-        size_t end = str.find(' ', begin);
-        if (begin != std::string::npos && end != std::string::npos && begin + 1 < end)
-        {
-            guardId = std::stoi(str.substr(begin + 1, end - begin));
-        }
-    }
-
-    time_t timestamp;
-    Action action;
-    int guardId;
-};
-
-
-class GuardLog
-{
-public:
-    void parse(const std::vector<LogEntry>& entries)
-    {
-        guard = nullptr;
-        for (auto& entry : entries)
-        {
-            parseEntry(entry);
-        }
-    }
-
-    const std::map<int, Guard>& getGuards() const
-    {
-        return guards;
-    }
-
-
-    int whoSleptMost() const
-    {
-        int id = Guard::INVALID_ID;
-        int minutes = 0;
-        for (auto& g : guards)
-        {
-            int total = g.second.getTotalSleepMinutes();
-            if (total > minutes)
-            {
-                minutes = total;
-                id = g.first;
-            }
-        }
-        return id;
-    }
-
-
-    int whoIsMostFrequentlySleepingOnSameMinute() const
-    {
-        int id = Guard::INVALID_ID;
-        int count = 0;
-        for (auto& g : guards)
-        {
-            std::pair<int, int> m = g.second.getMostSleptMinuteAndCount();
-            if (m.second > count)
-            {
-                count = m.second;
-                id = g.first;
-            }
-        }
-        return id;
-    }
-
-
-private:
-    void parseEntry(const LogEntry& entry)
-    {
-        switch (entry.getAction())
-        {
-            case Action::BeginShift:
-                onBeginShift(entry);
-                break;
-
-            case Action::FallAsleep:
-                onFallAsleep(entry);
-                break;
-
-            default:
-                onWakeUp(entry);
-                break;
-        }
-    }
-
-    void onBeginShift(const LogEntry& entry)
-    {
-        int id = entry.getGuardId();
-        if (Guard::isValidId(id))
-        {
-            guard = &guards[id];
-        }
-    }
-
-    void onFallAsleep(const LogEntry& entry)
-    {
-        if (guard)
-        {
-            guard->sleep(entry.getTimestamp());
-        }
-    }
-
-    void onWakeUp(const LogEntry& entry)
-    {
-        if (guard)
-        {
-            guard->wakeUp(entry.getTimestamp());
-        }
-    }
-
-    std::map<int, Guard> guards;
-    Guard* guard;
-};
-
-
 class Day04Solution : public ::testing::Test
 {
 protected:
     static void SetUpTestCase()
     {
-        std::ifstream input(puzzleInputs::getInputDirectory() / "day04_input.txt");
-        EXPECT_TRUE(input.is_open());
-        std::string line;
-        std::vector<LogEntry> entries;
-        while (std::getline(input, line))
-        {
-            entries.push_back(LogEntry(line));
-        }
-        std::sort(entries.begin(), entries.end());
-        log.parse(entries);
+        auto input = puzzleInputs::openInput("day04_input.txt");
+        log = parseLog(input.view());
     }
 
     static GuardLog log;
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "MappedInput.hpp"
+#include "Scanner.hpp"
+
+namespace aoc2018::day04 {
+
+enum class Action
+{
+    BeginShift,
+    FallAsleep,
+    WakeUp
+};
+
+
+class Guard
+{
+public:
+    static const int INVALID_ID = -1;
+
+    Guard() :
+        isAsleep(false)
+    {
+    }
+
+    static bool isValidId(int id)
+    {
+        return id > INVALID_ID;
+    }
+
+    int getTotalSleepMinutes() const
+    {
+        int minutes = 0;
+
+        for (auto& s : sleeptimes)
+        {
+            minutes += (int)std::difftime(s.second, s.first) / 60;
+        }
+
+        return minutes;
+    }
+
+    int getMostSleptMinute() const
+    {
+        return getMostSleptMinuteAndCount().first;
+    }
+
+    std::pair<int, int> getMostSleptMinuteAndCount() const
+    {
+        std::map<int, int> minutes;
+        for (auto& s : sleeptimes)
+        {
+            auto cur = std::chrono::system_clock::from_time_t(s.first);
+            auto end = std::chrono::system_clock::from_time_t(s.second);
+            while (cur < end)
+            {
+                time_t t = std::chrono::system_clock::to_time_t(cur);
+                std::tm* tm = std::localtime(&t);
+                minutes[tm->tm_min]++;
+                cur += std::chrono::minutes(1);
+            }
+        }
+
+        std::pair<int, int> ret;
+        for (auto& m : minutes)
+        {
+            if (m.second > ret.second)
+            {
+                ret = m;
+            }
+        }
+        return ret;
+    }
+
+    void sleep(const time_t timestamp)
+    {
+        assert(!isAsleep);
+        isAsleep = true;
+        sleeptimes.push_back({timestamp, 0});
+    }
+
+    void wakeUp(const time_t timestamp)
+    {
+        assert(isAsleep);
+        isAsleep = false;
+        sleeptimes.back().second = timestamp;
+    }
+
+
+private:
+    bool isAsleep;
+    std::vector<std::pair<time_t, time_t>> sleeptimes;
+};
+
+
+class LogEntry
+{
+public:
+    LogEntry(std::string_view line) :
+        guardId(Guard::INVALID_ID)
+    {
+        setTimestamp(line);
+        setAction(line);
+    }
+
+    bool operator<(const LogEntry& other) const
+    {
+        return timestamp < other.timestamp;
+    }
+
+    time_t getTimestamp() const
+    {
+        return timestamp;
+    }
+
+    Action getAction() const
+    {
+        return action;
+    }
+
+    int getGuardId() const
+    {
+        return guardId;
+    }
+
+private:
+    void setTimestamp(std::string_view str)
+    {
+        scanner::Scanner s(str);
+        std::tm t = {};
+        s.expect('[');
+        t.tm_year = applyYearWorkaround(s.integer<int>()) - 1900;
+        s.expect('-');
+        t.tm_mon = s.integer<int>() - 1;
+        s.expect('-');
+        t.tm_mday = s.integer<int>();
+        t.tm_hour = s.integer<int>();
+        s.expect(':');
+        t.tm_min = s.integer<int>();
+        timestamp = std::mktime(&t);
+    }
+
+    // negative time_t represents error
+    static int applyYearWorkaround(int year)
+    {
+        return 2000 + year % 100;
+    }
+
+    void setAction(std::string_view str)
+    {
+        if (str.find("begins shift") != std::string_view::npos)
+        {
+            action = Action::BeginShift;
+            setGuardId(str);
+        }
+        else if (str.find("falls asleep") != std::string_view::npos)
+        {
+            action = Action::FallAsleep;
+        }
+        else
+        {
+            action = Action::WakeUp;
+        }
+    }
+
+    void setGuardId(std::string_view str)
+    {
+        size_t begin = str.find('#');
+        if (begin != std::string_view::npos)
+        {
+            scanner::Scanner s(str.substr(begin + 1));
+            guardId = s.tryInteger<int>().value_or(Guard::INVALID_ID);
+        }
+    }
+
+    time_t timestamp;
+    Action action;
+    int guardId;
+};
+
+
+class GuardLog
+{
+public:
+    void parse(const std::vector<LogEntry>& entries)
+    {
+        guard = nullptr;
+        for (auto& entry : entries)
+        {
+            parseEntry(entry);
+        }
+    }
+
+    const std::map<int, Guard>& getGuards() const
+    {
+        return guards;
+    }
+
+
+    int whoSleptMost() const
+    {
+        int id = Guard::INVALID_ID;
+        int minutes = 0;
+        for (auto& g : guards)
+        {
+            int total = g.second.getTotalSleepMinutes();
+            if (total > minutes)
+            {
+                minutes = total;
+                id = g.first;
+            }
+        }
+        return id;
+    }
+
+
+    int whoIsMostFrequentlySleepingOnSameMinute() const
+    {
+        int id = Guard::INVALID_ID;
+        int count = 0;
+        for (auto& g : guards)
+        {
+            std::pair<int, int> m = g.second.getMostSleptMinuteAndCount();
+            if (m.second > count)
+            {
+                count = m.second;
+                id = g.first;
+            }
+        }
+        return id;
+    }
+
+
+private:
+    void parseEntry(const LogEntry& entry)
+    {
+        switch (entry.getAction())
+        {
+            case Action::BeginShift:
+                onBeginShift(entry);
+                break;
+
+            case Action::FallAsleep:
+                onFallAsleep(entry);
+                break;
+
+            default:
+                onWakeUp(entry);
+                break;
+        }
+    }
+
+    void onBeginShift(const LogEntry& entry)
+    {
+        int id = entry.getGuardId();
+        if (Guard::isValidId(id))
+        {
+            guard = &guards[id];
+        }
+    }
+
+    void onFallAsleep(const LogEntry& entry)
+    {
+        if (guard)
+        {
+            guard->sleep(entry.getTimestamp());
+        }
+    }
+
+    void onWakeUp(const LogEntry& entry)
+    {
+        if (guard)
+        {
+            guard->wakeUp(entry.getTimestamp());
+        }
+    }
+
+    std::map<int, Guard> guards;
+    Guard* guard;
+};
+
+inline GuardLog parseLog(std::string_view input)
+{
+    std::vector<LogEntry> entries;
+    for (std::string_view line : puzzleInputs::Lines(input))
+    {
+        entries.push_back(LogEntry(line));
+    }
+    std::sort(entries.begin(), entries.end());
+
+    GuardLog log;
+    log.parse(entries);
+    return log;
+}
+
+}
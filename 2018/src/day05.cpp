@@ -1,82 +1,53 @@
-#include <string>
-#include <fstream>
-#include <filesystem>
+#include <string_view>
+#include <utility>
 
 #include <gtest/gtest.h>
 
 #include "PuzzleInputs.hpp"
+#include "day05.hpp"
+#include "targets.hpp"
 
 namespace aoc2018::day05 {
 
-static bool doesReact(char a, char b)
-{
-    return (islower(a) && (toupper(a) == b)) ||
-        (isupper(a) && (tolower(a) == b));
-}
-
-static size_t findReactingUnits(const std::string& str, size_t begin)
+TEST(Day05, example1)
 {
-    char prev = ' ';
-    for (size_t i = begin; i < str.size(); ++i)
-    {
-        char c = str[i];
-        if (i > 0 && doesReact(prev, c))
-        {
-            return i - 1;
-        }
-        prev = c;
-    }
-    return std::string::npos;
+    EXPECT_EQ("dabCBAcaDA", findPolymer("dabAcCaCBAcCcaDA"));
 }
 
-static std::string findPolymer(const std::string& str)
+TEST(Day05, example2)
 {
-    std::string polymer = str;
-    size_t begin = 0;
-    size_t pos = 0;
-    while((pos = findReactingUnits(polymer, begin)) != std::string::npos)
-    {
-        begin = pos > 0 ? pos - 1 : pos;
-        polymer.erase(pos, 2);
-    }
-    return polymer;
+    EXPECT_EQ(4, findShortestPolymer("dabAcCaCBAcCcaDA"));
 }
 
-static size_t findShortestPolymer(const std::string& str)
+TEST(Day05, streaming)
 {
-    std::vector<size_t> sizes;
-    for (char c = 'a'; c <= 'z'; c++)
+    Reactor reactor;
+    for (char unit : std::string_view("dabAcCaCBAcCcaDA"))
     {
-        std::string candidate = str;
-        candidate.erase(std::remove_if(candidate.begin(), candidate.end(),
-            [&](char r) -> bool {
-                return ((c == r) || (c == tolower(r)));
-            }), candidate.end());
-        sizes.push_back(findPolymer(candidate).size());
+        reactor.add(unit);
     }
-    std::sort(sizes.begin(), sizes.end());
-    return sizes.front();
-}
-
+    EXPECT_EQ("dabCBAcaDA", reactor.getPolymer());
 
-TEST(Day05, example1)
-{
-    EXPECT_EQ("dabCBAcaDA", findPolymer("dabAcCaCBAcCcaDA"));
+    puzzleInputs::ChunkReader input("dabAcCaCBAcCcaDA\n", 5);
+    EXPECT_EQ((std::pair<size_t, size_t>(10, 4)), solveStreaming(input));
 }
 
-TEST(Day05, example2)
+TEST(Day05, matchesReference)
 {
-    EXPECT_EQ(4, findShortestPolymer("dabAcCaCBAcCcaDA"));
+    FuzzTarget target;
+    auto outcome = fuzzing::fuzz(target, {.numOfCases = 2000});
+    EXPECT_FALSE(outcome.failure) << fuzzing::describe("day05", target, outcome);
 }
 
 TEST(Day05, solution)
 {
-    std::string line;
-    std::ifstream input(puzzleInputs::getInputDirectory() / "day05_input.txt");
-    EXPECT_TRUE(input.is_open());
-    std::getline(input, line);
+    auto input = puzzleInputs::openInput("day05_input.txt");
+    std::string_view line = *input.lines().begin();
     EXPECT_EQ(9900, findPolymer(line).size());
     EXPECT_EQ(4992, findShortestPolymer(line));
+
+    puzzleInputs::ChunkReader stream(input.view(), 4096);
+    EXPECT_EQ((std::pair<size_t, size_t>(9900, 4992)), solveStreaming(stream));
 }
 
 }
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Parallel.hpp"
+#include "StreamInput.hpp"
+
+namespace aoc2018::day05 {
+
+inline bool doesReact(char a, char b)
+{
+    return (islower(a) && (toupper(a) == b)) ||
+        (isupper(a) && (tolower(a) == b));
+}
+
+inline size_t findReactingUnits(const std::string& str, size_t begin)
+{
+    char prev = ' ';
+    for (size_t i = begin; i < str.size(); ++i)
+    {
+        char c = str[i];
+        if (i > 0 && doesReact(prev, c))
+        {
+            return i - 1;
+        }
+        prev = c;
+    }
+    return std::string::npos;
+}
+
+inline std::string findPolymer(std::string_view str)
+{
+    std::string polymer(str);
+    size_t begin = 0;
+    size_t pos = 0;
+    while((pos = findReactingUnits(polymer, begin)) != std::string::npos)
+    {
+        begin = pos > 0 ? pos - 1 : pos;
+        polymer.erase(pos, 2);
+    }
+    return polymer;
+}
+
+inline size_t findShortestPolymer(std::string_view str)
+{
+    constexpr size_t numOfUnitTypes = 26;
+    return parallel::parallelReduce(0, numOfUnitTypes, std::numeric_limits<size_t>::max(),
+        [str](size_t type) {
+            char c = 'a' + type;
+            std::string candidate(str);
+            candidate.erase(std::remove_if(candidate.begin(), candidate.end(),
+                [&](char r) -> bool {
+                    return ((c == r) || (c == tolower(r)));
+                }), candidate.end());
+            return findPolymer(candidate).size();
+        },
+        [](size_t lhs, size_t rhs) { return std::min(lhs, rhs); });
+}
+
+
+// Reduces a polymer unit by unit: a new unit either reacts with the last
+// surviving one or survives itself, so memory is bounded by the result.
+class Reactor
+{
+public:
+    // Units of type removed (lower case) are dropped before they react
+    explicit Reactor(char removed = '\0') :
+        removed(removed)
+    {
+    }
+
+    void add(char unit)
+    {
+        if (tolower(unit) == removed)
+        {
+            return;
+        }
+        if (!polymer.empty() && doesReact(polymer.back(), unit))
+        {
+            polymer.pop_back();
+        }
+        else
+        {
+            polymer.push_back(unit);
+        }
+    }
+
+    const std::string& getPolymer() const
+    {
+        return polymer;
+    }
+
+private:
+    char removed;
+    std::string polymer;
+};
+
+
+// Reacts the units as they arrive, only the surviving polymer is kept. The
+// reactions without each unit type run on it at the end, removing a type
+// from the reduced polymer gives the same length as from the input.
+inline std::pair<size_t, size_t> solveStreaming(puzzleInputs::ChunkReader& input)
+{
+    Reactor full;
+    while (auto chunk = input.next())
+    {
+        for (char unit : *chunk)
+        {
+            if (isalpha(static_cast<unsigned char>(unit)))
+            {
+                full.add(unit);
+            }
+        }
+    }
+
+    const std::string& polymer = full.getPolymer();
+    size_t shortest = polymer.size();
+    for (char type = 'a'; type <= 'z'; ++type)
+    {
+        Reactor reactor(type);
+        for (char unit : polymer)
+        {
+            reactor.add(unit);
+        }
+        shortest = std::min(shortest, reactor.getPolymer().size());
+    }
+    return {polymer.size(), shortest};
+}
+
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include "MappedInput.hpp"
+#include "Parallel.hpp"
+#include "Scanner.hpp"
+
+namespace aoc2018::day06 {
+
+static constexpr int infinite = -1;
+static constexpr int invalidIndex = -1;
+
+struct Point
+{
+    int x;
+    int y;
+};
+
+
+class Map
+{
+public:
+    Map(std::vector<Point> coordinates) :
+        coordinates(coordinates),
+        dimensions(getMaxDimensions(coordinates))
+    {
+        calculateAreasAroundCoordinates();
+    }
+
+    const std::vector<int>& getAreasAroundCoordinates() const
+    {
+        return areasAroundCoordinates;
+    }
+
+    static int getDistance(const Point& a, const Point& b)
+    {
+        return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+    }
+
+    int getLargestFiniteAreaAroundOneCoordinate() const
+    {
+        int max = 0;
+        for (auto a : areasAroundCoordinates)
+        {
+            if (a > max)
+            {
+                max = a;
+            }
+        }
+        return max;
+    }
+
+    int getAreaWithMaxDistanceToEachCoordinate(int maxDistance) const
+    {
+        return parallel::parallelReduce(0, dimensions.y + 1, 0,
+            [&](int y) {
+                int areaSize = 0;
+                for (int x = 0; x <= dimensions.x; ++x)
+                {
+                    int sum = 0;
+                    for (auto& p : coordinates)
+                    {
+                        sum += getDistance({x, y}, p);
+                    }
+
+                    if (sum < maxDistance)
+                    {
+                        areaSize++;
+                    }
+                }
+                return areaSize;
+            },
+            std::plus<int>());
+    }
+
+
+private:
+    Point getMaxDimensions(const std::vector<Point>& coordinates) const
+    {
+        Point max = {0, 0};
+
+        for (auto& p : coordinates)
+        {
+            if (max.x < p.x)
+            {
+                max.x = p.x;
+            }
+            if (max.y < p.y)
+            {
+                max.y = p.y;
+            }
+        }
+
+        return max;
+    }
+
+    int findNearestCoordinateOfPoint(const Point& p) const
+    {
+        int nearest = invalidIndex;
+        int min = std::numeric_limits<int>::max();
+        int second = min;
+        int i = 0;
+
+        for (auto& c : coordinates)
+        {
+            int distance = getDistance(p, c);
+            if (distance <= min)
+            {
+                second = min;
+                min = distance;
+                nearest = i;
+            }
+            i++;
+        }
+
+        return min != second ? nearest : invalidIndex;
+    }
+
+    bool isAtBorder(const Point& p) const
+    {
+        return p.x == 0 || p.y == 0 || p.x == dimensions.x || p.y == dimensions.y;
+    }
+
+    void mapToArea(const Point& p, std::vector<int>& areas) const
+    {
+        int i = findNearestCoordinateOfPoint(p);
+
+        if (i != invalidIndex)
+        {
+            if (isAtBorder(p))
+            {
+                areas[i] = infinite;
+            }
+            else if (areas[i] != infinite)
+            {
+                areas[i]++;
+            }
+        }
+    }
+
+    static std::vector<int> mergeAreas(std::vector<int> areas, const std::vector<int>& other)
+    {
+        for (size_t i = 0; i < areas.size(); ++i)
+        {
+            areas[i] = areas[i] == infinite || other[i] == infinite ? infinite : areas[i] + other[i];
+        }
+        return areas;
+    }
+
+    // The rows are mapped in parallel, each into its own areas
+    void calculateAreasAroundCoordinates()
+    {
+        areasAroundCoordinates = parallel::parallelReduce(0, dimensions.y + 1, std::vector<int>(coordinates.size(), 0),
+            [this](int y) {
+                std::vector<int> areas(coordinates.size(), 0);
+                for (int x = 0; x <= dimensions.x; ++x)
+                {
+                    mapToArea({x, y}, areas);
+                }
+                return areas;
+            },
+            mergeAreas, 8);
+    }
+
+    std::vector<Point> coordinates;
+    std::vector<int> areasAroundCoordinates;
+    Point dimensions;
+};
+
+inline std::vector<Point> parseCoordinates(std::string_view input)
+{
+    std::vector<Point> coordinates;
+    for (std::string_view line : puzzleInputs::Lines(input))
+    {
+        scanner::Scanner s(line);
+        int x = s.integer<int>();
+        s.expect(',');
+        int y = s.integer<int>();
+        coordinates.push_back({x, y});
+    }
+    return coordinates;
+}
+
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Arena.hpp"
+#include "MappedInput.hpp"
+
+namespace aoc2018::day07 {
+
+// Each step with the steps it depends on
+using Steps = std::pmr::map<char, std::pmr::set<char>>;
+
+class Worker
+{
+public:
+    Worker(char item, int baseTime) :
+        item(item),
+        timeLeft(baseTime + item - 'A' + 1)
+    {
+    }
+
+    void tick()
+    {
+        timeLeft--;
+    }
+
+    bool isReady() const
+    {
+        return timeLeft <= 0;
+    }
+
+    char getItem() const
+    {
+        return item;
+    }
+
+private:
+    char item;
+    int timeLeft;
+};
+
+
+class Scheduler
+{
+public:
+    Scheduler(unsigned int numOfWorkers, int baseTime) :
+        maxNumOfWorkers(numOfWorkers),
+        baseTime(baseTime),
+        finished(allocations::getResource())
+    {
+        workers.reserve(maxNumOfWorkers);
+    }
+
+    void add(char item)
+    {
+        if (workers.size() >= maxNumOfWorkers)
+        {
+            return;
+        }
+        for (auto& w : workers)
+        {
+            if (w.getItem() == item)
+            {
+                return;
+            }
+        }
+        workers.push_back(Worker(item, baseTime));
+    }
+
+    void tick()
+    {
+        finished.clear();
+
+        for (auto& w : workers)
+        {
+            w.tick();
+            if (w.isReady())
+            {
+                finished.insert(w.getItem());
+            }
+        }
+
+        workers.erase(std::remove_if(workers.begin(), workers.end(),
+            [](const Worker& w) {return w.isReady();}), workers.end());
+    }
+
+    const std::pmr::set<char>& getFinished() const
+    {
+        return finished;
+    }
+
+private:
+    std::vector<Worker> workers;
+    unsigned int maxNumOfWorkers;
+    int baseTime;
+    std::pmr::set<char> finished;
+};
+
+
+inline void removeStep(char step, Steps& steps)
+{
+    for (auto& s : steps)
+    {
+        s.second.erase(step);
+    }
+    steps.erase(step);
+}
+
+
+inline void removeSteps(const std::pmr::set<char>& remove, Steps& steps)
+{
+    for (auto r : remove)
+    {
+        removeStep(r, steps);
+    }
+}
+
+
+inline std::string sortSteps(const Steps& input)
+{
+    std::string answer;
+    Steps steps(input, allocations::getResource());
+
+    while (steps.size() > 0)
+    {
+        std::pmr::set<char> candidates(allocations::getResource());
+        for (auto& s : steps)
+        {
+            if (s.second.size() == 0)
+            {
+                candidates.insert(s.first);
+            }
+        }
+
+        char c = *candidates.begin();
+        answer += c;
+        removeStep(c, steps);
+    }
+
+    return answer;
+}
+
+
+inline int processInParallel(const Steps& input, int numOfWorkers, int baseTime)
+{
+    int ticks = 0;
+    Steps steps(input, allocations::getResource());
+    Scheduler scheduler(numOfWorkers, baseTime);
+
+    while (true)
+    {
+        removeSteps(scheduler.getFinished(), steps);
+
+        if (steps.size() == 0)
+        {
+            break;
+        }
+
+        for (auto& s : steps)
+        {
+            if (s.second.size() == 0)
+            {
+                scheduler.add(s.first);
+            }
+        }
+        scheduler.tick();
+        ticks++;
+    }
+
+    return ticks;
+}
+
+
+constexpr bool isSpace(char c)
+{
+    return c == ' ';
+}
+
+
+constexpr std::pair<char, char> parseLine(std::string_view line)
+{
+    constexpr unsigned int validLineLength = 48;
+    constexpr unsigned int dependencyPos = 5;
+    constexpr unsigned int stepPos = 36;
+    constexpr char NA = '-';
+
+    if (line.length() == validLineLength &&
+        isSpace(line[dependencyPos - 1]) && isSpace(line[dependencyPos + 1]) &&
+        isSpace(line[stepPos - 1]) && isSpace(line[stepPos + 1]))
+    {
+        return {line[dependencyPos], line[stepPos]};
+    }
+    std::cerr << "Invalid input: " << line << std::endl;
+    return {NA, NA};
+}
+
+
+inline Steps parseInput(std::string_view input)
+{
+    Steps steps(allocations::getResource());
+    for (std::string_view line : puzzleInputs::Lines(input))
+    {
+        auto s = parseLine(line);
+        steps.try_emplace(s.first);
+        steps[s.second].insert(s.first);
+    }
+    return steps;
+}
+
+
+// The steps A-Z as bits, bit i stands for 'A' + i. Unlike Steps this needs
+// no allocations, so fixed inputs can be parsed and sorted at compile time.
+struct StepMasks
+{
+    std::uint32_t steps{0};
+    std::array<std::uint32_t, 26> dependencies{};
+};
+
+
+constexpr std::uint32_t getStepBit(char step)
+{
+    if (step < 'A' || step > 'Z')
+    {
+        throw std::invalid_argument("Invalid step");
+    }
+    return 1u << (step - 'A');
+}
+
+
+constexpr StepMasks parseStepMasks(std::string_view input)
+{
+    StepMasks masks;
+    for (std::string_view line : puzzleInputs::Lines(input))
+    {
+        auto [dependency, step] = parseLine(line);
+        masks.steps |= getStepBit(dependency) | getStepBit(step);
+        masks.dependencies[step - 'A'] |= getStepBit(dependency);
+    }
+    return masks;
+}
+
+
+// The same order as sortSteps(const Steps&), zero terminated
+constexpr std::array<char, 27> sortSteps(const StepMasks& masks)
+{
+    std::array<char, 27> order{};
+    std::uint32_t done = 0;
+    for (size_t n = 0; done != masks.steps; ++n)
+    {
+        int next = 0;
+        while (next < 26 && (!(masks.steps >> next & 1) || done >> next & 1 || (masks.dependencies[next] & ~done) != 0))
+        {
+            next++;
+        }
+        if (next == 26)
+        {
+            throw std::invalid_argument("Circular dependencies");
+        }
+        order[n] = static_cast<char>('A' + next);
+        done |= 1u << next;
+    }
+    return order;
+}
+
+}
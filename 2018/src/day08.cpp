@@ -1,83 +1,14 @@
-#include <gtest/gtest.h>
-
-#include <fstream>
-#include <string>
+#include <stdexcept>
+#include <utility>
 #include <vector>
-#include <filesystem>
 
 #include <gtest/gtest.h>
 
 #include "PuzzleInputs.hpp"
+#include "day08.hpp"
 
 namespace aoc2018::day08 {
 
-class Parser
-{
-public:
-    Parser(const std::vector<int>& input) :
-        input(input),
-        index(0),
-        sum(0)
-    {
-        rootValue = parse();
-    }
-
-    int parse()
-    {
-        int nChildren = input[index++];
-        int nMetadata = input[index++];
-        int value = 0;
-        std::vector<int> childValues;
-
-        if (nChildren > 0)
-        {
-            for (int i = 0; i < nChildren; ++i)
-            {   
-                childValues.push_back(parse());
-            }
-        }
-
-        for (int i = 0; i < nMetadata; i++)
-        {
-            int m = input[index++];
-            sum += m;
-            value += getNodeValueIncrement(m, childValues);
-        }
-
-        return value;
-    }
-
-    int getNodeValueIncrement(int metadata, const std::vector<int>& childValues) const
-    {
-        if (childValues.size() == 0)
-        {
-            return metadata;
-        }
-        else if (metadata > 0 && metadata <= static_cast<int>(childValues.size()))
-        {
-            return childValues[metadata - 1];
-        }
-        return 0;
-    }
-
-    int getSumOfMetadata() const
-    {
-        return sum;
-    }
-
-    int getRootValue() const
-    {
-        return rootValue;
-    }
-
-private:
-    const std::vector<int>& input;
-    int index;
-    int sum;
-    int rootValue;
-};
-
-
 TEST(Day08, metadataOnly)
 {
     Parser p({0, 2, 10, 11});
@@ -103,22 +34,25 @@ TEST(Day08, example)
     EXPECT_EQ(66, p.getRootValue());
 }
 
-TEST(Day08, solution)
+TEST(Day08, streaming)
 {
-    std::vector<int> tree;
-    std::ifstream input(puzzleInputs::getInputDirectory() / "day08_input.txt");
-    EXPECT_TRUE(input.is_open());
-    std::string line;
-    while (std::getline(input, line))
+    for (size_t chunkSize : {1, 2, 3, 64})
     {
-        std::string num;
-        std::stringstream ss(line);
-        while (std::getline(ss, num, ' '))
-        {
-            tree.push_back(std::stoi(num));
-        }
+        puzzleInputs::ChunkReader input("2 3 0 3 10 11 12 1 1 0 1 99 2 1 1 2\n", chunkSize);
+        EXPECT_EQ(std::make_pair(138, 66), solveStreaming(input));
     }
 
+    puzzleInputs::ChunkReader incomplete("2 3 0 3 10 11 12", 4);
+    EXPECT_THROW(solveStreaming(incomplete), std::runtime_error);
+    puzzleInputs::ChunkReader tooLong("0 1 5 7", 4);
+    EXPECT_THROW(solveStreaming(tooLong), std::runtime_error);
+}
+
+TEST(Day08, solution)
+{
+    auto input = puzzleInputs::openInput("day08_input.txt");
+    std::vector<int> tree = parseTree(input.view());
+
     Parser p(tree);
     EXPECT_EQ(48260, p.getSumOfMetadata());
     EXPECT_EQ(25981, p.getRootValue());
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cctype>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Scanner.hpp"
+#include "StreamInput.hpp"
+
+namespace aoc2018::day08 {
+
+class Parser
+{
+public:
+    Parser(const std::vector<int>& input) :
+        input(input),
+        index(0),
+        sum(0)
+    {
+        rootValue = parse();
+    }
+
+    int parse()
+    {
+        int nChildren = input[index++];
+        int nMetadata = input[index++];
+        int value = 0;
+        std::vector<int> childValues;
+
+        if (nChildren > 0)
+        {
+            for (int i = 0; i < nChildren; ++i)
+            {   
+                childValues.push_back(parse());
+            }
+        }
+
+        for (int i = 0; i < nMetadata; i++)
+        {
+            int m = input[index++];
+            sum += m;
+            value += getNodeValueIncrement(m, childValues);
+        }
+
+        return value;
+    }
+
+    static int getNodeValueIncrement(int metadata, const std::vector<int>& childValues)
+    {
+        if (childValues.size() == 0)
+        {
+            return metadata;
+        }
+        else if (metadata > 0 && metadata <= static_cast<int>(childValues.size()))
+        {
+            return childValues[metadata - 1];
+        }
+        return 0;
+    }
+
+    int getSumOfMetadata() const
+    {
+        return sum;
+    }
+
+    int getRootValue() const
+    {
+        return rootValue;
+    }
+
+private:
+    const std::vector<int>& input;
+    int index;
+    int sum;
+    int rootValue;
+};
+
+inline std::vector<int> parseTree(std::string_view input)
+{
+    scanner::Scanner scanner(input);
+    std::vector<int> tree;
+    while (scanner.hasMore())
+    {
+        tree.push_back(scanner.integer<int>());
+    }
+    return tree;
+}
+
+
+// Builds the same sums as Parser from numbers fed one at a time. Only the
+// nodes from the root to the current one are kept.
+class TreeStream
+{
+public:
+    void add(int number)
+    {
+        switch (expected)
+        {
+            case Expected::numOfChildren:
+                path.push_back({number, 0, {}, 0});
+                expected = Expected::numOfMetadata;
+                break;
+
+            case Expected::numOfMetadata:
+                path.back().remainingMetadata = number;
+                continueWithCurrentNode();
+                break;
+
+            case Expected::metadata:
+            {
+                Node& node = path.back();
+                sum += number;
+                node.value += Parser::getNodeValueIncrement(number, node.childValues);
+                if (--node.remainingMetadata == 0)
+                {
+                    finishCurrentNode();
+                }
+                break;
+            }
+
+            case Expected::nothing:
+                throw std::runtime_error("Numbers after the end of the tree");
+        }
+    }
+
+    bool isComplete() const
+    {
+        return expected == Expected::nothing;
+    }
+
+    int getSumOfMetadata() const
+    {
+        return sum;
+    }
+
+    int getRootValue() const
+    {
+        return rootValue;
+    }
+
+private:
+    enum class Expected
+    {
+        numOfChildren,
+        numOfMetadata,
+        metadata,
+        nothing
+    };
+
+    struct Node
+    {
+        int numOfChildren;
+        int remainingMetadata;
+        std::vector<int> childValues;
+        int value;
+    };
+
+    void continueWithCurrentNode()
+    {
+        Node& node = path.back();
+        if (static_cast<int>(node.childValues.size()) < node.numOfChildren)
+        {
+            expected = Expected::numOfChildren;
+        }
+        else if (node.remainingMetadata > 0)
+        {
+            expected = Expected::metadata;
+        }
+        else
+        {
+            finishCurrentNode();
+        }
+    }
+
+    void finishCurrentNode()
+    {
+        int value = path.back().value;
+        path.pop_back();
+        if (path.empty())
+        {
+            rootValue = value;
+            expected = Expected::nothing;
+            return;
+        }
+        path.back().childValues.push_back(value);
+        continueWithCurrentNode();
+    }
+
+    std::vector<Node> path;
+    Expected expected{Expected::numOfChildren};
+    int sum{0};
+    int rootValue{0};
+};
+
+
+inline std::pair<int, int> solveStreaming(puzzleInputs::ChunkReader& input)
+{
+    TreeStream tree;
+    int number = -1;  // Digits may continue in the next chunk
+    while (auto chunk = input.next())
+    {
+        for (char c : *chunk)
+        {
+            if (isdigit(static_cast<unsigned char>(c)))
+            {
+                number = (number < 0 ? 0 : number * 10) + (c - '0');
+            }
+            else if (number >= 0)
+            {
+                tree.add(number);
+                number = -1;
+            }
+        }
+    }
+    if (number >= 0)
+    {
+        tree.add(number);
+    }
+
+    if (!tree.isComplete())
+    {
+        throw std::runtime_error("Incomplete tree");
+    }
+    return {tree.getSumOfMetadata(), tree.getRootValue()};
+}
+
+}
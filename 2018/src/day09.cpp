@@ -1,70 +1,37 @@
-#include <gtest/gtest.h>
-#include <list>
+#include <stdexcept>
 
-namespace aoc2018::day09 {
+#include <gtest/gtest.h>
 
-static void incrementByTwo(std::list<int>::iterator& it, std::list<int>& container)
-{
-    it++;
-    if (it == container.end())
-    {
-        it = container.begin();
-    }
-    it++;
-}
+#include "day09.hpp"
+#include "targets.hpp"
 
+namespace aoc2018::day09 {
 
-static void decrement(std::list<int>::iterator& it, std::list<int>& container)
+TEST(Day09, example)
 {
-    if (it == container.begin())
-    {
-        it = container.end();
-    }
-    it--;
+    EXPECT_EQ(32, getHighscore(9, 25));
+    EXPECT_EQ(8317, getHighscore(10, 1618));
+    EXPECT_EQ(146373, getHighscore(13, 7999));
+    EXPECT_EQ(2764, getHighscore(17, 1104));
+    EXPECT_EQ(54718, getHighscore(21, 6111));
+    EXPECT_EQ(37305, getHighscore(30, 5807));
 }
 
 
-static long int getHighscore(int numOfPlayers, int rounds)
+TEST(Day09, parseGame)
 {
-    std::list<int> marbles = {0};
-    std::vector<long int> scores(numOfPlayers);
-    int player = 0;
-    auto current = marbles.begin();
-
-    for (int i = 1; i <= rounds; ++i)
-    {
-        if (i % 23 != 0)
-        {
-            incrementByTwo(current, marbles);
-            current = marbles.insert(current, i);
-        }
-        else
-        {
-            for (int j = 0; j < 7; ++j)
-            {
-                decrement(current, marbles);
-            }
-            auto pick = current;
-            current++;
-            scores[player] += i + *pick;
-            marbles.erase(pick);
-        }
-        player = (player + 1) % numOfPlayers;
-    }
-
-    std::sort(scores.begin(), scores.end());
-    return scores.back();
+    Game game = parseGame("10 players; last marble is worth 1618 points\n");
+    EXPECT_EQ(10, game.numOfPlayers);
+    EXPECT_EQ(1618, game.lastMarble);
+    EXPECT_THROW(parseGame("10 players"), std::runtime_error);
 }
 
 
-TEST(Day09, example)
+TEST(Day09, matchesReference)
 {
-    EXPECT_EQ(32, getHighscore(9, 25));
-    EXPECT_EQ(8317, getHighscore(10, 1618));
-    EXPECT_EQ(146373, getHighscore(13, 7999));
-    EXPECT_EQ(2764, getHighscore(17, 1104));
-    EXPECT_EQ(54718, getHighscore(21, 6111));
-    EXPECT_EQ(37305, getHighscore(30, 5807));
+    FuzzTarget target;
+    auto outcome = fuzzing::fuzz(target, {.numOfCases = 2000});
+    EXPECT_FALSE(outcome.failure) << fuzzing::describe("day09", target, outcome);
 }
 
 
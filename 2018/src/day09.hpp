@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include "Arena.hpp"
+#include "Scanner.hpp"
+
+namespace aoc2018::day09 {
+
+using Marbles = std::pmr::list<int>;
+
+inline void incrementByTwo(Marbles::iterator& it, Marbles& container)
+{
+    it++;
+    if (it == container.end())
+    {
+        it = container.begin();
+    }
+    it++;
+}
+
+
+inline void decrement(Marbles::iterator& it, Marbles& container)
+{
+    if (it == container.begin())
+    {
+        it = container.end();
+    }
+    it--;
+}
+
+
+inline long int getHighscore(int numOfPlayers, int rounds)
+{
+    Marbles marbles(1, 0, allocations::getResource());
+    std::vector<long int> scores(numOfPlayers);
+    int player = 0;
+    auto current = marbles.begin();
+
+    for (int i = 1; i <= rounds; ++i)
+    {
+        if (i % 23 != 0)
+        {
+            incrementByTwo(current, marbles);
+            current = marbles.insert(current, i);
+        }
+        else
+        {
+            for (int j = 0; j < 7; ++j)
+            {
+                decrement(current, marbles);
+            }
+            auto pick = current;
+            current++;
+            scores[player] += i + *pick;
+            marbles.erase(pick);
+        }
+        player = (player + 1) % numOfPlayers;
+    }
+
+    std::sort(scores.begin(), scores.end());
+    return scores.back();
+}
+
+
+struct Game
+{
+    int numOfPlayers;
+    int lastMarble;
+};
+
+
+// "473 players; last marble is worth 70904 points"
+inline Game parseGame(std::string_view input)
+{
+    scanner::Scanner s(input);
+    Game game;
+    game.numOfPlayers = s.integer<int>();
+    s.expect("players; last marble is worth");
+    game.lastMarble = s.integer<int>();
+    s.expect("points");
+    return game;
+}
+
+}
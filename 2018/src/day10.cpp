@@ -1,145 +1,63 @@
-#include <gtest/gtest.h>
-
+#include <algorithm>
+#include <string_view>
 #include <vector>
-#include <string>
-#include <fstream>
-#include <filesystem>
 
 #include <gtest/gtest.h>
 
 #include "PuzzleInputs.hpp"
+#include "day10.hpp"
 
-namespace aoc2018::day10 {
-
-constexpr int height = 120;
-constexpr int width = 180;
-
-struct Point
-{
-    int x;
-    int y;
-    int vx;
-    int vy;
-};
-
-
-static void advance(std::vector<Point>& points)
-{
-    for (auto& p : points)
-    {
-        p.x += p.vx;
-        p.y += p.vy;
-    }
-}
-
-
-static bool isOnArea(const Point & p, int x, int y, int w, int h)
-{
-    return p.x >= x && p.x < w && p.y >= y && p.y < h;
-}
+#if defined(AOC_EMBED_INPUTS)
+#include "EmbeddedInputs2018.hpp"
+#endif
 
+namespace aoc2018::day10 {
 
-static bool findVerticalLine(std::vector<Point>& points, int minLen)
+TEST(Day10, render)
 {
-    static bool canvas[width][height];
-    memset(canvas, 0, sizeof(canvas));
-
-    for (auto& p : points)
-    {
-        if (isOnArea(p, 0, 0, width, height))
-        {
-            canvas[p.x][p.y] = true;
-        }
-    }
-
-    for (int x = 0; x < width; ++x)
-    {
-        int len = 0;
-        for (int y = 0; y < height; ++y)
-        {
-            len = canvas[x][y] ? len + 1 : 0;
-            if (len >= minLen)
-            {
-                return true;
-            }
-        }
-    }
-    return false;
+    std::vector<Point> points = {{5, 3, 0, 0}, {7, 4, 0, 0}, {5, 4, 0, 0}};
+    EXPECT_EQ("#..\n#.#", render(points));
 }
 
 
-static void print(std::vector<Point>& points)
+TEST(Day10, solution)
 {
-    std::vector<std::string> lines(height);
-    for (auto& line : lines)
-    {
-        line = std::string(width, '.');
-    }
-
-    for (auto& p : points)
-    {
-        if (isOnArea(p, 0, 0, width, height))
-        {
-            lines[p.y][p.x] = '#';
-        }
-    }
+    constexpr bool printResult = false;
+    auto input = puzzleInputs::openInput("day10_input.txt");
+    std::vector<Point> points = parsePoints(input.view());
 
-    for (auto& l : lines)
+    int seconds = waitForMessage(points);
+    if (printResult)
     {
-        std::cout << l << std::endl;
+        print(points);
     }
+    EXPECT_EQ(10476, seconds);
 }
 
 
-static Point parse(const std::string& line)
+TEST(Day10, compileTimeParse)
 {
-    constexpr size_t xPos = 10;
-    constexpr size_t yPos = 18;
-    constexpr size_t len = 6;
-    constexpr size_t xvPos = 36;
-    constexpr size_t yvPos = 40;
-    constexpr size_t vLen = 2;
-
-    return {std::stoi(line.substr(xPos, len)),
-            std::stoi(line.substr(yPos, len)),
-            std::stoi(line.substr(xvPos, vLen)),
-            std::stoi(line.substr(yvPos, vLen))};
+    constexpr std::string_view input =
+        "position=< 9,  1> velocity=< 0,  2>\n"
+        "position=<-54217, -21587> velocity=< 5,  2>\n"
+        "position=< 21618,  43453> velocity=<-2, -4>\n";
+    constexpr auto points = parsePoints<countPoints(input)>(input);
+    static_assert(points.size() == 2);
+    static_assert(points[0].x == -54217 && points[0].y == -21587 && points[0].vx == 5 && points[0].vy == 2);
+    static_assert(points[1].x == 21618 && points[1].vy == -4);
+    EXPECT_EQ(parsePoints(input).size(), points.size());
 }
 
-
-TEST(Day10, solution)
+#if defined(AOC_EMBED_INPUTS)
+TEST(Day10, parsedAtCompileTime)
 {
-    constexpr bool printResult = false;
-    constexpr size_t expectedLineSize = 43;
-    std::vector<Point> points;
-    std::ifstream input(puzzleInputs::getInputDirectory() / "day10_input.txt");
-    EXPECT_TRUE(input.is_open());
-    std::string line;
-
-    while (std::getline(input, line))
-    {
-        if (line.size() == expectedLineSize)
-        {
-            Point p = parse(line);
-            points.push_back(p);
-        }
-    }
-
-    int seconds;
-    constexpr int minLen = 10;
-    for (seconds = 1; seconds < 20000; ++seconds)
-    {
-        advance(points);
-        if (findVerticalLine(points, minLen))
-        {
-            if (printResult)
-            {
-                print(points);
-            }
-            break;
-        }
-    }
-    EXPECT_EQ(10476, seconds);
+    constexpr auto points = parsePoints<countPoints(inputs::day10_input)>(inputs::day10_input);
+    std::vector<Point> expected = parsePoints(inputs::day10_input);
+    ASSERT_EQ(expected.size(), points.size());
+    EXPECT_TRUE(std::equal(points.begin(), points.end(), expected.begin(), [](const Point& lhs, const Point& rhs) {
+        return lhs.x == rhs.x && lhs.y == rhs.y && lhs.vx == rhs.vx && lhs.vy == rhs.vy;
+    }));
 }
+#endif
 
 }
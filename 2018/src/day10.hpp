@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Grid.hpp"
+#include "MappedInput.hpp"
+#include "Scanner.hpp"
+
+namespace aoc2018::day10 {
+
+struct Point
+{
+    int x;
+    int y;
+    int vx;
+    int vy;
+};
+
+
+inline void advance(std::vector<Point>& points)
+{
+    for (auto& p : points)
+    {
+        p.x += p.vx;
+        p.y += p.vy;
+    }
+}
+
+
+struct Area
+{
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+
+inline Area getBoundingBox(const std::vector<Point>& points)
+{
+    if (points.empty())
+    {
+        return {0, 0, 0, 0};
+    }
+
+    auto [minX, maxX] = std::minmax_element(points.begin(), points.end(),
+        [](const Point& lhs, const Point& rhs) { return lhs.x < rhs.x; });
+    auto [minY, maxY] = std::minmax_element(points.begin(), points.end(),
+        [](const Point& lhs, const Point& rhs) { return lhs.y < rhs.y; });
+    return {minX->x, minY->y, maxX->x - minX->x + 1, maxY->y - minY->y + 1};
+}
+
+
+// The points only spell something once they have converged, as long as
+// their bounding box is larger than maxArea there is nothing to look for.
+inline bool findVerticalLine(const std::vector<Point>& points, int minLen)
+{
+    constexpr long maxArea = 180 * 120;
+    Area area = getBoundingBox(points);
+    if (area.height < minLen || static_cast<long>(area.width) * area.height > maxArea)
+    {
+        return false;
+    }
+
+    grid::Grid<char> canvas(area.width, area.height, 0);
+    for (auto& p : points)
+    {
+        canvas(p.x - area.x, p.y - area.y) = 1;
+    }
+
+    // Row by row, counting the length of the line that ends in every column
+    std::vector<int> lengths(area.width, 0);
+    for (int y = 0; y < area.height; ++y)
+    {
+        std::span<const char> row = canvas.row(y);
+        for (int x = 0; x < area.width; ++x)
+        {
+            lengths[x] = row[x] ? lengths[x] + 1 : 0;
+            if (lengths[x] >= minLen)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+// The bounding box of the points, one line per row.
+inline std::string render(const std::vector<Point>& points)
+{
+    if (points.empty())
+    {
+        return "";
+    }
+
+    Area area = getBoundingBox(points);
+    grid::Grid<char> canvas(area.width + 1, area.height, '.');
+    for (int y = 0; y < area.height; ++y)
+    {
+        canvas(area.width, y) = '\n';
+    }
+    for (const auto& p : points)
+    {
+        canvas(p.x - area.x, p.y - area.y) = '#';
+    }
+    return std::string(canvas.getCells().begin(), canvas.getCells().end() - 1);
+}
+
+
+inline void print(const std::vector<Point>& points)
+{
+    std::cout << render(points) << std::endl;
+}
+
+
+constexpr Point parse(std::string_view line)
+{
+    scanner::Scanner s(line);
+    Point p;
+    s.expect("position=<");
+    p.x = s.integer<int>();
+    s.expect(',');
+    p.y = s.integer<int>();
+    s.expect('>');
+    s.expect("velocity=<");
+    p.vx = s.integer<int>();
+    s.expect(',');
+    p.vy = s.integer<int>();
+    s.expect('>');
+    return p;
+}
+
+// The lines of the input have a fixed width like
+// "position=<-10351, -10360> velocity=< 1,  1>"
+constexpr size_t pointLineSize = 43;
+
+inline std::vector<Point> parsePoints(std::string_view input)
+{
+    std::vector<Point> points;
+
+    for (std::string_view line : puzzleInputs::Lines(input))
+    {
+        if (line.size() == pointLineSize)
+        {
+            points.push_back(parse(line));
+        }
+    }
+    return points;
+}
+
+
+constexpr size_t countPoints(std::string_view input)
+{
+    size_t count = 0;
+    for (std::string_view line : puzzleInputs::Lines(input))
+    {
+        count += line.size() == pointLineSize;
+    }
+    return count;
+}
+
+
+// Without allocations for parsing at compile time, N is countPoints(input)
+template<size_t N>
+constexpr std::array<Point, N> parsePoints(std::string_view input)
+{
+    std::array<Point, N> points{};
+    size_t i = 0;
+    for (std::string_view line : puzzleInputs::Lines(input))
+    {
+        if (line.size() == pointLineSize)
+        {
+            points.at(i++) = parse(line);
+        }
+    }
+    return points;
+}
+
+
+// Advances the points until the message shows up and tells how many
+// seconds it took, 0 if nothing shows up within maxSeconds.
+inline int waitForMessage(std::vector<Point>& points, int maxSeconds = 20000)
+{
+    constexpr int minLen = 10;
+    for (int seconds = 1; seconds < maxSeconds; ++seconds)
+    {
+        advance(points);
+        if (findVerticalLine(points, minLen))
+        {
+            return seconds;
+        }
+    }
+    return 0;
+}
+
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "Grid.hpp"
+#include "Parallel.hpp"
+#include "Profiling.hpp"
+
+namespace aoc2018::day11 {
+
+class Square
+{
+public:
+    Square(int x = 0, int y = 0, int size = 0, int power = std::numeric_limits<int>::min()) :
+        x(x), y(y), size(size), power(power)
+    {
+    }
+
+    bool operator<(const Square& other) const
+    {
+        return power < other.power;
+    }
+
+    bool operator==(const Square& other) const
+    {
+        return size == other.size && x == other.x && y == other.y && power && other.power;
+    }
+
+    int x;
+    int y;
+    int size;
+    int power;
+};
+
+
+class PowerGrid
+{
+public:
+    static constexpr int size = 300;
+
+    // A border of zeros above and left of the summed-area table saves the
+    // special cases for the first row and column.
+    using Grid = grid::Grid<int>;
+
+    PowerGrid(int sn) : sn(sn)
+    {
+        Grid levels(size, size, 0, 1, 0);
+        populateSummedAreaTable(levels);
+        findHighestPowers(levels);
+    }
+    
+    Square getSquareWithHighestPowerBySize(int squareSize) const
+    {
+        for (auto& s : highestPowers)
+        {
+            if (s.size == squareSize)
+            {
+                return s;
+            }
+        }
+        return Square();
+    }
+
+    Square getSquareWithHighestPower() const
+    {
+        return *std::max_element(highestPowers.begin(), highestPowers.end());
+    }
+
+private:
+    int calculatePowerLevel(int x, int y) const
+    {
+        int rackId = x + 10;
+        return ((rackId * y + sn) * rackId % 1000 / 100 - 5);
+    }
+
+    // Cell (x, y) of the grid holds the fuel cell (x + 1, y + 1)
+    void populateSummedAreaTable(Grid& levels) const
+    {
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                levels(x, y) = calculatePowerLevel(x + 1, y + 1)
+                    + levels(x, y - 1)
+                    + levels(x - 1, y)
+                    - levels(x - 1, y - 1);
+            }
+        }
+    }
+
+    void findHighestPowers(const Grid& levels)
+    {
+        AOC_PROFILE_ZONE("day11::PowerGrid::findHighestPowers");
+        highestPowers.resize(size);
+        parallel::parallelFor(0, size, [&](size_t i) {
+            highestPowers[i] = findSquareWithHighestPowerOfSize(levels, i + 1);
+        });
+    }
+
+    // Walks the rows of the bottom right corners, ties go to the smallest x
+    // and then the smallest y.
+    Square findSquareWithHighestPowerOfSize(const Grid& levels, int squareSize) const
+    {
+        Square square(0, 0, squareSize);
+
+        for (int y = squareSize - 1; y < size; ++y)
+        {
+            const int* bottom = &levels(0, y);
+            const int* top = &levels(0, y - squareSize);
+            for (int x = squareSize - 1; x < size; ++x)
+            {
+                int power = bottom[x]
+                    + top[x - squareSize]
+                    - top[x]
+                    - bottom[x - squareSize];
+
+                int left = x - squareSize + 2;
+                if (power > square.power || (power == square.power && left < square.x))
+                {
+                    square.power = power;
+                    square.x = left;
+                    square.y = y - squareSize + 2;
+                }
+            }
+        }
+        
+        return square;
+    }
+
+private:
+    std::vector<Square> highestPowers;
+    int sn;
+};
+
+}
@@ -1,83 +1,9 @@
 #include <gtest/gtest.h>
-#include <set>
-#include <vector>
-#include <numeric>
 
-namespace aoc2018::day12 {
-
-class Pots
-{
-public:
-    Pots(const std::string& initial)
-    {
-        for (size_t i = 0; i < initial.size(); ++i)
-        {
-            if (initial[i] == PLANT_SYMBOL)
-            {
-                plants.insert(i);
-            }
-        }
-    }
-
-    void addRule(const std::string& rule)
-    {
-        rules.push_back({});
-        auto& r = rules.back();
-        assert(r.size() == rule.size());
-        for (size_t i = 0; i < rule.size(); ++i)
-        {
-            r[i] = rule[i] == PLANT_SYMBOL;
-        }
-    }
-
-    void advance()
-    {
-        std::set<int> nextGen;
-
-        int min = *plants.begin();
-        int max = *plants.rbegin();
-
-        for (int i = min - 2; i < max + 2; ++i)
-        {
-            for (auto& rule : rules)
-            {
-                if (isMatching(rule, i))
-                {
-                    nextGen.insert(i);
-                    break;
-                }
-            }
-        }
-
-        plants.swap(nextGen);
-    }
-
-    int getSum() const
-    {
-        return std::accumulate(plants.begin(), plants.end(), 0);
-    }
-
-private:
-    static const int RULE_SIZE = 5;
-    static const char PLANT_SYMBOL = '#';
-    std::vector<std::array<bool, RULE_SIZE>> rules;
-    std::set<int> plants;
-
-    bool isMatching(const std::array<bool, RULE_SIZE>& rule, int i) const
-    {
-        int offset = -2;
-        for (auto b : rule)
-        {
-            if (b != (plants.count(i + offset) > 0))
-            {
-                return false;
-            }
-            offset++;
-        }
-        return true;
-    }
-};
+#include "day12.hpp"
+#include "targets.hpp"
 
+namespace aoc2018::day12 {
 
 TEST(Day12, example)
 {
@@ -106,6 +32,89 @@ TEST(Day12, example)
 }
 
 
+TEST(Day12, parsePots)
+{
+    Pots pots = parsePots(
+        "initial state: #..#.#..##......###...###\n"
+        "\n"
+        "...## => #\n"
+        "..#.. => #\n"
+        ".#... => #\n"
+        ".#.#. => #\n"
+        ".#.## => #\n"
+        ".##.. => #\n"
+        ".#### => #\n"
+        "#.#.# => #\n"
+        "#.### => #\n"
+        "##.#. => #\n"
+        "##.## => #\n"
+        "###.. => #\n"
+        "###.# => #\n"
+        "####. => #\n"
+        "..... => .\n"
+        "#.... => .\n");
+
+    EXPECT_EQ(145, pots.getSum());
+    for (int round = 0; round < 20; ++round)
+    {
+        pots.advance();
+    }
+    EXPECT_EQ(325, pots.getSum());
+}
+
+
+TEST(Day12, noPlantsLeft)
+{
+    // Advancing used to read the first and last plant of an empty set
+    Pots pots = parsePots("initial state: #\n\n");
+    pots.advance();
+    pots.advance();
+    EXPECT_EQ(0, pots.getSum());
+    EXPECT_EQ(0, getSumAfter(pots, 10));
+}
+
+
+TEST(Day12, growsTwoPotsRight)
+{
+    // The pot two to the right of the last plant was never checked
+    Pots pots = parsePots("initial state: #\n\n#.... => #\n");
+    pots.advance();
+    EXPECT_EQ(2, pots.getSum());
+}
+
+
+TEST(Day12, extrapolatesOnceSettled)
+{
+    // The sum does not change for a few generations while the plants
+    // spread, but they have not settled. Six equal sum deltas used to be
+    // taken for a settled pattern.
+    Pots pots = parsePots(
+        "initial state: #\n"
+        "\n"
+        "....# => #\n"
+        "...#. => #\n"
+        "...## => #\n"
+        "..#.. => #\n"
+        "..### => #\n"
+        ".#... => #\n"
+        ".###. => #\n"
+        "#.... => #\n"
+        "#...# => #\n"
+        "#.### => #\n"
+        "##... => #\n"
+        "###.. => #\n");
+    EXPECT_EQ(2, getSumAfter(pots, 8));
+}
+
+
+TEST(Day12, matchesReference)
+{
+    FuzzTarget target;
+    auto outcome = fuzzing::fuzz(target, {.numOfCases = 500, .maxSize = 32});
+    EXPECT_FALSE(outcome.failure) << fuzzing::describe("day12", target, outcome);
+}
+
+
 TEST(Day12, solution)
 {
     Pots pots("##.#############........##.##.####..#.#..#.##...###.##......#.#..#####....##..#####..#.#.##.#.##");
@@ -135,33 +144,7 @@ TEST(Day12, solution)
     EXPECT_EQ(4110, pots.getSum());
 
     // Part 2
-    int prev = 0;
-    int prevDelta = 0;
-    int nSameDeltas = 0;
-    while (true)
-    {
-        pots.advance();
-        int sum = pots.getSum();
-        int delta = sum - prev;
-        if (delta == prevDelta)
-        {
-            nSameDeltas++;
-            if (nSameDeltas > 5)
-            {
-                // pattern found, extrapolate result
-                EXPECT_EQ(2650000000466, sum + ((50000000000 - round - 1) * delta));
-                break;
-            }
-        }
-        else
-        {
-            nSameDeltas = 0;
-        }
-
-        prev = sum;
-        prevDelta = delta;
-        round++; 
-    }
+    EXPECT_EQ(2650000000466, getSumAfter(pots, 50000000000 - round));
 }
 
 }
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Arena.hpp"
+#include "Scanner.hpp"
+
+namespace aoc2018::day12 {
+
+class Pots
+{
+public:
+    Pots(const std::string& initial) :
+        plants(allocations::getResource()),
+        nextGen(allocations::getResource())
+    {
+        for (size_t i = 0; i < initial.size(); ++i)
+        {
+            if (initial[i] == PLANT_SYMBOL)
+            {
+                plants.push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    // A copy allocates from the resource of the copying solve, not from the
+    // one the original came from. Assignments reuse the memory of the
+    // target, so a copy that is assigned every generation stops allocating
+    // once it is large enough.
+    Pots(const Pots& other) :
+        rules(other.rules),
+        plants(other.plants, allocations::getResource()),
+        nextGen(allocations::getResource())
+    {
+    }
+
+    Pots(Pots&&) = default;
+    Pots& operator=(Pots&&) = default;
+
+    Pots& operator=(const Pots& other)
+    {
+        rules = other.rules;
+        plants = other.plants;
+        return *this;
+    }
+
+    void addRule(const std::string& rule)
+    {
+        rules.push_back({});
+        auto& r = rules.back();
+        assert(r.size() == rule.size());
+        for (size_t i = 0; i < rule.size(); ++i)
+        {
+            r[i] = rule[i] == PLANT_SYMBOL;
+        }
+    }
+
+    // "....." never grows a plant, once all plants are gone nothing grows.
+    // The next generation goes to the buffer of the previous one, the two
+    // swap, so advancing allocates only while the plants spread.
+    void advance()
+    {
+        if (plants.empty())
+        {
+            return;
+        }
+        nextGen.clear();
+
+        int min = *plants.begin();
+        int max = *plants.rbegin();
+
+        for (int i = min - 2; i <= max + 2; ++i)
+        {
+            for (auto& rule : rules)
+            {
+                if (isMatching(rule, i))
+                {
+                    nextGen.push_back(i);
+                    break;
+                }
+            }
+        }
+
+        plants.swap(nextGen);
+    }
+
+    int getSum() const
+    {
+        return std::accumulate(plants.begin(), plants.end(), 0);
+    }
+
+    size_t getCount() const
+    {
+        return plants.size();
+    }
+
+    // How far the plants moved if they are the ones of other shifted
+    std::optional<int> findShiftFrom(const Pots& other) const
+    {
+        if (plants.size() != other.plants.size())
+        {
+            return std::nullopt;
+        }
+        if (plants.empty())
+        {
+            return 0;
+        }
+        int shift = *plants.begin() - *other.plants.begin();
+        bool shifted = std::equal(plants.begin(), plants.end(), other.plants.begin(),
+            [shift](int pot, int otherPot) { return pot == otherPot + shift; });
+        return shifted ? std::optional<int>(shift) : std::nullopt;
+    }
+
+private:
+    static const int RULE_SIZE = 5;
+    static const char PLANT_SYMBOL = '#';
+    std::vector<std::array<bool, RULE_SIZE>> rules;
+    // Sorted pot numbers
+    std::pmr::vector<int> plants;
+    std::pmr::vector<int> nextGen;
+
+    bool isMatching(const std::array<bool, RULE_SIZE>& rule, int i) const
+    {
+        int offset = -2;
+        for (auto b : rule)
+        {
+            if (b != std::binary_search(plants.begin(), plants.end(), i + offset))
+            {
+                return false;
+            }
+            offset++;
+        }
+        return true;
+    }
+};
+
+inline Pots parsePots(std::string_view input)
+{
+    scanner::Scanner s(input);
+    s.expect("initial state:");
+    Pots pots(std::string(s.word()));
+
+    while (s.hasMore())
+    {
+        std::string_view pattern = s.word();
+        s.expect("=>");
+        if (s.word() == "#")
+        {
+            pots.addRule(std::string(pattern));
+        }
+    }
+    return pots;
+}
+
+
+// Plants eventually settle into a pattern that just shifts. Once a
+// generation is the previous one shifted, every later one is as well, the
+// rules do not depend on the position, and the sum grows by the number of
+// plants times the shift every generation.
+inline long int getSumAfter(Pots pots, long int generations)
+{
+    long int prev = pots.getSum();
+
+    Pots previous = pots;
+    for (long int generation = 1; generation <= generations; ++generation)
+    {
+        previous = pots;
+        pots.advance();
+        long int sum = pots.getSum();
+        if (auto shift = pots.findShiftFrom(previous))
+        {
+            return sum + (generations - generation) * *shift * static_cast<long int>(pots.getCount());
+        }
+        prev = sum;
+    }
+    return prev;
+}
+
+}
@@ -0,0 +1,405 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <map>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "Grid.hpp"
+#include "MappedInput.hpp"
+#include "Profiling.hpp"
+
+namespace aoc2018::day13 {
+
+enum class Direction : int
+{
+    Left = 0,
+    Right,
+    Up,
+    Down,
+    NumOf
+};
+
+
+enum class Turn : int
+{
+    GoLeft = 0,
+    GoStraight,
+    GoRight,
+    NumOf
+};
+
+
+enum class Symbol : char
+{
+    TrackHorizontal = '-',
+    TrackVertical = '|',
+    CartLeft = '<',
+    CartRight = '>',
+    CartUp = '^',
+    CartDown = 'v',
+    CornerDown = '\\',
+    CornerUp = '/',
+    Intersection = '+',
+    Invalid = ' '
+};
+
+
+template<typename T>
+constexpr int toInt(T value)
+{
+    return static_cast<int>(value);
+}
+
+
+template<typename T>
+constexpr int toChar(T value)
+{
+    return static_cast<char>(value);
+}
+
+
+class Cart
+{
+public:
+    Cart(int x, int y, Direction direction) :
+        x(x),
+        y(y),
+        direction(direction),
+        isCrashed(false),
+        intersectionDecision(0)
+    {
+    }
+
+    Turn decideAtIntersection()
+    {
+        Turn decision = static_cast<Turn>(intersectionDecision);
+        makeNextIntersectionDecision();
+        return decision;
+    }
+
+    bool collidesWith(Cart& other) const
+    {
+        return x == other.x && y == other.y;
+    }
+
+    int x;
+    int y;
+    Direction direction;
+    bool isCrashed;
+
+
+private:
+    int intersectionDecision;
+
+    void makeNextIntersectionDecision()
+    {
+        intersectionDecision++;
+        if (intersectionDecision == toInt(Turn::NumOf))
+        {
+            intersectionDecision = 0;
+        }
+    }
+};
+
+
+class Carts : public std::vector<Cart>
+{
+public:
+    Carts()
+    {
+    }
+};
+
+
+// Sized to the input by MapReader::read, cells without track hold
+// Symbol::Invalid.
+using Rails = grid::Grid<char>;
+
+
+class Navigator
+{
+public:
+    std::array<std::map<char, Direction>, toInt(Direction::NumOf)> directions;
+
+    Navigator()
+    {
+        directions[toInt(Direction::Left)][toChar(Symbol::TrackHorizontal)]  = Direction::Left;
+        directions[toInt(Direction::Left)][toChar(Symbol::CornerDown)]       = Direction::Up;
+        directions[toInt(Direction::Left)][toChar(Symbol::CornerUp)]         = Direction::Down;
+
+        directions[toInt(Direction::Right)][toChar(Symbol::TrackHorizontal)] = Direction::Right;
+        directions[toInt(Direction::Right)][toChar(Symbol::CornerDown)]      = Direction::Down;
+        directions[toInt(Direction::Right)][toChar(Symbol::CornerUp)]        = Direction::Up;
+
+        directions[toInt(Direction::Up)][toChar(Symbol::TrackVertical)]      = Direction::Up;
+        directions[toInt(Direction::Up)][toChar(Symbol::CornerDown)]         = Direction::Left;
+        directions[toInt(Direction::Up)][toChar(Symbol::CornerUp)]           = Direction::Right;
+
+        directions[toInt(Direction::Down)][toChar(Symbol::TrackVertical)]    = Direction::Down;
+        directions[toInt(Direction::Down)][toChar(Symbol::CornerDown)]       = Direction::Right;
+        directions[toInt(Direction::Down)][toChar(Symbol::CornerUp)]         = Direction::Left;
+    }
+
+    void tick(Carts& carts, Carts& crashed, Rails& rails)
+    {
+        AOC_PROFILE_ZONE("day13::Navigator::tick");
+        for (auto it = carts.begin(); it != carts.end(); ++it)
+        {
+            Cart& cart = *it;
+            if (!cart.isCrashed)
+            {
+                chooseDirection(cart, rails);
+                move(cart);
+                markCrashes(it, carts);
+            }
+        }
+        storeCrashed(carts, crashed);
+    }
+
+private:
+    void move(Cart& cart) const
+    {
+        switch(cart.direction)
+        {
+            case Direction::Left:
+                cart.x--;
+                break;
+
+            case Direction::Right:
+                cart.x++;
+                break;
+
+            case Direction::Up:
+                cart.y--;
+                break;
+
+            case Direction::Down:
+                cart.y++;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void markCrashes(Carts::iterator it, Carts& carts)
+    {
+        for (auto ot = carts.begin(); ot != carts.end(); ++ot)
+        {
+            if (it != ot && !ot->isCrashed && it->collidesWith(*ot))
+            {
+                it->isCrashed = true;
+                ot->isCrashed = true;
+                return;
+            }
+        }
+    }
+
+    void chooseDirection(Cart& cart, Rails& rails)
+    {
+        char c = rails(cart.x, cart.y);
+        if (c != toChar(Symbol::Intersection))
+        {
+            assert(directions[toInt(cart.direction)].count(c) == 1);
+            cart.direction = directions[toInt(cart.direction)][c];
+        }
+        else
+        {
+            Turn decision = cart.decideAtIntersection();
+            if (decision == Turn::GoLeft)
+            {
+                cart.direction = turnLeft(cart.direction);
+            }
+            else if (decision == Turn::GoRight)
+            {
+                cart.direction = turnRight(cart.direction);
+            }
+        }
+    }
+
+    void storeCrashed(Carts& carts, Carts& crashed)
+    {
+        for (auto it = carts.begin(); it != carts.end();)
+        {
+            if (it->isCrashed)
+            {
+                crashed.push_back(*it);
+                it = carts.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    Direction turnLeft(Direction current) const
+    {
+        if (current == Direction::Right)
+        {
+            return Direction::Up;
+        }
+        else if (current == Direction::Down)
+        {
+            return Direction::Right;
+        }
+        else if (current == Direction::Up)
+        {
+            return Direction::Left;
+        }
+        return Direction::Down;
+    }
+
+    Direction turnRight(Direction current) const
+    {
+        if (current == Direction::Up)
+        {
+            return Direction::Right;
+        }
+        else if (current == Direction::Right)
+        {
+            return Direction::Down;
+        }
+        else if (current == Direction::Left)
+        {
+            return Direction::Up;
+        }
+        return Direction::Left;
+    }
+};
+
+
+class MapReader
+{
+public:
+    static void read(std::string_view input, Carts& carts, Rails& rails)
+    {
+        int width = 0;
+        int height = 0;
+        for (std::string_view line : puzzleInputs::Lines(input))
+        {
+            width = std::max(width, static_cast<int>(line.size()));
+            height++;
+        }
+        rails = Rails(width, height, toChar(Symbol::Invalid));
+
+        int x = 0;
+        int y = 0;
+        for (std::string_view line : puzzleInputs::Lines(input))
+        {
+            x = 0;
+            for (auto c : line)
+            {
+                if (isCart(c))
+                {
+                    Cart cart(x, y, getDirection(c));
+                    rails(x, y) = getRail(cart);
+                    carts.push_back(cart);
+                }
+                else
+                {
+                    rails(x, y) = c;
+                }
+                x++;
+            }
+            y++;
+        }
+    }
+
+private:
+    static char getRail(Cart cart)
+    {
+        switch(cart.direction)
+        {
+            case Direction::Left:
+            case Direction::Right:
+                return toChar(Symbol::TrackHorizontal);
+
+            default:
+                return toChar(Symbol::TrackVertical);
+        }
+    }
+
+    static bool isCart(char c)
+    {
+        switch(c)
+        {
+            case toChar(Symbol::CartLeft):
+            case toChar(Symbol::CartRight):
+            case toChar(Symbol::CartUp):
+            case toChar(Symbol::CartDown):
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    static Direction getDirection(char c)
+    {
+        switch(c)
+        {
+            case toChar(Symbol::CartLeft):
+                return Direction::Left;
+            case toChar(Symbol::CartRight):
+                return Direction::Right;
+            case toChar(Symbol::CartUp):
+                return Direction::Up;
+            default:
+                return Direction::Down;
+        }
+    }
+};
+
+
+struct Track
+{
+    Carts carts;
+    Rails rails;
+};
+
+
+inline Track readTrack(std::string_view input)
+{
+    Track track;
+    MapReader::read(input, track.carts, track.rails);
+    return track;
+}
+
+
+inline Cart findFirstCrash(Track track)
+{
+    Navigator navigator;
+    Carts crashed;
+    while (crashed.empty() && !track.carts.empty())
+    {
+        navigator.tick(track.carts, crashed, track.rails);
+    }
+    if (crashed.empty())
+    {
+        throw std::runtime_error("No carts crashed");
+    }
+    return crashed.front();
+}
+
+
+inline Cart findLastCart(Track track)
+{
+    Navigator navigator;
+    Carts crashed;
+    while (track.carts.size() > 1)
+    {
+        navigator.tick(track.carts, crashed, track.rails);
+    }
+    if (track.carts.empty())
+    {
+        throw std::runtime_error("No cart left");
+    }
+    return track.carts.front();
+}
+
+}
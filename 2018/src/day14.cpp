@@ -1,67 +1,14 @@
 #include <gtest/gtest.h>
 
-#include <vector>
-#include <string>
+#include "day14.hpp"
 
 namespace aoc2018::day14 {
 
-class Recipes
+TEST(Day14, findRecipesBefore)
 {
-public:
-    Recipes(size_t n) :
-        recipes({3, 7})
-    {
-        int xi = 0;
-        int yi = 1;
-        int x = recipes[xi];
-        int y = recipes[yi];
-
-        while (recipes.size() < n)
-        {
-            int result = x + y;
-            if (result > 9)
-            {
-                recipes.push_back(result / 10);
-                recipes.push_back(result % 10);
-            }
-            else
-            {
-                recipes.push_back(result);
-            }
-
-            xi = (xi + 1 + x) % recipes.size();
-            yi = (yi + 1 + y) % recipes.size();
-            x = recipes.at(xi);
-            y = recipes.at(yi);
-        }
-    }
-
-    std::string get(size_t from, size_t len = 10)
-    {
-        std::string scores;
-        for (size_t i = 0; i < len; ++i)
-        {
-            scores += std::to_string(recipes.at(i + from));
-        }
-        return scores;
-    }
-
-    int find(const std::vector<int> pattern)
-    {
-        auto it = std::search(recipes.begin(), recipes.end(), pattern.begin(), pattern.end());
-        if (it == recipes.end())
-        {
-            return -1;
-        }
-        else
-        {
-            return it - recipes.begin();
-        }
-    }
-
-private:
-    std::vector<int> recipes;
-};
+    EXPECT_EQ(9, findRecipesBefore(parseDigits("51589\n"), 16));
+    EXPECT_EQ(2018, findRecipesBefore(parseDigits("59414"), 16));
+}
 
 
 TEST(Day14, solution)
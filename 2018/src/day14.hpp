@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc2018::day14 {
+
+class Recipes
+{
+public:
+    Recipes(size_t n) :
+        recipes({3, 7})
+    {
+        int xi = 0;
+        int yi = 1;
+        int x = recipes[xi];
+        int y = recipes[yi];
+
+        while (recipes.size() < n)
+        {
+            int result = x + y;
+            if (result > 9)
+            {
+                recipes.push_back(result / 10);
+                recipes.push_back(result % 10);
+            }
+            else
+            {
+                recipes.push_back(result);
+            }
+
+            xi = (xi + 1 + x) % recipes.size();
+            yi = (yi + 1 + y) % recipes.size();
+            x = recipes.at(xi);
+            y = recipes.at(yi);
+        }
+    }
+
+    std::string get(size_t from, size_t len = 10) const
+    {
+        std::string scores;
+        for (size_t i = 0; i < len; ++i)
+        {
+            scores += std::to_string(recipes.at(i + from));
+        }
+        return scores;
+    }
+
+    int find(const std::vector<int> pattern) const
+    {
+        auto it = std::search(recipes.begin(), recipes.end(), pattern.begin(), pattern.end());
+        if (it == recipes.end())
+        {
+            return -1;
+        }
+        else
+        {
+            return it - recipes.begin();
+        }
+    }
+
+private:
+    std::vector<int> recipes;
+};
+
+
+// The puzzle input is a number, part 2 looks for its digits.
+inline std::vector<int> parseDigits(std::string_view input)
+{
+    std::vector<int> digits;
+    for (char c : input)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            digits.push_back(c - '0');
+        }
+    }
+    return digits;
+}
+
+
+// What both parts query: the scoreboard up to the ten recipes after the
+// puzzle input and the digits of the input
+struct Scoreboard
+{
+    size_t after;
+    Recipes recipes;
+    std::vector<int> digits;
+};
+
+
+// Number of recipes before the pattern shows up. The scoreboard is rebuilt
+// with twice the size until it contains the pattern.
+inline int findRecipesBefore(const std::vector<int>& pattern, size_t initialSize = 1 << 20)
+{
+    for (size_t n = initialSize; n < std::numeric_limits<int>::max(); n *= 2)
+    {
+        int position = Recipes(n).find(pattern);
+        if (position >= 0)
+        {
+            return position;
+        }
+    }
+    throw std::runtime_error("Pattern not found");
+}
+
+}
@@ -1,581 +1,13 @@
-#include <gtest/gtest.h>
-
-#include <vector>
-#include <limits>
-#include <queue>
-#include <memory>
-#include <stack>
-#include <fstream>
-#include <filesystem>
+#include <set>
+#include <string_view>
 
 #include <gtest/gtest.h>
 
 #include "PuzzleInputs.hpp"
+#include "day15.hpp"
 
 namespace aoc2018::day15 {
 
-
-class Point
-{
-public:
-    Point()
-    {
-        invalidate();
-    }
-
-    Point(int x, int y) :
-        x(x),
-        y(y)
-    {
-    }
-
-    virtual ~Point()
-    {
-    }
-
-    bool operator==(const Point& other) const
-    {
-        return x == other.x && y == other.y;
-    }
-
-    bool operator!=(const Point& other) const
-    {
-        return !(*this == other);
-    }
-
-    Point& operator=(const Point& other)
-    {
-        x = other.x;
-        y = other.y;
-        return *this;
-    }
-
-    void invalidate()
-    {
-        x = getInvalidValue();
-        y = getInvalidValue();
-    }
-
-    bool isValid() const
-    {
-        return x != getInvalidValue() && y != getInvalidValue();
-    }
-
-    static int getInvalidValue()
-    {
-        return std::numeric_limits<int>::max();
-    }
-
-    int x;
-    int y;
-};
-
-Point operator+(Point lhs, const Point& rhs)
-{
-    lhs.x += rhs.x;
-    lhs.y += rhs.y;
-    return lhs;
-}
-
-
-
-class Unit : public Point
-{
-public:
-    enum Type
-    {
-        Goblin = 0,
-        Elf,
-        Unknown
-    };
-
-    static constexpr int maxHP = 200;
-    static constexpr int normalDamage = 3;
-
-    Unit(Type type = Unit::Unknown, int x = 0, int y = 0) :
-        Point(x, y),
-        type(type),
-        hp(maxHP)
-    {
-    }
-
-    int getDamage() const
-    {
-        return damage[type];
-    }
-
-    static void setDamage(Type type, int d)
-    {
-        assert(type < Type::Unknown);
-        damage[type] = d;
-    }
-
-    bool operator<(const Unit& other) const
-    {
-        return y < other.y || (y == other.y && x < other.x);
-    }
-
-    bool isAlive() const
-    {
-        return hp > 0;
-    }
-
-    bool isDead() const
-    {
-        return !isAlive();
-    }
-
-    bool isFriend(const Unit& other) const
-    {
-        return type == other.type;
-    }
-
-    Type type;
-    int hp;
-
-private:
-    static int damage[];
-};
-
-int Unit::damage[] = { Unit::normalDamage, Unit::normalDamage };
-constexpr int Unit::maxHP;
-
-
-class Node : public Point
-{
-public:
-    enum Type
-    {
-        Floor,
-        Wall
-    };
-
-    Node(int x = 0, int y = 0) :
-        Point(x, y),
-        parent(),
-        unit(nullptr),
-        type(Floor),
-        visited(false)
-    {
-    }
-
-    Node(int x, int y, Type type, Unit* unit) :
-        Point(x, y),
-        parent(),
-        unit(unit),
-        type(type),
-        visited(false)
-    {
-    }
-
-    virtual ~Node()
-    {
-    }
-
-    bool hasUnit() const
-    {
-        return unit != nullptr;
-    }
-
-    Point parent;
-    Unit* unit;
-    Type type;
-    bool visited;
-};
-
-using UnitList = std::vector<Unit*>;
-using Route = std::stack<Point>;
-using Neighbors = std::array<Point, 4>;
-
-
-class Map
-{
-public:
-
-    Map(const std::string input)
-    {
-        std::stringstream ss(input);
-        read(ss);
-    }
-
-    Map(std::istream& input)
-    {
-        read(input);
-    }
-
-    Map(const Map& other)
-    {
-        nodes = other.nodes;
-        units = other.units;
-
-        for (size_t i = 0; i < MAX_NUM_OF_UNITS; ++i)
-        {
-            if (units[i].type != Unit::Unknown)
-            {
-                activeUnits.push_back(&units[i]);
-                getNode(units[i]).unit = &units[i];
-            }
-        }
-    }
-
-    UnitList& getUnits()
-    {
-        return activeUnits;
-    }
-
-    std::vector<Node>& operator[](size_t x)
-    {
-        return nodes.at(x);
-    }
-
-    bool moveToNearestEnemy(Unit* unit)
-    {
-        std::vector<Route> routes;
-        routes.reserve(activeUnits.size());
-
-        for (auto& enemy : activeUnits)
-        {
-            if (!enemy->isDead() && !unit->isFriend(*enemy))
-            {
-                routes.emplace_back(calculateRouteToEnemy(unit, *enemy));
-            }
-        }
-
-        if (routes.size() > 0)
-        {
-            auto shortest = selectShortestRoute(routes);
-            if (shortest != routes.end())
-            {
-                moveUnit(unit, shortest->top());
-            }
-            return true;
-        }
-        return false;  // no enemies left, game over
-    }
-
-    Unit* findEnemyInRange(const Unit& unit) const
-    {
-        Unit* chosen = nullptr;
-        for (auto& neighbor : getNeighbors(unit))
-        {
-            if (isFloor(neighbor) &&
-                hasUnit(neighbor) &&
-                getNode(neighbor).unit->isFriend(unit) == false &&
-                getNode(neighbor).unit->isAlive())
-            {
-                if (!chosen || (chosen && chosen->hp > getNode(neighbor).unit->hp))
-                {
-                    chosen = getNode(neighbor).unit;
-                }
-            }
-        }
-        return chosen;
-    }
-
-    const Node& getNode(const Point& p) const
-    {
-        return nodes[p.x][p.y];
-    }
-
-    Node& getNode(const Point& p)
-    {
-        return nodes[p.x][p.y];
-    }
-
-
-private:
-    void read(std::istream& input)
-    {
-        std::string line;
-        int y = 0;
-        while (std::getline(input, line))
-        {
-            if (nodes.size() == 0)
-            {
-                nodes.resize(line.length());
-            }
-            else if (nodes.size() != line.length())
-            {
-                throw std::runtime_error("Invalid Map");
-            }
-
-            int x = 0;
-            for (auto c : line)
-            {
-                Unit* unit = nullptr;
-                Node::Type type = Node::Floor;
-
-                if (isGoblin(c))
-                {
-                    unit = createUnit(Unit::Goblin, x, y);
-                }
-                else if (isElf(c))
-                {
-                    unit = createUnit(Unit::Elf, x, y);
-                }
-                else if (isWall(c))
-                {
-                    type = Node::Wall;
-                }
-                nodes[x].emplace_back(x, y, type, unit);
-                x++;
-            }
-            y++;
-        }
-    }
-
-    bool isFloor(const Point& p ) const
-    {
-        return p.x >= 0 && p.y >= 0 &&
-            p.x < static_cast<int>(nodes.size()) &&
-            p.y < static_cast<int>(nodes[p.x].size()) &&
-            getNode(p).type == Node::Floor;
-    }
-
-    bool hasUnit(const Point& p) const
-    {
-        return getNode(p).unit != nullptr;
-    }
-
-    bool isWalkable(const Point& p) const
-    {
-        return isFloor(p) && !hasUnit(p);
-    }
-
-    const Neighbors& getNeighbors(const Point& point) const
-    {
-        static const Neighbors offsets = {
-            Point( 0, -1),
-            Point(-1,  0),
-            Point( 1,  0),
-            Point( 0,  1)
-        };
-
-        static Neighbors neighbors;
-        for (size_t i = 0; i < offsets.size(); ++i)
-        {
-            neighbors[i] = point + offsets[i];
-        }
-        return neighbors;
-    }
-
-    std::vector<Route>::iterator selectShortestRoute(std::vector<Route>& routes)
-    {
-        auto shortest = routes.end();
-        for (auto r = routes.begin(); r != routes.end(); ++r)
-        {
-            if (r->size() == 0)  // Already in range of an enemy
-            {
-                continue;
-            }
-
-            if (shortest == routes.end() ||
-                (shortest != routes.end() && r->size() < shortest->size()))
-            {
-                shortest = r;
-            }
-        }
-        return shortest;
-    }
-
-    void moveUnit(Unit* unit, const Point& to)
-    {
-        getNode(to).unit = unit;
-        getNode(*unit).unit = nullptr;
-        unit->x = to.x;
-        unit->y = to.y;
-    }
-
-    Route calculateRouteToEnemy(Unit* unit, const Point& target)
-    {
-        for (auto& v : nodes)
-        {
-            for (auto& n : v)
-            {
-                n.visited = false;
-            }
-        }
-
-        Route route;
-        std::queue<Node> heads;
-        heads.push(nodes[unit->x][unit->y]);
-        while (!heads.empty())
-        {
-            Node current = heads.front();
-            heads.pop();
-            if (current == getNode(target))
-            {
-                return buildRoute(target, *unit);
-            }
-            const auto& neighbors = getNeighbors(current);
-            for (const auto& nb : neighbors)
-            {
-                if (!isFloor(nb))
-                {
-                    continue;
-                }
-                Node& neighbor = getNode(nb);
-                if (neighbor.hasUnit() && unit->isFriend(*neighbor.unit))
-                {
-                    continue;
-                }
-                if (!neighbor.visited)
-                {
-                    neighbor.visited = true;
-                    neighbor.parent = current;
-                    heads.push(neighbor);
-                }
-            }
-        }
-        return route;
-    }
-
-    Route buildRoute(const Point& from, const Point& to) const
-    {
-        Route route;
-        const Node* next = &getNode(from);
-        while(next->parent.isValid() && next->parent != to)
-        {
-            route.push(getNode(next->parent));
-            next = &getNode(next->parent);
-        }
-        return route;
-    }
-
-    bool isGoblin(char c)
-    {
-        return c == 'G';
-    }
-
-    bool isElf(char c)
-    {
-        return c == 'E';
-    }
-
-    bool isWall(char c)
-    {
-        return c == '#';
-    }
-
-    Unit* createUnit(Unit::Type type, int x, int y)
-    {
-        assert(activeUnits.size() < MAX_NUM_OF_UNITS);
-        Unit* unit = &units[activeUnits.size()];
-        unit->type = type;
-        unit->x = x;
-        unit->y = y;
-        activeUnits.push_back(unit);
-        return unit;
-    }
-
-    std::vector<std::vector<Node>> nodes;
-    UnitList activeUnits;
-    static constexpr unsigned int MAX_NUM_OF_UNITS = 32;
-    std::array<Unit, MAX_NUM_OF_UNITS> units;
-};
-
-
-class Game
-{
-public:
-    Game(Map& map) :
-        map(map),
-        round(0),
-        gameOver(false)
-    {
-    }
-
-    void run()
-    {
-        while(tick());
-    }
-
-    bool tick()
-    {
-        auto& units = map.getUnits();
-        sortUnitsByPosition(units);
-
-        for (auto& unit : units)
-        {
-            turn(unit);
-        }
-        if (!gameOver)
-        {
-            round++;
-        }
-        return !gameOver;
-    }
-
-    long int getOutcome() const
-    {
-        long int hp = 0;
-        for (const auto& unit : map.getUnits())
-        {
-            if (unit->isAlive())
-            {
-                hp += unit->hp;
-            }
-        }
-        return round * hp;
-    }
-
-
-private:
-    Map& map;
-    int round;
-    bool gameOver;
-
-    void sortUnitsByPosition(UnitList& units) const
-    {
-        std::sort(units.begin(), units.end(),
-            [](const Unit* lhs, const Unit* rhs) {
-                return *lhs < *rhs;
-                });
-    }
-
-    void attack(Unit& unit, Unit& enemy)
-    {
-        enemy.hp -= unit.getDamage();
-        if (enemy.isDead())
-        {
-            map.getNode(enemy).unit = nullptr;
-        }
-    }
-
-    bool attackIfEnemyInRange(Unit& unit)
-    {
-        Unit* enemy = map.findEnemyInRange(unit);
-        if (enemy)
-        {
-            attack(unit, *enemy);
-            return true;
-        }
-        return false;
-    }
-
-    void turn(Unit* unit)
-    {
-        if (unit->isDead())
-        {
-            return;
-        }
-        if (attackIfEnemyInRange(*unit))
-        {
-            return;
-        }
-        if(map.moveToNearestEnemy(unit))
-        {
-            attackIfEnemyInRange(*unit);
-        }
-        else
-        {
-            gameOver = true;
-        }
-    }
-};
-
-
-
 TEST(Day15, mapParsing)
 {
     Map map(
@@ -584,32 +16,32 @@ TEST(Day15, mapParsing)
         "#..E#\n"
         "#####\n");
 
-    EXPECT_EQ(0, map[0][0].x);
-    EXPECT_EQ(0, map[0][0].y);
-    EXPECT_EQ(Node::Wall, map[0][0].type);
-    EXPECT_EQ(nullptr, map[0][0].unit);
-
-    EXPECT_EQ(1, map[1][0].x);
-    EXPECT_EQ(0, map[0][0].y);
-    EXPECT_EQ(Node::Wall, map[1][0].type);
-    EXPECT_EQ(nullptr, map[1][0].unit);
-
-    EXPECT_EQ(1, map[1][1].x);
-    EXPECT_EQ(1, map[1][1].y);
-    EXPECT_EQ(Node::Floor, map[1][1].type);
-    ASSERT_NE(nullptr, map[1][1].unit);
-    EXPECT_EQ(Unit::Goblin, map[1][1].unit->type);
-
-    EXPECT_EQ(1, map[1][2].x);
-    EXPECT_EQ(2, map[1][2].y);
-    EXPECT_EQ(Node::Floor, map[1][2].type);
-    EXPECT_EQ(nullptr, map[1][2].unit);
-
-    EXPECT_EQ(3, map[3][2].x);
-    EXPECT_EQ(2, map[3][2].y);
-    EXPECT_EQ(Node::Floor, map[3][2].type);
-    ASSERT_NE(nullptr, map[3][2].unit);
-    EXPECT_EQ(Unit::Elf, map[3][2].unit->type);
+    EXPECT_EQ(0, map(0, 0).x);
+    EXPECT_EQ(0, map(0, 0).y);
+    EXPECT_EQ(Node::Wall, map(0, 0).type);
+    EXPECT_EQ(nullptr, map(0, 0).unit);
+
+    EXPECT_EQ(1, map(1, 0).x);
+    EXPECT_EQ(0, map(0, 0).y);
+    EXPECT_EQ(Node::Wall, map(1, 0).type);
+    EXPECT_EQ(nullptr, map(1, 0).unit);
+
+    EXPECT_EQ(1, map(1, 1).x);
+    EXPECT_EQ(1, map(1, 1).y);
+    EXPECT_EQ(Node::Floor, map(1, 1).type);
+    ASSERT_NE(nullptr, map(1, 1).unit);
+    EXPECT_EQ(Unit::Goblin, map(1, 1).unit->type);
+
+    EXPECT_EQ(1, map(1, 2).x);
+    EXPECT_EQ(2, map(1, 2).y);
+    EXPECT_EQ(Node::Floor, map(1, 2).type);
+    EXPECT_EQ(nullptr, map(1, 2).unit);
+
+    EXPECT_EQ(3, map(3, 2).x);
+    EXPECT_EQ(2, map(3, 2).y);
+    EXPECT_EQ(Node::Floor, map(3, 2).type);
+    ASSERT_NE(nullptr, map(3, 2).unit);
+    EXPECT_EQ(Unit::Elf, map(3, 2).unit->type);
 }
 
 TEST(Day15, unitsAttackEnemiesInRange)
@@ -939,11 +371,54 @@ TEST(Day15, example2)
     EXPECT_EQ(36334, game.getOutcome());
 }
 
+TEST(Day15, withoutElfLosses)
+{
+    // The elves need an attack power of 15 and 4
+    EXPECT_EQ(4988, getOutcomeWithoutElfLosses(Map(
+        "#######\n"
+        "#.G...#\n"
+        "#...EG#\n"
+        "#.#.#G#\n"
+        "#..G#E#\n"
+        "#.....#\n"
+        "#######\n")));
+    EXPECT_EQ(31284, getOutcomeWithoutElfLosses(Map(
+        "#######\n"
+        "#E..EG#\n"
+        "#.#G.E#\n"
+        "#E.##E#\n"
+        "#G..#.#\n"
+        "#..E#.#\n"
+        "#######\n")));
+}
+
+TEST(Day15, damageIsPerMap)
+{
+    Map scenario(
+        "#######\n"
+        "#.....#\n"
+        "#.GE..#\n"
+        "#.E...#\n"
+        "#######\n");
+    Map stronger(scenario);
+    stronger.setDamage(Unit::Elf, 20);
+    for (size_t i = 0; i < scenario.getUnits().size(); ++i)
+    {
+        const Unit& unit = *scenario.getUnits()[i];
+        const Unit& copy = *stronger.getUnits()[i];
+        EXPECT_EQ(Unit::normalDamage, unit.getDamage());
+        EXPECT_EQ(unit.type == Unit::Elf ? 20 : Unit::normalDamage, copy.getDamage());
+    }
+
+    Game game(stronger);
+    EXPECT_TRUE(game.tick());
+    EXPECT_EQ(Unit::maxHP - 40, stronger.getUnits()[0]->hp);
+}
+
 TEST(Day15, part1Solution)
 {
-    std::ifstream input(puzzleInputs::getInputDirectory() / "day15_input.txt");
-    EXPECT_TRUE(input.is_open());
-    Map map(input);
+    auto input = puzzleInputs::openInput("day15_input.txt");
+    Map map(input.view());
     Game game(map);
     game.run();
     EXPECT_EQ(263327, game.getOutcome());
@@ -952,34 +427,8 @@ TEST(Day15, part1Solution)
 
 TEST(Day15, part2Solution)
 {
-    auto didElvesWin = [](const UnitList& units) {
-        for (const auto& unit : units)
-        {
-            if (unit->type == Unit::Elf && unit->isDead())
-            {
-                return false;
-            }
-        }
-        return true;
-    };
-
-    int elfDamage = Unit::normalDamage + 1;
-    std::ifstream input(puzzleInputs::getInputDirectory() / "day15_input.txt");
-    EXPECT_TRUE(input.is_open());
-    Map scenario(input);
-
-    while (true)
-    {
-        Map map(scenario);
-        Game game(map);
-        game.run();
-        if (didElvesWin(map.getUnits()))
-        {
-            EXPECT_EQ(77872, game.getOutcome());
-            break;
-        }
-        Unit::setDamage(Unit::Elf, ++elfDamage);
-    }
+    auto input = puzzleInputs::openInput("day15_input.txt");
+    EXPECT_EQ(77872, getOutcomeWithoutElfLosses(Map(input.view())));
 }
 
 }
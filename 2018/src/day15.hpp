@@ -0,0 +1,591 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "Arena.hpp"
+#include "BreadthFirstSearch.hpp"
+#include "Grid.hpp"
+#include "MappedInput.hpp"
+#include "Parallel.hpp"
+#include "Profiling.hpp"
+
+namespace aoc2018::day15 {
+
+class Point
+{
+public:
+    Point()
+    {
+        invalidate();
+    }
+
+    Point(int x, int y) :
+        x(x),
+        y(y)
+    {
+    }
+
+    virtual ~Point()
+    {
+    }
+
+    bool operator==(const Point& other) const
+    {
+        return x == other.x && y == other.y;
+    }
+
+    bool operator!=(const Point& other) const
+    {
+        return !(*this == other);
+    }
+
+    Point& operator=(const Point& other)
+    {
+        x = other.x;
+        y = other.y;
+        return *this;
+    }
+
+    void invalidate()
+    {
+        x = getInvalidValue();
+        y = getInvalidValue();
+    }
+
+    bool isValid() const
+    {
+        return x != getInvalidValue() && y != getInvalidValue();
+    }
+
+    static int getInvalidValue()
+    {
+        return std::numeric_limits<int>::max();
+    }
+
+    int x;
+    int y;
+};
+
+inline Point operator+(Point lhs, const Point& rhs)
+{
+    lhs.x += rhs.x;
+    lhs.y += rhs.y;
+    return lhs;
+}
+
+
+
+class Unit : public Point
+{
+public:
+    enum Type
+    {
+        Goblin = 0,
+        Elf,
+        Unknown
+    };
+
+    static constexpr int maxHP = 200;
+    static constexpr int normalDamage = 3;
+
+    Unit(Type type = Unit::Unknown, int x = 0, int y = 0) :
+        Point(x, y),
+        type(type),
+        hp(maxHP),
+        damage(normalDamage)
+    {
+    }
+
+    int getDamage() const
+    {
+        return damage;
+    }
+
+    bool operator<(const Unit& other) const
+    {
+        return y < other.y || (y == other.y && x < other.x);
+    }
+
+    bool isAlive() const
+    {
+        return hp > 0;
+    }
+
+    bool isDead() const
+    {
+        return !isAlive();
+    }
+
+    bool isFriend(const Unit& other) const
+    {
+        return type == other.type;
+    }
+
+    Type type;
+    int hp;
+    // Attack power
+    int damage;
+};
+
+
+class Node : public Point
+{
+public:
+    enum Type
+    {
+        Floor,
+        Wall
+    };
+
+    Node(int x = 0, int y = 0) :
+        Point(x, y),
+        unit(nullptr),
+        type(Floor)
+    {
+    }
+
+    Node(int x, int y, Type type, Unit* unit) :
+        Point(x, y),
+        unit(unit),
+        type(type)
+    {
+    }
+
+    virtual ~Node()
+    {
+    }
+
+    bool hasUnit() const
+    {
+        return unit != nullptr;
+    }
+
+    Unit* unit;
+    Type type;
+};
+
+using UnitList = std::vector<Unit*>;
+using Neighbors = std::array<Point, 4>;
+
+
+class Map
+{
+public:
+
+    Map(std::string_view input)
+    {
+        read(input);
+        search = grid::BreadthFirstSearch(nodes);
+    }
+
+    // The copy allocates from the current resource like the grid, see
+    // grid::Grid
+    Map(const Map& other) :
+        nodes(other.nodes),
+        search(other.search),
+        units(other.units)
+    {
+        for (size_t i = 0; i < MAX_NUM_OF_UNITS; ++i)
+        {
+            if (units[i].type != Unit::Unknown)
+            {
+                activeUnits.push_back(&units[i]);
+                getNode(units[i]).unit = &units[i];
+            }
+        }
+    }
+
+    UnitList& getUnits()
+    {
+        return activeUnits;
+    }
+
+    void setDamage(Unit::Type type, int damage)
+    {
+        for (auto& unit : activeUnits)
+        {
+            if (unit->type == type)
+            {
+                unit->damage = damage;
+            }
+        }
+    }
+
+    Node& operator()(int x, int y)
+    {
+        return nodes.at(x, y);
+    }
+
+    // One search from the unit gives the routes to all enemies. The unit
+    // heads for the closest enemy it is not already next to, the first one
+    // in the list of units on ties.
+    bool moveToNearestEnemy(Unit* unit)
+    {
+        calculateRoutes(*unit);
+
+        bool enemiesLeft = false;
+        size_t nearest = grid::BreadthFirstSearch::none;
+        for (auto& enemy : activeUnits)
+        {
+            if (!enemy->isDead() && !unit->isFriend(*enemy))
+            {
+                enemiesLeft = true;
+                size_t target = nodes.getIndex(enemy->x, enemy->y);
+                int distance = search.getDistance(target);
+                if (distance > 1 &&
+                    (nearest == grid::BreadthFirstSearch::none || distance < search.getDistance(nearest)))
+                {
+                    nearest = target;
+                }
+            }
+        }
+
+        if (nearest != grid::BreadthFirstSearch::none)
+        {
+            grid::Position step = nodes.getPosition(search.getFirstStep(nearest));
+            moveUnit(unit, Point(step.x, step.y));
+        }
+        return enemiesLeft;  // game over when there are none
+    }
+
+    Unit* findEnemyInRange(const Unit& unit) const
+    {
+        Unit* chosen = nullptr;
+        for (auto& neighbor : getNeighbors(unit))
+        {
+            if (isFloor(neighbor) &&
+                hasUnit(neighbor) &&
+                getNode(neighbor).unit->isFriend(unit) == false &&
+                getNode(neighbor).unit->isAlive())
+            {
+                if (!chosen || (chosen && chosen->hp > getNode(neighbor).unit->hp))
+                {
+                    chosen = getNode(neighbor).unit;
+                }
+            }
+        }
+        return chosen;
+    }
+
+    const Node& getNode(const Point& p) const
+    {
+        return nodes(p.x, p.y);
+    }
+
+    Node& getNode(const Point& p)
+    {
+        return nodes(p.x, p.y);
+    }
+
+
+private:
+    // The map is surrounded by a border of walls, so the neighbors of every
+    // position on the map can be looked at without bounds checks.
+    void read(std::string_view input)
+    {
+        puzzleInputs::Lines lines(input);
+        int width = lines.begin() != lines.end() ? (*lines.begin()).length() : 0;
+        int height = 0;
+        for (std::string_view line : lines)
+        {
+            if (static_cast<int>(line.length()) != width)
+            {
+                throw std::runtime_error("Invalid Map");
+            }
+            height++;
+        }
+        nodes = grid::Grid<Node>(width, height, Node(), 1, Node(0, 0, Node::Wall, nullptr));
+
+        int y = 0;
+        for (std::string_view line : lines)
+        {
+            int x = 0;
+            for (auto c : line)
+            {
+                Unit* unit = nullptr;
+                Node::Type type = Node::Floor;
+
+                if (isGoblin(c))
+                {
+                    unit = createUnit(Unit::Goblin, x, y);
+                }
+                else if (isElf(c))
+                {
+                    unit = createUnit(Unit::Elf, x, y);
+                }
+                else if (isWall(c))
+                {
+                    type = Node::Wall;
+                }
+                nodes(x, y) = Node(x, y, type, unit);
+                x++;
+            }
+            y++;
+        }
+    }
+
+    bool isFloor(const Point& p ) const
+    {
+        return getNode(p).type == Node::Floor;
+    }
+
+    bool hasUnit(const Point& p) const
+    {
+        return getNode(p).unit != nullptr;
+    }
+
+    bool isWalkable(const Point& p) const
+    {
+        return isFloor(p) && !hasUnit(p);
+    }
+
+    Neighbors getNeighbors(const Point& point) const
+    {
+        static const Neighbors offsets = {
+            Point( 0, -1),
+            Point(-1,  0),
+            Point( 1,  0),
+            Point( 0,  1)
+        };
+
+        Neighbors neighbors;
+        for (size_t i = 0; i < offsets.size(); ++i)
+        {
+            neighbors[i] = point + offsets[i];
+        }
+        return neighbors;
+    }
+
+    void moveUnit(Unit* unit, const Point& to)
+    {
+        getNode(to).unit = unit;
+        getNode(*unit).unit = nullptr;
+        unit->x = to.x;
+        unit->y = to.y;
+    }
+
+    // Units block the way except for enemies, routes may lead through them
+    void calculateRoutes(const Unit& unit)
+    {
+        AOC_PROFILE_ZONE("day15::Map::calculateRoutes");
+        search.run(nodes.getIndex(unit.x, unit.y), [this, &unit](size_t index) {
+            const Node& node = nodes[index];
+            return node.type == Node::Floor && !(node.hasUnit() && unit.isFriend(*node.unit));
+        });
+    }
+
+    bool isGoblin(char c)
+    {
+        return c == 'G';
+    }
+
+    bool isElf(char c)
+    {
+        return c == 'E';
+    }
+
+    bool isWall(char c)
+    {
+        return c == '#';
+    }
+
+    Unit* createUnit(Unit::Type type, int x, int y)
+    {
+        assert(activeUnits.size() < MAX_NUM_OF_UNITS);
+        Unit* unit = &units[activeUnits.size()];
+        unit->type = type;
+        unit->x = x;
+        unit->y = y;
+        activeUnits.push_back(unit);
+        return unit;
+    }
+
+    grid::Grid<Node> nodes;
+    grid::BreadthFirstSearch search;
+    UnitList activeUnits;
+    static constexpr unsigned int MAX_NUM_OF_UNITS = 32;
+    std::array<Unit, MAX_NUM_OF_UNITS> units;
+};
+
+
+class Game
+{
+public:
+    Game(Map& map) :
+        map(map),
+        round(0),
+        gameOver(false)
+    {
+    }
+
+    void run()
+    {
+        while(tick());
+    }
+
+    bool tick()
+    {
+        auto& units = map.getUnits();
+        sortUnitsByPosition(units);
+
+        for (auto& unit : units)
+        {
+            turn(unit);
+        }
+        if (!gameOver)
+        {
+            round++;
+        }
+        return !gameOver;
+    }
+
+    long int getOutcome() const
+    {
+        long int hp = 0;
+        for (const auto& unit : map.getUnits())
+        {
+            if (unit->isAlive())
+            {
+                hp += unit->hp;
+            }
+        }
+        return round * hp;
+    }
+
+
+private:
+    Map& map;
+    int round;
+    bool gameOver;
+
+    void sortUnitsByPosition(UnitList& units) const
+    {
+        std::sort(units.begin(), units.end(),
+            [](const Unit* lhs, const Unit* rhs) {
+                return *lhs < *rhs;
+                });
+    }
+
+    void attack(Unit& unit, Unit& enemy)
+    {
+        enemy.hp -= unit.getDamage();
+        if (enemy.isDead())
+        {
+            map.getNode(enemy).unit = nullptr;
+        }
+    }
+
+    bool attackIfEnemyInRange(Unit& unit)
+    {
+        Unit* enemy = map.findEnemyInRange(unit);
+        if (enemy)
+        {
+            attack(unit, *enemy);
+            return true;
+        }
+        return false;
+    }
+
+    void turn(Unit* unit)
+    {
+        if (unit->isDead())
+        {
+            return;
+        }
+        if (attackIfEnemyInRange(*unit))
+        {
+            return;
+        }
+        if(map.moveToNearestEnemy(unit))
+        {
+            attackIfEnemyInRange(*unit);
+        }
+        else
+        {
+            gameOver = true;
+        }
+    }
+};
+
+
+inline long int getOutcome(const Map& scenario)
+{
+    Map map(scenario);
+    Game game(map);
+    game.run();
+    return game.getOutcome();
+}
+
+
+// Raises the elves' attack power until all of them survive and returns the
+// outcome of that battle. Battles with consecutive attack powers are fought
+// in parallel, a few at a time; the weakest winning power of the first
+// batch with a win is the answer, as if they were fought one by one. A
+// battle stops as soon as an elf dies or a weaker power has won.
+inline long int getOutcomeWithoutElfLosses(const Map& scenario)
+{
+    constexpr int maxBatchSize = 8;
+
+    auto didElvesWin = [](const UnitList& units) {
+        for (const auto& unit : units)
+        {
+            if (unit->type == Unit::Elf && unit->isDead())
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::atomic<int> weakestWin{std::numeric_limits<int>::max()};
+    // Each battle allocates from an arena of its own, which is gone once it
+    // is over, so the maps of the battles do not pile up in the arena of
+    // the part.
+    auto fight = [&](int elfDamage) -> std::optional<long int> {
+        allocations::Arena arena;
+        allocations::ResourceScope scope(arena);
+        Map map(scenario);
+        map.setDamage(Unit::Elf, elfDamage);
+        Game game(map);
+        bool over = false;
+        while (!over && didElvesWin(map.getUnits()) && elfDamage < weakestWin)
+        {
+            over = !game.tick();
+        }
+        if (!over || !didElvesWin(map.getUnits()))
+        {
+            return std::nullopt;
+        }
+        int weakest = weakestWin;
+        while (elfDamage < weakest && !weakestWin.compare_exchange_weak(weakest, elfDamage))
+        {
+        }
+        return game.getOutcome();
+    };
+
+    const int batchSize = std::min(static_cast<int>(parallel::getNumOfThreads()), maxBatchSize);
+    for (int elfDamage = Unit::normalDamage + 1; ; elfDamage += batchSize)
+    {
+        std::vector<std::optional<long int>> outcomes(batchSize);
+        parallel::parallelFor(0, batchSize, [&](size_t i) {
+            outcomes[i] = fight(elfDamage + i);
+        });
+        for (const auto& outcome : outcomes)
+        {
+            if (outcome)
+            {
+                return *outcome;
+            }
+        }
+    }
+}
+
+}
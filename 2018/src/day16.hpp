@@ -0,0 +1,586 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Arena.hpp"
+#include "MappedInput.hpp"
+#include "Scanner.hpp"
+
+namespace aoc2018::day16 {
+
+enum class OpCode : int
+{
+    // (add register) stores into register C the result of adding register A and register B
+    addr = 0,
+
+    // addi (add immediate) stores into register C the result of adding register A and value B
+    addi,
+
+    // (multiply register) stores into register C the result of multiplying register A and register B
+    mulr,
+
+    // (multiply immediate) stores into register C the result of multiplying register A and value B
+    muli,
+
+    // banr (bitwise AND register) stores into register C the result of the bitwise AND of register A and register B
+    banr,
+
+    // bani (bitwise AND immediate) stores into register C the result of the bitwise AND of register A and value B
+    bani,
+
+    // borr (bitwise OR register) stores into register C the result of the bitwise OR of register A and register B
+    borr,
+
+    // bori (bitwise OR immediate) stores into register C the result of the bitwise OR of register A and value B
+    bori,
+
+    // setr (set register) copies the contents of register A into register C. (Input B is ignored.)
+    setr,
+
+    // seti (set immediate) stores value A into register C. (Input B is ignored.)
+    seti,
+
+    // gtir (greater-than immediate/register) sets register C to 1 if value A is greater than register B.
+    // Otherwise, register C is set to 0.
+    gtir,
+
+    // gtri (greater-than register/immediate) sets register C to 1 if register A is greater than value B. Otherwise,
+    // register C is set to 0.
+    gtri,
+
+    // gtrr (greater-than register/register) sets register C to 1 if register A is greater than register B. Otherwise,
+    // register C is set to 0.
+    gtrr,
+
+    // eqir (equal immediate/register) sets register C to 1 if value A is equal to register B. Otherwise, register
+    // C is set to 0.
+    eqir,
+
+    // eqri (equal register/immediate) sets register C to 1 if register A is equal to value B. Otherwise, register
+    // C is set to 0.
+    eqri,
+
+    // eqrr (equal register/register) sets register C to 1 if register A is equal to register B. Otherwise, register
+    // C is set to 0.
+    eqrr,
+
+    nop
+};
+
+
+constexpr int getNumOfOpCodes()
+{
+    return static_cast<int>(OpCode::nop);
+}
+
+using Registers = std::array<int, 4>;
+using Instruction = std::array<int, 4>;
+
+
+class Machine
+{
+public:
+    Registers registers;
+
+    Machine() :
+        registers({0, 0, 0, 0})
+    {
+    }
+
+    void run(OpCode opcode, int a, int b, int output)
+    {
+        switch(opcode)
+        {
+            case OpCode::addr:
+                addr(a, b, output);
+                break;
+            case OpCode::addi:
+                addi(a, b, output);
+                break;
+            case OpCode::mulr:
+                mulr(a, b, output);
+                break;
+            case OpCode::muli:
+                muli(a, b, output);
+                break;
+            case OpCode::banr:
+                banr(a, b, output);
+                break;
+            case OpCode::bani:
+                bani(a, b, output);
+                break;
+            case OpCode::borr:
+                borr(a, b, output);
+                break;
+            case OpCode::bori:
+                bori(a, b, output);
+                break;
+            case OpCode::setr:
+                setr(a, b, output);
+                break;
+            case OpCode::seti:
+                seti(a, b, output);
+                break;
+            case OpCode::gtir:
+                gtir(a, b, output);
+                break;
+            case OpCode::gtri:
+                gtri(a, b, output);
+                break;
+            case OpCode::gtrr:
+                gtrr(a, b, output);
+                break;
+            case OpCode::eqir:
+                eqir(a, b, output);
+                break;
+            case OpCode::eqri:
+                eqri(a, b, output);
+                break;
+            case OpCode::eqrr:
+                eqrr(a, b, output);
+                break;
+            default:
+                break;
+        }
+    }
+
+
+private:
+    void addr(int a, int b, int output)
+    {
+        registers[output] = registers[a] + registers[b];
+    }
+
+    void addi(int a, int b, int output)
+    {
+        registers[output] = registers[a] + b;
+    }
+
+    void mulr(int a, int b, int output)
+    {
+        registers[output] = registers[a] * registers[b];
+    }
+
+    void muli(int a, int b, int output)
+    {
+        registers[output] = registers[a] * b;
+    }
+
+    void banr(int a, int b, int output)
+    {
+        registers[output] = registers[a] & registers[b];
+    }
+
+    void bani(int a, int b, int output)
+    {
+        registers[output] = registers[a] & b;
+    }
+
+    void borr(int a, int b, int output)
+    {
+        registers[output] = registers[a] | registers[b];
+    }
+
+    void bori(int a, int b, int output)
+    {
+        registers[output] = registers[a] | b;
+    }
+
+    void setr(int a, int, int output)
+    {
+        registers[output] = registers[a];
+    }
+
+    void seti(int a, int, int output)
+    {
+        registers[output] = a;
+    }
+
+    void gtir(int a, int b, int output)
+    {
+        registers[output] = a > registers[b] ? 1 : 0;
+    }
+
+    void gtri(int a, int b, int output)
+    {
+        registers[output] = registers[a] > b ? 1 : 0;
+    }
+
+    void gtrr(int a, int b, int output)
+    {
+        registers[output] = registers[a] > registers[b] ? 1 : 0;
+    }
+
+    void eqir(int a, int b, int output)
+    {
+        registers[output] = a == registers[b] ? 1 : 0;
+    }
+
+    void eqri(int a, int b, int output)
+    {
+        registers[output] = registers[a] == b ? 1 : 0;
+    }
+
+    void eqrr(int a, int b, int output)
+    {
+        registers[output] = registers[a] == registers[b] ? 1 : 0;
+    }
+};
+
+
+class Sample
+{
+public:
+    Sample()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        registersBefore.fill(0);
+        instruction.fill(0);
+        registersAfter.fill(0);
+    }
+
+    Registers registersBefore;
+    Instruction instruction;
+    Registers registersAfter;
+};
+
+
+constexpr Instruction parseInstruction(std::string_view line)
+{
+    scanner::Scanner s(line);
+    Instruction instruction;
+    for (auto& inst : instruction)
+    {
+        inst = s.integer<int>();
+    }
+    return instruction;
+}
+
+
+class SampleBuilder
+{
+public:
+    enum class SampleParts
+    {
+        initialRegisters,
+        instruction,
+        finalRegisters
+    };
+
+    SampleBuilder()
+    {
+        reset();
+    }
+
+    void add(std::string_view line)
+    {
+        switch(state)
+        {
+            case SampleParts::initialRegisters:
+                readInitialRegisters(line);
+                break;
+
+            case SampleParts::instruction:
+                readInstruction(line);
+                break;
+
+            case SampleParts::finalRegisters:
+                readFinalRegisters(line);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    bool isReady() const
+    {
+        return ready;
+    }
+
+    Sample getCurrent() const
+    {
+        return current;
+    }
+
+
+private:
+    bool ready;
+    SampleParts state;
+    Sample current;
+
+    void reset()
+    {
+        state = SampleParts::initialRegisters;
+        ready = false;
+        current.reset();
+    }
+
+    void parseRegisters(std::string_view line, Registers& to)
+    {
+        scanner::Scanner s(line.substr(line.find('[')));
+        s.expect('[');
+        for (auto& reg : to)
+        {
+            s.skip(',');
+            reg = s.integer<int>();
+        }
+        s.expect(']');
+    }
+
+    void readInitialRegisters(std::string_view line)
+    {
+        if (line.rfind("Before:") == 0)
+        {
+            parseRegisters(line, current.registersBefore);
+            state = SampleParts::instruction;
+        }
+        else
+        {
+            reset();
+        }
+    }
+
+    void readInstruction(std::string_view line)
+    {
+        current.instruction = parseInstruction(line);
+        state = SampleParts::finalRegisters;
+    }
+
+    void readFinalRegisters(std::string_view line)
+    {
+        if (line.rfind("After:") == 0)
+        {
+            parseRegisters(line, current.registersAfter);
+            state = SampleParts::initialRegisters;
+            ready = true;
+        }
+        else
+        {
+            reset();
+        }
+    }
+};
+
+
+class OpCodeMatcher
+{
+public:
+    static std::vector<OpCode> getMachingOpCodes(const Sample& sample)
+    {
+        std::vector<OpCode> ops;
+
+        for (int i = 0; i < getNumOfOpCodes(); ++i)
+        {
+            Machine machine;
+            machine.registers = sample.registersBefore;
+            machine.run(static_cast<OpCode>(i), sample.instruction[1], sample.instruction[2], sample.instruction[3]);
+            if (machine.registers == sample.registersAfter)
+            {
+                ops.push_back(static_cast<OpCode>(i));
+            }
+        }
+
+        return ops;
+    }
+};
+
+
+inline void parse(std::string_view input, std::vector<Sample>& samples,
+    std::vector<Registers>& instructions)
+{
+    try
+    {
+        bool readSamples = true;
+        int emptyLines = 0;
+        SampleBuilder builder;
+
+        for (std::string_view line : puzzleInputs::Lines(input))
+        {
+            if (readSamples)
+            {
+                if (line.size() == 0)
+                {
+                    emptyLines++;
+                    if (emptyLines > 2)
+                    {
+                        readSamples = false;
+                        continue;
+                    }
+                }
+                else
+                {
+                    emptyLines = 0;
+                }
+
+                builder.add(line);
+
+                if (builder.isReady())
+                {
+                    samples.push_back(builder.getCurrent());
+                }
+            }
+            else
+            {
+                instructions.push_back(parseInstruction(line));
+            }
+        }
+    }
+    catch(std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+
+// The opcodes each opcode number could stand for
+using Candidates = std::pmr::map<int, std::pmr::set<OpCode>>;
+
+
+inline std::array<OpCode, getNumOfOpCodes()> buildOpCodeTable(Candidates& candidates)
+{
+    std::array<OpCode, getNumOfOpCodes()> table;
+    table.fill(OpCode::nop);
+
+    std::pmr::set<OpCode> toBeAssigned(allocations::getResource());
+    for (int i = 0; i < getNumOfOpCodes(); ++i)
+    {
+        toBeAssigned.insert(static_cast<OpCode>(i));
+    }
+
+    auto it = candidates.begin();
+    while(candidates.size() > 0)
+    {
+        if (it == candidates.end())
+        {
+            it = candidates.begin();
+        }
+        if (it->second.size() == 0)
+        {
+            it = candidates.erase(it);
+            continue;
+        }
+        if (it->second.size() == 1)
+        {
+            OpCode op = *it->second.begin();
+            assert(table[it->first] == OpCode::nop);
+            table[it->first] = op;
+            toBeAssigned.erase(op);
+
+            for (auto& c : candidates)
+            {
+                c.second.erase(op);
+            }
+        }
+        ++it;
+    }
+
+    if (toBeAssigned.size() == 1)
+    {
+        // No candidates left. If only one opcode mapping is missing,
+        // it means that the input samples were not complete but we
+        // can recover from this situation.
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            if (table[i] == OpCode::nop)
+            {
+                table[i] = *toBeAssigned.begin();
+            }
+        }
+    }
+    else if (toBeAssigned.size() > 1)
+    {
+        throw std::runtime_error("Incomplete input. Cannot determine OpCode mapping");
+    }
+
+    return table;
+}
+
+
+// The test program follows the samples after three empty lines
+constexpr std::string_view findProgram(std::string_view input)
+{
+    size_t separator = input.find("\n\n\n\n");
+    return separator == std::string_view::npos ? std::string_view() : input.substr(separator + 4);
+}
+
+
+// Without allocations for parsing at compile time, N is the number of
+// lines of the program
+template<size_t N>
+constexpr std::array<Instruction, N> parseProgram(std::string_view program)
+{
+    std::array<Instruction, N> instructions{};
+    size_t i = 0;
+    for (std::string_view line : puzzleInputs::Lines(program))
+    {
+        instructions.at(i++) = parseInstruction(line);
+    }
+    return instructions;
+}
+
+
+struct Notes
+{
+    std::vector<Sample> samples;
+    std::vector<Instruction> instructions;
+};
+
+
+inline Notes parseNotes(std::string_view input)
+{
+    Notes notes;
+    parse(input, notes.samples, notes.instructions);
+    return notes;
+}
+
+
+inline int countSamplesMatchingAtLeast(const std::vector<Sample>& samples, size_t numOfOpCodes)
+{
+    int count = 0;
+    for (const auto& sample : samples)
+    {
+        if (OpCodeMatcher::getMachingOpCodes(sample).size() >= numOfOpCodes)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+
+// Figures out the opcode numbers from the samples and runs the program.
+inline Registers runProgram(const Notes& notes)
+{
+    Candidates candidates(allocations::getResource());
+    for (const auto& sample : notes.samples)
+    {
+        for (const auto& op : OpCodeMatcher::getMachingOpCodes(sample))
+        {
+            candidates[sample.instruction[0]].insert(op);
+        }
+    }
+
+    auto ops = buildOpCodeTable(candidates);
+    Machine machine;
+    for (const auto& inst : notes.instructions)
+    {
+        machine.run(ops[inst[0]], inst[1], inst[2], inst[3]);
+    }
+    return machine.registers;
+}
+
+}
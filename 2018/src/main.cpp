@@ -0,0 +1,16 @@
+#include <gtest/gtest.h>
+
+#include "GTestTiming.hpp"
+
+int main(int argc, char* argv[])
+{
+    // AOC_TEST_TIMING=<file.json> records the time and memory of each test,
+    // AOC_TEST_REPEAT=<n> repeats them
+    testing::InitGoogleTest(&argc, argv);
+    testTiming::Options options = testTiming::Options::fromEnvironment();
+    testTiming::Recorder recorder;
+    testTiming::install(recorder, options);
+
+    int result = RUN_ALL_TESTS();
+    return testTiming::finish(recorder, options, argv[0], result);
+}
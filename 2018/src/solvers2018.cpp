@@ -0,0 +1,172 @@
+#include <string>
+#include <string_view>
+
+#include "PuzzleInputs.hpp"
+#include "solvers2018.hpp"
+
+#include "day01.hpp"
+#include "day02.hpp"
+#include "day03.hpp"
+#include "day04.hpp"
+#include "day05.hpp"
+#include "day06.hpp"
+#include "day07.hpp"
+#include "day08.hpp"
+#include "day09.hpp"
+#include "day10.hpp"
+#include "day11.hpp"
+#include "day12.hpp"
+#include "day13.hpp"
+#include "day14.hpp"
+#include "day15.hpp"
+#include "day16.hpp"
+
+namespace aoc2018 {
+
+namespace {
+
+std::filesystem::path input(const char* filename)
+{
+    return puzzleInputs::getInputDirectory() / filename;
+}
+
+
+template<typename Position>
+std::string formatPosition(const Position& p)
+{
+    std::string text = std::to_string(p.x);
+    text += ',';
+    text += std::to_string(p.y);
+    return text;
+}
+
+}
+
+
+void registerSolvers(solvers::Registry& registry)
+{
+    constexpr int year = 2018;
+
+    registry.add(year, 1, input("day01_input.txt"),
+        day01::readFrequencyLog,
+        [](const day01::FrequencyLog& log) {
+            return log.getDrift();
+        },
+        day01::findFirstDuplicateFrequency);
+
+    registry.add(year, 2, input("day02_input.txt"),
+        day02::parseIds,
+        day02::calculateChecksum,
+        [](const std::vector<std::string_view>& ids) {
+            return day02::removeDifferentLetters(day02::findWordsWhichDifferByOneLetter(ids));
+        });
+
+    registry.add(year, 3, input("day03_input.txt"),
+        day03::parseClaims,
+        day03::calculateOverlap,
+        day03::findFirstNotOverlapping);
+
+    registry.add(year, 4, input("day04_input.txt"),
+        day04::parseLog,
+        [](const day04::GuardLog& log) {
+            int id = log.whoSleptMost();
+            return id * log.getGuards().at(id).getMostSleptMinute();
+        },
+        [](const day04::GuardLog& log) {
+            int id = log.whoIsMostFrequentlySleepingOnSameMinute();
+            return id * log.getGuards().at(id).getMostSleptMinute();
+        });
+
+    registry.add(year, 5, input("day05_input.txt"),
+        [](std::string_view text) {
+            return std::string(*puzzleInputs::Lines(text).begin());
+        },
+        [](const std::string& polymer) { return day05::findPolymer(polymer).size(); },
+        [](const std::string& polymer) { return day05::findShortestPolymer(polymer); });
+
+    registry.add(year, 6, input("day06_input.txt"),
+        day06::parseCoordinates,
+        [](const std::vector<day06::Point>& coordinates) {
+            return day06::Map(coordinates).getLargestFiniteAreaAroundOneCoordinate();
+        },
+        [](const std::vector<day06::Point>& coordinates) {
+            return day06::Map(coordinates).getAreaWithMaxDistanceToEachCoordinate(10000);
+        });
+
+    registry.add(year, 7, input("day07_input.txt"),
+        day07::parseInput,
+        [](const day07::Steps& steps) { return day07::sortSteps(steps); },
+        [](const day07::Steps& steps) { return day07::processInParallel(steps, 5, 60); });
+
+    registry.add(year, 8, input("day08_input.txt"),
+        day08::parseTree,
+        [](const std::vector<int>& tree) { return day08::Parser(tree).getSumOfMetadata(); },
+        [](const std::vector<int>& tree) { return day08::Parser(tree).getRootValue(); });
+
+    registry.add(year, 9, input("day09_input.txt"),
+        day09::parseGame,
+        [](const day09::Game& game) { return day09::getHighscore(game.numOfPlayers, game.lastMarble); },
+        [](const day09::Game& game) { return day09::getHighscore(game.numOfPlayers, game.lastMarble * 100); });
+
+    registry.add(year, 10, input("day10_input.txt"),
+        [](std::string_view text) { return day10::parsePoints(text); },
+        [](std::vector<day10::Point> points) {
+            day10::waitForMessage(points);
+            return day10::render(points);
+        },
+        [](std::vector<day10::Point> points) { return day10::waitForMessage(points); });
+
+    registry.add(year, 11, input("day11_input.txt"),
+        [](std::string_view text) { return scanner::Scanner(text).integer<int>(); },
+        [](int serialNumber) { return day11::PowerGrid(serialNumber); },
+        [](const day11::PowerGrid& grid) {
+            return formatPosition(grid.getSquareWithHighestPowerBySize(3));
+        },
+        [](const day11::PowerGrid& grid) {
+            auto square = grid.getSquareWithHighestPower();
+            return formatPosition(square) + ',' + std::to_string(square.size);
+        });
+
+    registry.add(year, 12, input("day12_input.txt"),
+        day12::parsePots,
+        [](day12::Pots pots) {
+            for (int generation = 0; generation < 20; ++generation)
+            {
+                pots.advance();
+            }
+            return pots.getSum();
+        },
+        [](const day12::Pots& pots) { return day12::getSumAfter(pots, 50000000000); });
+
+    registry.add(year, 13, input("day13_input.txt"),
+        day13::readTrack,
+        [](const day13::Track& track) { return formatPosition(day13::findFirstCrash(track)); },
+        [](const day13::Track& track) { return formatPosition(day13::findLastCart(track)); });
+
+    registry.add(year, 14, input("day14_input.txt"),
+        [](std::string_view text) { return std::string(scanner::Scanner(text).word()); },
+        [](const std::string& after) {
+            size_t n = scanner::toInteger<size_t>(after);
+            return day14::Scoreboard{n, day14::Recipes(n + 10), day14::parseDigits(after)};
+        },
+        [](const day14::Scoreboard& scoreboard) { return scoreboard.recipes.get(scoreboard.after); },
+        [](const day14::Scoreboard& scoreboard) { return day14::findRecipesBefore(scoreboard.digits); });
+
+    registry.add(year, 15, input("day15_input.txt"),
+        [](std::string_view text) { return day15::Map(text); },
+        day15::getOutcome,
+        day15::getOutcomeWithoutElfLosses);
+
+    registry.add(year, 16, input("day16_input.txt"),
+        day16::parseNotes,
+        [](const day16::Notes& notes) { return day16::countSamplesMatchingAtLeast(notes.samples, 3); },
+        [](const day16::Notes& notes) { return day16::runProgram(notes)[0]; });
+
+    // Days that can consume piped input as it arrives
+    registry.addStream(year, 1, day01::solveStreaming);
+    registry.addStream(year, 2, day02::solveStreaming);
+    registry.addStream(year, 5, day05::solveStreaming);
+    registry.addStream(year, 8, day08::solveStreaming);
+}
+
+}
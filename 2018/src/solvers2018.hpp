@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Registry.hpp"
+
+namespace aoc2018 {
+
+// Adds a solver for every day of 2018 that reads its puzzle input from
+// 2018/inputs.
+void registerSolvers(solvers::Registry& registry);
+
+}
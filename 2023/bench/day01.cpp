@@ -0,0 +1,37 @@
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "day01.hpp"
+#include "generators.hpp"
+
+namespace aoc2023::day01
+{
+static void BM_sumCalibrationValuesDigits(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sumCalibrationValues(std::string_view(text), digits));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_sumCalibrationValuesDigits)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+
+static void BM_sumCalibrationValuesDigitsAndWords(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sumCalibrationValues(std::string_view(text), digitsAndWords));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_sumCalibrationValuesDigitsAndWords)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+}
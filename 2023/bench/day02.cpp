@@ -0,0 +1,66 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Benchmarking.hpp"
+#include "MappedInput.hpp"
+#include "day02.hpp"
+#include "generators.hpp"
+
+namespace aoc2023::day02
+{
+static void BM_makeGame(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        for (std::string_view line : puzzleInputs::Lines(text))
+        {
+            benchmark::DoNotOptimize(makeGame(line));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_makeGame)->RangeMultiplier(8)->Range(1 << 6, 1 << 18)->Complexity();
+
+static void BM_isPlayableWith(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+    std::vector<Game> games;
+    for (std::string_view line : puzzleInputs::Lines(text))
+    {
+        games.push_back(makeGame(line));
+    }
+    Cubes availableCubes(12, 13, 14);
+
+    for (auto _ : state)
+    {
+        uint32_t sum = 0;
+        for (const Game& game : games)
+        {
+            sum += game.isPlayableWith(availableCubes) ? game.getId() : 0;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * games.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_isPlayableWith)->RangeMultiplier(8)->Range(1 << 6, 1 << 18)->Complexity();
+
+static void BM_sumPowersOfMinimumSets(benchmark::State& state)
+{
+    std::string text = generateInput(state.range(0), benchmarking::defaultSeed);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sumPowersOfMinimumSets(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_sumPowersOfMinimumSets)->RangeMultiplier(8)->Range(1 << 6, 1 << 18)->Complexity();
+}
@@ -0,0 +1,47 @@
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "Scanner.hpp"
+#include "generators.hpp"
+
+// Writes a synthetic puzzle input to stdout:
+//   aoc2023_generate <day> <size> [seed]
+int main(int argc, char* argv[])
+{
+    using Generator = std::function<std::string(size_t, std::uint64_t)>;
+    const std::map<int, Generator> generators = {
+        {1, aoc2023::day01::generateInput},
+        {2, aoc2023::day02::generateInput}
+    };
+
+    if (argc < 3 || argc > 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <day> <size> [seed]" << std::endl;
+        return 2;
+    }
+
+    try
+    {
+        int day = scanner::toInteger<int>(argv[1]);
+        size_t size = scanner::toInteger<size_t>(argv[2]);
+        std::uint64_t seed = argc > 3 ? scanner::toInteger<std::uint64_t>(argv[3]) : 1;
+
+        auto generator = generators.find(day);
+        if (generator == generators.end())
+        {
+            std::cerr << "No generator for day " << day << std::endl;
+            return 1;
+        }
+        std::cout << generator->second(size, seed);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Random.hpp"
+#include "day01.hpp"
+
+// Synthetic puzzle inputs of arbitrary size. Every generator takes a size
+// and a seed and returns the same text for the same arguments, in the
+// format of the real input of that day.
+
+namespace aoc2023::day01
+{
+// count lines of letters, digits and spelled out digits. Every line holds at
+// least one digit.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    std::string text;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string line;
+        bool hasDigit = false;
+        int tokens = random.between(1, 8);
+
+        for (int t = 0; t < tokens || !hasDigit; ++t)
+        {
+            int kind = random.between(0, 2);
+            if (kind == 0 || t >= tokens)
+            {
+                line += random.between('1', '9');
+                hasDigit = true;
+            }
+            else if (kind == 1)
+            {
+                line += digitsAndWords[random.between(9, 17)];
+            }
+            else
+            {
+                for (int n = random.between(1, 6); n > 0; --n)
+                {
+                    line += random.between('a', 'z');
+                }
+            }
+        }
+        text += line;
+        text += '\n';
+    }
+    return text;
+}
+}
+
+
+namespace aoc2023::day02
+{
+// count games of one to six turns.
+inline std::string generateInput(size_t count, std::uint64_t seed)
+{
+    benchmarking::Random random(seed);
+    std::string text;
+
+    for (size_t id = 1; id <= count; ++id)
+    {
+        text += "Game " + std::to_string(id) + ":";
+        int turns = random.between(1, 6);
+        for (int turn = 0; turn < turns; ++turn)
+        {
+            std::array<const char*, 3> colours = {"red", "green", "blue"};
+            random.shuffle(colours.begin(), colours.end());
+
+            int shown = random.between(1, 3);
+            for (int c = 0; c < shown; ++c)
+            {
+                text += c == 0 ? " " : ", ";
+                text += std::to_string(random.between(1, 20)) + ' ' + colours[c];
+            }
+            text += turn + 1 < turns ? ";" : "";
+        }
+        text += '\n';
+    }
+    return text;
+}
+}
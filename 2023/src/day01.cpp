@@ -1,93 +1,17 @@
-#include <array>
-#include <fstream>
-#include <map>
 #include <string>
-#include <span>
-#include <filesystem>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <CppUTest/TestHarness.h>
 
 #include "PuzzleInputs.hpp"
+#include "day01.hpp"
 
 namespace aoc2023::day01
 {
-namespace
-{
-constexpr std::array digits(std::to_array<const char*>(
-    {"1", "2", "3", "4", "5", "6", "7", "8", "9"}));
-
-constexpr std::array digitsAndWords(std::to_array<const char*>(
-    {"1", "2", "3", "4", "5", "6", "7", "8", "9",
-     "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"}));
-
-const std::map<const char*, int> translations{
-    {"1", 1},
-    {"2", 2},
-    {"3", 3},
-    {"4", 4},
-    {"5", 5},
-    {"6", 6},
-    {"7", 7},
-    {"8", 8},
-    {"9", 9},
-    {"one", 1},
-    {"two", 2},
-    {"three", 3},
-    {"four", 4},
-    {"five", 5},
-    {"six", 6},
-    {"seven", 7},
-    {"eight", 8},
-    {"nine", 9}
-};
-}
-
 TEST_GROUP(Day01)
 {
-    using ListOfStrings = std::span<const char* const>;
-
-    int sumCalibrationValues(const std::filesystem::path& filepath, const ListOfStrings allowedNumbers)
-    {
-        std::ifstream input(filepath);
-        CHECK_TRUE(input.is_open());
-
-        int sum = 0;
-        std::string line;
-        while (std::getline(input, line))
-        {
-            sum += parseCalibrationValue(line, allowedNumbers);
-        }
-
-        return sum;
-    }
-
-    int parseCalibrationValue(const std::string& input, const ListOfStrings allowedNumbers)
-    {
-        std::map<int, int> positions = findSymbols(input, allowedNumbers);
-        return positions.begin()->second * 10 + positions.rbegin()->second;
-    }
-
-    std::map<int, int> findSymbols(const std::string& input, const ListOfStrings symbols)
-    {
-        std::map<int, int> positions;
-
-        for (const char* symbol : symbols)
-        {
-            size_t pos = input.find(symbol);
-            while (pos != std::string::npos)
-            {
-                positions[pos] = translate(symbol);
-                pos = input.find(symbol, pos + 1);
-            }
-        }
-
-        return positions;
-    }
-
-    int translate(const char* number)
-    {
-        return translations.at(number);
-    }
 };
 
 TEST(Day01, part1InputDecoding)
@@ -97,6 +21,8 @@ TEST(Day01, part1InputDecoding)
     CHECK_EQUAL(15, parseCalibrationValue("a1b2c3d4e5f", digits));
     CHECK_EQUAL(77, parseCalibrationValue("treb7uchet", digits));
     CHECK_EQUAL(11, parseCalibrationValue("121", digits));
+    CHECK_EQUAL(0, parseCalibrationValue("abc", digits));
+    CHECK_EQUAL(0, parseCalibrationValue("", digits));
 }
 
 TEST(Day01, part2InputDecoding)
@@ -114,6 +40,15 @@ TEST(Day01, part2InputDecoding)
     CHECK_EQUAL(28, parseCalibrationValue("2eightwo8", digitsAndWords));
     CHECK_EQUAL(22, parseCalibrationValue("2eightwo", digitsAndWords));
     CHECK_EQUAL(11, parseCalibrationValue("onetwone", digitsAndWords));
+    CHECK_EQUAL(0, parseCalibrationValue("eigh", digitsAndWords));
+}
+
+TEST(Day01, translate)
+{
+    // Looked up by text, not by the address of the literal
+    std::string word = "seven";
+    CHECK_EQUAL(7, translate(word));
+    CHECK_EQUAL(9, translate(std::string("9")));
 }
 
 TEST(Day01, part1)
@@ -125,4 +60,28 @@ TEST(Day01, part2)
 {
     CHECK_EQUAL(52840, sumCalibrationValues(puzzleInputs::getInputDirectory() / "day01_input.txt", digitsAndWords));
 }
+
+TEST(Day01, parseDocument)
+{
+    std::vector<std::string_view> document = parseDocument("1abc2\npqr3stu8vwx\n\ntwo1nine\n");
+    CHECK_EQUAL(4, document.size());
+    CHECK_EQUAL(std::string_view("pqr3stu8vwx"), document[1]);
+    CHECK_EQUAL(12 + 38 + 0 + 29, sumCalibrationValues(document, digitsAndWords));
+}
+
+TEST(Day01, streaming)
+{
+    puzzleInputs::ChunkReader input("1abc2\npqr3stu8vwx\ntwo1nine\n7pqrstsixteen", 4);
+    std::pair<int, int> sums = sumCalibrationValues(input);
+    CHECK_EQUAL(12 + 38 + 11 + 77, sums.first);
+    CHECK_EQUAL(12 + 38 + 29 + 76, sums.second);
+}
+
+TEST(Day01, windowsLineEndings)
+{
+    std::string_view text = "1abc2\r\npqr3stu8vwx\r\ntwo1nine\r\n7pqrstsix\r\n";
+    CHECK_EQUAL(12 + 38 + 11 + 77, sumCalibrationValues(text, digits));
+    puzzleInputs::ChunkReader input(text, 4);
+    CHECK_EQUAL(12 + 38 + 29 + 76, sumCalibrationValues(input).second);
+}
 }
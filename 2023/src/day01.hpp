@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "MappedInput.hpp"
+#include "StreamInput.hpp"
+
+namespace aoc2023::day01
+{
+constexpr std::array digits(std::to_array<const char*>(
+    {"1", "2", "3", "4", "5", "6", "7", "8", "9"}));
+
+constexpr std::array digitsAndWords(std::to_array<const char*>(
+    {"1", "2", "3", "4", "5", "6", "7", "8", "9",
+     "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"}));
+
+inline const std::map<std::string_view, int> translations{
+    {"1", 1},
+    {"2", 2},
+    {"3", 3},
+    {"4", 4},
+    {"5", 5},
+    {"6", 6},
+    {"7", 7},
+    {"8", 8},
+    {"9", 9},
+    {"one", 1},
+    {"two", 2},
+    {"three", 3},
+    {"four", 4},
+    {"five", 5},
+    {"six", 6},
+    {"seven", 7},
+    {"eight", 8},
+    {"nine", 9}
+};
+
+using ListOfStrings = std::span<const char* const>;
+
+inline int translate(std::string_view number)
+{
+    return translations.at(number);
+}
+
+inline std::map<int, int> findSymbols(std::string_view input, const ListOfStrings symbols)
+{
+    std::map<int, int> positions;
+
+    for (const char* symbol : symbols)
+    {
+        size_t pos = input.find(symbol);
+        while (pos != std::string_view::npos)
+        {
+            positions[pos] = translate(symbol);
+            pos = input.find(symbol, pos + 1);
+        }
+    }
+
+    return positions;
+}
+
+inline int parseCalibrationValue(std::string_view input, const ListOfStrings allowedNumbers)
+{
+    std::map<int, int> positions = findSymbols(input, allowedNumbers);
+    if (positions.empty())
+    {
+        return 0;
+    }
+    return positions.begin()->second * 10 + positions.rbegin()->second;
+}
+
+inline std::vector<std::string_view> parseDocument(std::string_view input)
+{
+    puzzleInputs::Lines lines(input);
+    return std::vector<std::string_view>(lines.begin(), lines.end());
+}
+
+inline int sumCalibrationValues(const std::vector<std::string_view>& document, const ListOfStrings allowedNumbers)
+{
+    int sum = 0;
+    for (std::string_view line : document)
+    {
+        sum += parseCalibrationValue(line, allowedNumbers);
+    }
+
+    return sum;
+}
+
+inline int sumCalibrationValues(std::string_view input, const ListOfStrings allowedNumbers)
+{
+    return sumCalibrationValues(parseDocument(input), allowedNumbers);
+}
+
+inline int sumCalibrationValues(const std::filesystem::path& filepath, const ListOfStrings allowedNumbers)
+{
+    puzzleInputs::MappedInput input(filepath);
+    return sumCalibrationValues(input.view(), allowedNumbers);
+}
+
+// Both sums line by line while the input arrives
+inline std::pair<int, int> sumCalibrationValues(puzzleInputs::ChunkReader& input)
+{
+    puzzleInputs::LineReader lines(input);
+    std::pair<int, int> sums{0, 0};
+    while (auto line = lines.next())
+    {
+        sums.first += parseCalibrationValue(*line, digits);
+        sums.second += parseCalibrationValue(*line, digitsAndWords);
+    }
+    return sums;
+}
+}
@@ -1,204 +1,15 @@
-#include <fstream>
-#include <string>
-#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
 #include <vector>
-#include <sstream>
-#include <filesystem>
 
 #include <CppUTest/TestHarness.h>
 
 #include "PuzzleInputs.hpp"
+#include "day02.hpp"
 
 namespace aoc2023::day02
 {
-namespace
-{
-class Cubes
-{
-public:
-    Cubes(uint32_t r = 0, uint32_t g = 0, uint32_t b = 0) :
-        red(r), green(g), blue(b)
-    {
-    }
-
-    bool operator<(const Cubes& other) const
-    {
-        return red < other.red || green < other.green || blue < other.blue;
-    }
-
-    Cubes& operator+=(const Cubes& other)
-    {
-        red += other.red;
-        green += other.green;
-        blue += other.blue;
-        return *this;
-    }
-
-    uint32_t power() const
-    {
-        return red * green * blue;
-    }
-
-    uint32_t red{0};
-    uint32_t green{0};
-    uint32_t blue{0};
-};
-
-class Game
-{
-public:
-    Game(uint32_t idIn, const std::vector<Cubes>& turnsIn) : id(idIn), turns(turnsIn)
-    {
-    }
-
-    uint32_t getId() const { return id; }
-
-    const std::vector<Cubes>& getTurns() const { return turns; }
-
-    bool isPlayableWith(const Cubes& availableCubes) const
-    {
-        for (const Cubes& cubesRequiredForTurn : turns)
-        {
-            if (availableCubes < cubesRequiredForTurn)
-            {
-                return false;
-            }
-        }
-        return true;
-    }
-
-    Cubes getMinimumSetOfCubes() const
-    {
-        Cubes minimumSet;
-
-        for (const Cubes& turn : turns)
-        {
-            minimumSet.red = std::max(minimumSet.red, turn.red);
-            minimumSet.green = std::max(minimumSet.green, turn.green);
-            minimumSet.blue = std::max(minimumSet.blue, turn.blue);
-        }
-
-        return minimumSet;
-    }
-
-private:
-    uint32_t id;
-    std::vector<Cubes> turns;
-};
-
-template<typename T>
-T get(std::istringstream& input, const char* errorMessage)
-{
-    T value;
-    if (input >> value)
-    {
-        return value;
-    }
-    throw std::runtime_error(errorMessage);
-}
-
-
-Cubes parseCubeType(const std::string& input)
-{
-    std::istringstream type(input);
-    uint32_t num = get<uint32_t>(type, "Failed to determine number of cubes");
-    std::string color = get<std::string>(type, "Failed to determine color of the cube");
-
-    if (color == "red")
-    {
-        return Cubes(num, 0, 0);
-    }
-    else if (color == "green")
-    {
-        return Cubes(0, num, 0);
-    }
-    else if (color == "blue")
-    {
-        return Cubes(0, 0, num);
-    }
-    else
-    {
-        throw std::runtime_error("Unknown color: " + color);
-    }
-}
-
-Cubes parseTurn(const std::string& definition)
-{
-    constexpr char delimiter = ',';
-    std::istringstream turn(definition);
-    Cubes cubes;
-    std::string type;
-    while (std::getline(turn, type, delimiter))
-    {
-        cubes += parseCubeType(type);
-    }
-    return cubes;
-}
-
-std::string extractTitle(std::istringstream& input)
-{
-    return get<std::string>(input, "Invalid game definition");
-}
-
-void validateTitle(const std::string& title)
-{
-    const std::string expectedTitle = "Game";
-    if (title != expectedTitle)
-    {
-        throw std::runtime_error("Unexpected game title \"" + title + "\"");
-    }
-}
-
-uint32_t extractId(std::istringstream& input)
-{
-    return get<uint32_t>(input, "Invalid or missing game identifier");
-}
-
-char extractEndMarker(std::istringstream& input)
-{
-    return get<char>(input, "Expected : after game identifier");
-}
-
-void validateEndMarker(char marker)
-{
-    constexpr char expectedEndMarker = ':';
-    if (marker != expectedEndMarker)
-    {
-        throw std::runtime_error("Expected " + std::to_string(expectedEndMarker) +
-            " after game identifier but got " + std::to_string(marker));
-    }
-}
-
-uint32_t parseHeader(std::istringstream& input)
-{
-    validateTitle(extractTitle(input));
-    uint32_t id = extractId(input);
-    validateEndMarker(extractEndMarker(input));
-    return id;
-}
-
-std::vector<Cubes> parseTurns(std::istringstream& input)
-{
-    std::vector<Cubes> turns;
-    constexpr char turnDelimiter = ';';
-    std::string turn;
-    while (std::getline(input, turn, turnDelimiter))
-    {
-        turns.push_back(parseTurn(turn));
-    }
-
-    return turns;
-}
-
-Game makeGame(const std::string& definition)
-{
-    std::istringstream input(definition);
-    uint32_t id = parseHeader(input);
-    std::vector<Cubes> turns = parseTurns(input);
-    return Game(id, turns);
-}
-}
-
 TEST_GROUP(Utils)
 {
 };
@@ -259,6 +70,16 @@ TEST(Utils, noTurns)
     CHECK_EQUAL(0, game.getTurns().size());
 }
 
+TEST(Utils, parseGames)
+{
+    std::vector<Game> games = parseGames("Game 1: 3 blue, 4 red, 2 green\nGame 2: 1 red; 2 green\n");
+    CHECK_EQUAL(2, games.size());
+    CHECK_EQUAL(2, games[1].getId());
+    CHECK_EQUAL(2, games[1].getTurns().size());
+    CHECK_EQUAL(1 + 2, sumIdsOfPlayableGames(games, Cubes(12, 13, 14)));
+    CHECK_EQUAL(3 * 4 * 2 + 0, sumPowersOfMinimumSets(games));
+}
+
 TEST(Utils, isPlayableWith)
 {
     Cubes availableCubes(12, 13, 14);
@@ -293,43 +114,25 @@ TEST(Utils, powerOfCubeSet)
 
 TEST_GROUP(Solution)
 {
-    void setup()
-    {
-        input.open(puzzleInputs::getInputDirectory() / "day02_input.txt");
-        CHECK_TRUE(input.is_open());
-    }
-
-    std::ifstream input;
+    puzzleInputs::MappedInput input = puzzleInputs::openInput("day02_input.txt");
 };
 
 TEST(Solution, part1)
 {
-    uint32_t sumOfIds = 0;
     Cubes availableCubes(12, 13, 14);
-
-    std::string definition;
-    while (std::getline(input, definition))
-    {
-        Game game = makeGame(definition);
-        if (game.isPlayableWith(availableCubes))
-        {
-            sumOfIds += game.getId();
-        }
-    }
-
-    CHECK_EQUAL(2239, sumOfIds);
+    CHECK_EQUAL(2239, sumIdsOfPlayableGames(input.view(), availableCubes));
 }
 
 TEST(Solution, part2)
 {
-    uint32_t sumOfPowers = 0;
-
-    std::string definition;
-    while (std::getline(input, definition))
-    {
-        sumOfPowers += makeGame(definition).getMinimumSetOfCubes().power();
-    }
+    CHECK_EQUAL(83435, sumPowersOfMinimumSets(input.view()));
+}
 
-    CHECK_EQUAL(83435, sumOfPowers);
+TEST(Solution, streaming)
+{
+    puzzleInputs::ChunkReader stream(input.view(), 100);
+    std::pair<uint32_t, uint32_t> sums = sumGames(stream, Cubes(12, 13, 14));
+    CHECK_EQUAL(2239, sums.first);
+    CHECK_EQUAL(83435, sums.second);
 }
 }
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "MappedInput.hpp"
+#include "Scanner.hpp"
+#include "StreamInput.hpp"
+
+namespace aoc2023::day02
+{
+class Cubes
+{
+public:
+    Cubes(uint32_t r = 0, uint32_t g = 0, uint32_t b = 0) :
+        red(r), green(g), blue(b)
+    {
+    }
+
+    bool operator<(const Cubes& other) const
+    {
+        return red < other.red || green < other.green || blue < other.blue;
+    }
+
+    Cubes& operator+=(const Cubes& other)
+    {
+        red += other.red;
+        green += other.green;
+        blue += other.blue;
+        return *this;
+    }
+
+    uint32_t power() const
+    {
+        return red * green * blue;
+    }
+
+    uint32_t red{0};
+    uint32_t green{0};
+    uint32_t blue{0};
+};
+
+class Game
+{
+public:
+    Game(uint32_t idIn, const std::vector<Cubes>& turnsIn) : id(idIn), turns(turnsIn)
+    {
+    }
+
+    uint32_t getId() const { return id; }
+
+    const std::vector<Cubes>& getTurns() const { return turns; }
+
+    bool isPlayableWith(const Cubes& availableCubes) const
+    {
+        for (const Cubes& cubesRequiredForTurn : turns)
+        {
+            if (availableCubes < cubesRequiredForTurn)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Cubes getMinimumSetOfCubes() const
+    {
+        Cubes minimumSet;
+
+        for (const Cubes& turn : turns)
+        {
+            minimumSet.red = std::max(minimumSet.red, turn.red);
+            minimumSet.green = std::max(minimumSet.green, turn.green);
+            minimumSet.blue = std::max(minimumSet.blue, turn.blue);
+        }
+
+        return minimumSet;
+    }
+
+private:
+    uint32_t id;
+    std::vector<Cubes> turns;
+};
+
+template<typename T>
+T get(std::optional<T> value, const char* errorMessage)
+{
+    if (value)
+    {
+        return *value;
+    }
+    throw std::runtime_error(errorMessage);
+}
+
+inline std::optional<std::string_view> nextWord(scanner::Scanner& input)
+{
+    std::string_view word = input.word();
+    return word.empty() ? std::nullopt : std::optional(word);
+}
+
+
+inline Cubes parseCubeType(std::string_view input)
+{
+    scanner::Scanner type(input);
+    uint32_t num = get(type.tryInteger<uint32_t>(), "Failed to determine number of cubes");
+    std::string_view color = get(nextWord(type), "Failed to determine color of the cube");
+
+    if (color == "red")
+    {
+        return Cubes(num, 0, 0);
+    }
+    else if (color == "green")
+    {
+        return Cubes(0, num, 0);
+    }
+    else if (color == "blue")
+    {
+        return Cubes(0, 0, num);
+    }
+    else
+    {
+        throw std::runtime_error("Unknown color: " + std::string(color));
+    }
+}
+
+inline Cubes parseTurn(std::string_view definition)
+{
+    constexpr char delimiter = ',';
+    scanner::Scanner turn(definition);
+    Cubes cubes;
+    while (turn.hasMore())
+    {
+        cubes += parseCubeType(turn.until(delimiter));
+    }
+    return cubes;
+}
+
+inline std::string_view extractTitle(scanner::Scanner& input)
+{
+    return get(nextWord(input), "Invalid game definition");
+}
+
+inline void validateTitle(std::string_view title)
+{
+    constexpr std::string_view expectedTitle = "Game";
+    if (title != expectedTitle)
+    {
+        throw std::runtime_error("Unexpected game title \"" + std::string(title) + "\"");
+    }
+}
+
+inline uint32_t extractId(scanner::Scanner& input)
+{
+    return get(input.tryInteger<uint32_t>(), "Invalid or missing game identifier");
+}
+
+inline char extractEndMarker(scanner::Scanner& input)
+{
+    return get(input.tryChar(), "Expected : after game identifier");
+}
+
+inline void validateEndMarker(char marker)
+{
+    constexpr char expectedEndMarker = ':';
+    if (marker != expectedEndMarker)
+    {
+        throw std::runtime_error("Expected " + std::to_string(expectedEndMarker) +
+            " after game identifier but got " + std::to_string(marker));
+    }
+}
+
+inline uint32_t parseHeader(scanner::Scanner& input)
+{
+    validateTitle(extractTitle(input));
+    uint32_t id = extractId(input);
+    validateEndMarker(extractEndMarker(input));
+    return id;
+}
+
+inline std::vector<Cubes> parseTurns(scanner::Scanner& input)
+{
+    std::vector<Cubes> turns;
+    constexpr char turnDelimiter = ';';
+    while (input.hasMore())
+    {
+        turns.push_back(parseTurn(input.until(turnDelimiter)));
+    }
+
+    return turns;
+}
+
+inline Game makeGame(std::string_view definition)
+{
+    scanner::Scanner input(definition);
+    uint32_t id = parseHeader(input);
+    std::vector<Cubes> turns = parseTurns(input);
+    return Game(id, turns);
+}
+
+
+inline std::vector<Game> parseGames(std::string_view input)
+{
+    std::vector<Game> games;
+    for (std::string_view definition : puzzleInputs::Lines(input))
+    {
+        games.push_back(makeGame(definition));
+    }
+    return games;
+}
+
+inline uint32_t sumIdsOfPlayableGames(const std::vector<Game>& games, const Cubes& availableCubes)
+{
+    uint32_t sumOfIds = 0;
+    for (const Game& game : games)
+    {
+        if (game.isPlayableWith(availableCubes))
+        {
+            sumOfIds += game.getId();
+        }
+    }
+    return sumOfIds;
+}
+
+inline uint32_t sumIdsOfPlayableGames(std::string_view input, const Cubes& availableCubes)
+{
+    return sumIdsOfPlayableGames(parseGames(input), availableCubes);
+}
+
+inline uint32_t sumPowersOfMinimumSets(const std::vector<Game>& games)
+{
+    uint32_t sumOfPowers = 0;
+    for (const Game& game : games)
+    {
+        sumOfPowers += game.getMinimumSetOfCubes().power();
+    }
+    return sumOfPowers;
+}
+
+inline uint32_t sumPowersOfMinimumSets(std::string_view input)
+{
+    return sumPowersOfMinimumSets(parseGames(input));
+}
+
+// Both sums game by game while the input arrives
+inline std::pair<uint32_t, uint32_t> sumGames(puzzleInputs::ChunkReader& input, const Cubes& availableCubes)
+{
+    puzzleInputs::LineReader lines(input);
+    std::pair<uint32_t, uint32_t> sums{0, 0};
+    while (auto definition = lines.next())
+    {
+        Game game = makeGame(*definition);
+        if (game.isPlayableWith(availableCubes))
+        {
+            sums.first += game.getId();
+        }
+        sums.second += game.getMinimumSetOfCubes().power();
+    }
+    return sums;
+}
+}
@@ -1,6 +1,34 @@
+#include <string>
+#include <vector>
+
 #include <CppUTest/CommandLineTestRunner.h>
 
+#include "CppUTestTiming.hpp"
+
 int main(int argc, char* argv[])
 {
-    return CommandLineTestRunner::RunAllTests(argc, argv);
+    // AOC_TEST_TIMING=<file.json> records the time and memory of each test,
+    // AOC_TEST_REPEAT=<n> repeats them
+    testTiming::Options options = testTiming::Options::fromEnvironment();
+    testTiming::Recorder recorder;
+    testTiming::CppUTestPlugin timing(recorder);
+
+    std::vector<const char*> arguments(argv, argv + argc);
+    std::string repeat = "-r" + std::to_string(options.repeat);
+    if (options.output)
+    {
+        TestRegistry::getCurrentRegistry()->installPlugin(&timing);
+        if (options.repeat > 1)
+        {
+            arguments.push_back(repeat.c_str());
+        }
+    }
+
+    int result = CommandLineTestRunner::RunAllTests(static_cast<int>(arguments.size()), arguments.data());
+    if (options.output)
+    {
+        // The recorder allocated its samples without the leak detector
+        testTiming::CppUTestPlugin::disableLeakDetection();
+    }
+    return testTiming::finish(recorder, options, argv[0], result);
 }
@@ -0,0 +1,43 @@
+#include <string_view>
+#include <vector>
+
+#include "PuzzleInputs.hpp"
+#include "solvers2023.hpp"
+
+#include "day01.hpp"
+#include "day02.hpp"
+
+namespace aoc2023
+{
+void registerSolvers(solvers::Registry& registry)
+{
+    constexpr int year = 2023;
+    const auto inputs = puzzleInputs::getInputDirectory();
+
+    registry.add(year, 1, inputs / "day01_input.txt",
+        day01::parseDocument,
+        [](const std::vector<std::string_view>& document) {
+            return day01::sumCalibrationValues(document, day01::digits);
+        },
+        [](const std::vector<std::string_view>& document) {
+            return day01::sumCalibrationValues(document, day01::digitsAndWords);
+        });
+
+    registry.add(year, 2, inputs / "day02_input.txt",
+        day02::parseGames,
+        [](const std::vector<day02::Game>& games) {
+            return day02::sumIdsOfPlayableGames(games, day02::Cubes(12, 13, 14));
+        },
+        [](const std::vector<day02::Game>& games) {
+            return day02::sumPowersOfMinimumSets(games);
+        });
+
+    // Both days can consume piped input as it arrives
+    registry.addStream(year, 1, [](puzzleInputs::ChunkReader& input) {
+        return day01::sumCalibrationValues(input);
+    });
+    registry.addStream(year, 2, [](puzzleInputs::ChunkReader& input) {
+        return day02::sumGames(input, day02::Cubes(12, 13, 14));
+    });
+}
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Registry.hpp"
+
+namespace aoc2023
+{
+// Adds a solver for every day of 2023 that reads its puzzle input from
+// 2023/inputs.
+void registerSolvers(solvers::Registry& registry);
+}
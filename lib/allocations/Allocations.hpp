@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace allocations
+{
+// What a scope allocated: number of allocations, their total size and the
+// highest amount of live heap memory above the level at the start.
+struct Stats
+{
+    std::uint64_t count{0};
+    std::uint64_t bytes{0};
+    std::uint64_t peak{0};
+};
+
+
+// Heap counters of the calling thread, updated by the global operator
+// new/delete replacements in TrackingNewDelete.cpp. Memory freed by another
+// thread than the one that allocated it lowers that thread's live bytes.
+struct ThreadCounters
+{
+    std::uint64_t count{0};
+    std::uint64_t bytes{0};
+    std::int64_t live{0};
+    std::int64_t peak{0};
+
+    void allocated(size_t size)
+    {
+        count++;
+        bytes += size;
+        live += static_cast<std::int64_t>(size);
+        peak = std::max(peak, live);
+    }
+
+    void freed(size_t size)
+    {
+        live -= static_cast<std::int64_t>(size);
+    }
+};
+
+inline thread_local ThreadCounters threadCounters;
+
+// Set when the operator new/delete replacements are linked in, without
+// them all counts stay zero.
+inline std::atomic<bool> tracking{false};
+
+inline bool isTracking()
+{
+    return tracking.load(std::memory_order_relaxed);
+}
+
+
+// Counts the allocations of the calling thread between construction and
+// stop(). Scopes nest.
+class Scope
+{
+public:
+    Scope() :
+        startCount(threadCounters.count),
+        startBytes(threadCounters.bytes),
+        startLive(threadCounters.live),
+        outerPeak(threadCounters.peak)
+    {
+        threadCounters.peak = threadCounters.live;
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope()
+    {
+        if (!stopped)
+        {
+            stop();
+        }
+    }
+
+    Stats stop()
+    {
+        Stats stats;
+        stats.count = threadCounters.count - startCount;
+        stats.bytes = threadCounters.bytes - startBytes;
+        stats.peak = static_cast<std::uint64_t>(std::max<std::int64_t>(0, threadCounters.peak - startLive));
+        threadCounters.peak = std::max(outerPeak, threadCounters.peak);
+        stopped = true;
+        return stats;
+    }
+
+private:
+    std::uint64_t startCount;
+    std::uint64_t startBytes;
+    std::int64_t startLive;
+    std::int64_t outerPeak;
+    bool stopped{false};
+};
+
+
+// memory_resource that counts what goes through it before handing it to
+// the upstream resource. Works without the operator new replacements, so
+// containers on arenas or other resources can be accounted for too.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) :
+        upstream(upstream)
+    {
+    }
+
+    Stats getStats() const
+    {
+        return {count, bytes, static_cast<std::uint64_t>(peak)};
+    }
+
+    std::uint64_t getLiveBytes() const
+    {
+        return static_cast<std::uint64_t>(live);
+    }
+
+private:
+    void* do_allocate(size_t size, size_t alignment) override
+    {
+        void* p = upstream->allocate(size, alignment);
+        count++;
+        bytes += size;
+        live += static_cast<std::int64_t>(size);
+        peak = std::max(peak, live);
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t size, size_t alignment) override
+    {
+        upstream->deallocate(p, size, alignment);
+        live -= static_cast<std::int64_t>(size);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream;
+    std::uint64_t count{0};
+    std::uint64_t bytes{0};
+    std::int64_t live{0};
+    std::int64_t peak{0};
+};
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+
+namespace allocations
+{
+// Bump allocator for everything one solve allocates. Deallocation does
+// nothing, the memory goes back upstream all at once when the arena is
+// released or destroyed. It grows in blocks of increasing size, so a solve
+// only makes a handful of upstream allocations. Not thread-safe: an arena
+// is used by the thread that made it current with a ResourceScope.
+class Arena : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t defaultInitialSize = 64 * 1024;
+
+    explicit Arena(size_t initialSize = defaultInitialSize,
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) :
+        buffer(initialSize, upstream)
+    {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Everything allocated from the arena is gone afterwards
+    void release()
+    {
+        buffer.release();
+        allocatedBytes = 0;
+    }
+
+    // Bytes handed out since construction or the last release
+    size_t getAllocatedBytes() const
+    {
+        return allocatedBytes;
+    }
+
+private:
+    void* do_allocate(size_t size, size_t alignment) override
+    {
+        allocatedBytes += size;
+        return buffer.allocate(size, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::monotonic_buffer_resource buffer;
+    size_t allocatedBytes{0};
+};
+
+
+// Arena that keeps its memory for the next use. Everything is bumped from
+// one buffer; when a use needs more, the overflow comes from upstream blocks
+// and release() grows the buffer to what that use needed. Once it has seen
+// the largest input, a thread that solves input after input with it
+// allocates nothing upstream.
+class ScratchArena : public std::pmr::memory_resource
+{
+public:
+    explicit ScratchArena(size_t initialSize = Arena::defaultInitialSize,
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) :
+        upstream(upstream)
+    {
+        reserve(initialSize);
+    }
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    ~ScratchArena() override
+    {
+        buffer.reset();
+        upstream->deallocate(memory, capacity, alignof(std::max_align_t));
+    }
+
+    // Everything allocated from the arena is gone afterwards, the memory
+    // stays
+    void release()
+    {
+        if (allocatedBytes > capacity)
+        {
+            // Alignment padding comes on top of the requested bytes
+            reserve(std::bit_ceil(allocatedBytes + allocatedBytes / 4));
+        }
+        else
+        {
+            buffer->release();
+        }
+        allocatedBytes = 0;
+    }
+
+    // Bytes handed out since construction or the last release
+    size_t getAllocatedBytes() const
+    {
+        return allocatedBytes;
+    }
+
+    size_t getCapacity() const
+    {
+        return capacity;
+    }
+
+private:
+    void reserve(size_t size)
+    {
+        buffer.reset();
+        if (memory)
+        {
+            upstream->deallocate(memory, capacity, alignof(std::max_align_t));
+        }
+        memory = upstream->allocate(size, alignof(std::max_align_t));
+        capacity = size;
+        buffer.emplace(memory, capacity, upstream);
+    }
+
+    void* do_allocate(size_t size, size_t alignment) override
+    {
+        allocatedBytes += size;
+        return buffer->allocate(size, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream;
+    void* memory{nullptr};
+    size_t capacity{0};
+    std::optional<std::pmr::monotonic_buffer_resource> buffer;
+    size_t allocatedBytes{0};
+};
+
+
+inline std::pmr::memory_resource*& currentResource()
+{
+    thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
+
+// The resource solvers allocate their containers from: the one made
+// current on this thread by the innermost ResourceScope, otherwise the
+// default resource.
+inline std::pmr::memory_resource* getResource()
+{
+    std::pmr::memory_resource* resource = currentResource();
+    return resource ? resource : std::pmr::get_default_resource();
+}
+
+
+// Makes a resource, usually an Arena, current on the calling thread until
+// the end of the scope. Scopes nest.
+class ResourceScope
+{
+public:
+    explicit ResourceScope(std::pmr::memory_resource& resource) :
+        previous(std::exchange(currentResource(), &resource))
+    {
+    }
+
+    ResourceScope(const ResourceScope&) = delete;
+    ResourceScope& operator=(const ResourceScope&) = delete;
+
+    ~ResourceScope()
+    {
+        currentResource() = previous;
+    }
+
+private:
+    std::pmr::memory_resource* previous;
+};
+}
@@ -0,0 +1,48 @@
+// Reports the allocations of every benchmark (allocs_per_iter and
+// max_bytes_used in the JSON output). Linked into the benchmark targets together
+// with TrackingNewDelete.cpp when built with -DAOC_TRACK_ALLOCATIONS=ON.
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "Allocations.hpp"
+
+namespace
+{
+class MemoryManager : public benchmark::MemoryManager
+{
+public:
+    void Start() override
+    {
+        scope = std::make_unique<allocations::Scope>();
+    }
+
+    void Stop(Result* result) override
+    {
+        Stop(*result);
+    }
+
+    void Stop(Result& result) override
+    {
+        allocations::Stats stats = scope->stop();
+        scope.reset();
+        result.num_allocs = static_cast<int64_t>(stats.count);
+        result.total_allocated_bytes = static_cast<int64_t>(stats.bytes);
+        result.max_bytes_used = static_cast<int64_t>(stats.peak);
+    }
+
+private:
+    std::unique_ptr<allocations::Scope> scope;
+};
+
+
+struct Registration
+{
+    Registration()
+    {
+        static MemoryManager manager;
+        benchmark::RegisterMemoryManager(&manager);
+    }
+} registration;
+}
@@ -0,0 +1,134 @@
+// Replaces the global operator new/delete to count allocations per thread.
+// Only linked into targets built with -DAOC_TRACK_ALLOCATIONS=ON and into
+// the library tests.
+
+#include <cstdlib>
+#include <new>
+
+#include <malloc.h>
+
+#include "Allocations.hpp"
+
+namespace
+{
+struct EnableTracking
+{
+    EnableTracking()
+    {
+        allocations::tracking = true;
+    }
+} enableTracking;
+
+
+void* allocate(std::size_t size)
+{
+    void* p = std::malloc(size > 0 ? size : 1);
+    if (p)
+    {
+        allocations::threadCounters.allocated(malloc_usable_size(p));
+    }
+    return p;
+}
+
+
+void* allocate(std::size_t size, std::align_val_t alignment)
+{
+    std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc wants a multiple of the alignment
+    void* p = std::aligned_alloc(align, (size + align - 1) / align * align);
+    if (p)
+    {
+        allocations::threadCounters.allocated(malloc_usable_size(p));
+    }
+    return p;
+}
+
+
+void release(void* p) noexcept
+{
+    if (p)
+    {
+        allocations::threadCounters.freed(malloc_usable_size(p));
+        std::free(p);
+    }
+}
+}
+
+
+void* operator new(std::size_t size)
+{
+    if (void* p = allocate(size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* p = allocate(size, alignment))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* p) noexcept
+{
+    release(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    release(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    release(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    release(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    release(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    release(p);
+}
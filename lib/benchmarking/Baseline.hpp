@@ -0,0 +1,572 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Json.hpp"
+
+namespace benchmarking
+{
+// Middle of a set of repetitions and how far they typically stray from it.
+// Unlike mean and standard deviation neither is thrown off by the odd run
+// that was interrupted by the rest of the system.
+struct Spread
+{
+    double median{0};
+    // Median absolute deviation from the median
+    double mad{0};
+};
+
+
+inline double getMedian(std::vector<double> values)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    if (values.size() % 2 == 1)
+    {
+        return *middle;
+    }
+    return (*middle + *std::max_element(values.begin(), middle)) / 2;
+}
+
+
+inline Spread getSpread(const std::vector<double>& values)
+{
+    Spread spread;
+    spread.median = getMedian(values);
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    for (double value : values)
+    {
+        deviations.push_back(std::abs(value - spread.median));
+    }
+    spread.mad = getMedian(std::move(deviations));
+    return spread;
+}
+
+
+// The repetitions of one benchmark, times in nanoseconds
+struct Samples
+{
+    std::vector<double> realTimes;
+    std::vector<double> cpuTimes;
+    std::map<std::string, std::vector<double>> counters;
+};
+
+using Runs = std::map<std::string, Samples>;
+
+
+inline double toNanoseconds(double time, std::string_view unit)
+{
+    if (unit == "us")
+    {
+        return time * 1e3;
+    }
+    if (unit == "ms")
+    {
+        return time * 1e6;
+    }
+    if (unit == "s")
+    {
+        return time * 1e9;
+    }
+    return time;
+}
+
+
+// Adds the repetitions from the output of a benchmark binary run with
+// --benchmark_format=json. The aggregates google benchmark computes itself
+// are skipped, every number that is not part of the run description is a
+// counter (allocs_per_iter, bytes_per_second, user counters).
+inline void collectRuns(const Json& output, Runs& runs)
+{
+    static const std::vector<std::string_view> fields{"family_index", "per_family_instance_index",
+        "repetitions", "repetition_index", "threads", "iterations", "real_time", "cpu_time"};
+
+    const Json* benchmarks = output.find("benchmarks");
+    if (!benchmarks)
+    {
+        throw std::runtime_error("No benchmarks in the results");
+    }
+    for (const Json& benchmark : benchmarks->asArray())
+    {
+        const Json* runType = benchmark.find("run_type");
+        if (runType && runType->asString() != "iteration")
+        {
+            continue;
+        }
+        if (const Json* skipped = benchmark.find("error_occurred"); skipped && skipped->asBool())
+        {
+            continue;
+        }
+
+        const Json* name = benchmark.find("run_name");
+        if (!name && !(name = benchmark.find("name")))
+        {
+            throw std::runtime_error("Benchmark without a name in the results");
+        }
+        const Json* unit = benchmark.find("time_unit");
+        std::string_view timeUnit = unit ? std::string_view(unit->asString()) : "ns";
+
+        Samples& samples = runs[name->asString()];
+        for (const auto& [key, value] : benchmark.asObject())
+        {
+            if (key == "real_time")
+            {
+                samples.realTimes.push_back(toNanoseconds(value.asNumber(), timeUnit));
+            }
+            else if (key == "cpu_time")
+            {
+                samples.cpuTimes.push_back(toNanoseconds(value.asNumber(), timeUnit));
+            }
+            else if (value.isNumber() && std::find(fields.begin(), fields.end(), key) == fields.end())
+            {
+                samples.counters[key].push_back(value.asNumber());
+            }
+        }
+    }
+}
+
+
+struct Entry
+{
+    size_t repetitions{0};
+    Spread realTime;
+    Spread cpuTime;
+    std::map<std::string, Spread> counters;
+    // Separate runs of the benchmark binary and the spread of their median
+    // real times. The machine drifts more from run to run than within one.
+    size_t rounds{1};
+    Spread runToRun;
+    // Overrides the threshold of the gate, kept when the baseline is
+    // recorded again
+    std::optional<double> threshold;
+};
+
+
+// Benchmark results to compare later runs against. The context tells on
+// what machine they were recorded, comparing against a baseline from
+// another machine says little.
+struct Baseline
+{
+    static constexpr int version = 1;
+
+    Json context;
+    std::map<std::string, Entry> benchmarks;
+};
+
+
+inline Baseline summarize(const Runs& runs, Json context = Json())
+{
+    Baseline baseline;
+    baseline.context = std::move(context);
+    for (const auto& [name, samples] : runs)
+    {
+        Entry& entry = baseline.benchmarks[name];
+        entry.repetitions = samples.realTimes.size();
+        entry.realTime = getSpread(samples.realTimes);
+        entry.cpuTime = getSpread(samples.cpuTimes);
+        for (const auto& [counter, values] : samples.counters)
+        {
+            entry.counters[counter] = getSpread(values);
+        }
+    }
+    return baseline;
+}
+
+
+// Keeps the faster of the two results of each benchmark. A slower run was
+// most likely one the machine was busy with something else in.
+inline void keepFastest(Baseline& current, const Baseline& rerun)
+{
+    for (const auto& [name, entry] : rerun.benchmarks)
+    {
+        auto [it, inserted] = current.benchmarks.try_emplace(name, entry);
+        if (!inserted && entry.realTime.median < it->second.realTime.median)
+        {
+            it->second = entry;
+        }
+    }
+}
+
+
+// The fastest of several runs of the benchmark binary, with how far the
+// medians of the runs are apart
+inline Baseline summarize(const std::vector<Runs>& rounds, Json context = Json())
+{
+    Baseline baseline;
+    baseline.context = std::move(context);
+    std::map<std::string, std::vector<double>> medians;
+    for (const Runs& runs : rounds)
+    {
+        Baseline round = summarize(runs);
+        keepFastest(baseline, round);
+        for (const auto& [name, entry] : round.benchmarks)
+        {
+            medians[name].push_back(entry.realTime.median);
+        }
+    }
+    for (auto& [name, entry] : baseline.benchmarks)
+    {
+        entry.rounds = medians[name].size();
+        entry.runToRun = getSpread(medians[name]);
+    }
+    return baseline;
+}
+
+
+// Thresholds set by hand in the old baseline survive a new recording
+inline void keepThresholds(Baseline& baseline, const Baseline& previous)
+{
+    for (auto& [name, entry] : baseline.benchmarks)
+    {
+        auto it = previous.benchmarks.find(name);
+        if (it != previous.benchmarks.end() && !entry.threshold)
+        {
+            entry.threshold = it->second.threshold;
+        }
+    }
+}
+
+
+inline Json toJson(const Spread& spread)
+{
+    Json json;
+    json["median"] = spread.median;
+    json["mad"] = spread.mad;
+    return json;
+}
+
+
+inline Spread toSpread(const Json& json)
+{
+    return {json.find("median") ? json.find("median")->asNumber() : 0, json.find("mad") ? json.find("mad")->asNumber() : 0};
+}
+
+
+inline Json toJson(const Baseline& baseline)
+{
+    Json json;
+    json["version"] = Baseline::version;
+    json["context"] = baseline.context.isNull() ? Json(Json::Object()) : baseline.context;
+    Json& benchmarks = json["benchmarks"] = Json::Object();
+    for (const auto& [name, entry] : baseline.benchmarks)
+    {
+        Json& benchmark = benchmarks[name];
+        benchmark["repetitions"] = entry.repetitions;
+        benchmark["real_time_ns"] = toJson(entry.realTime);
+        benchmark["cpu_time_ns"] = toJson(entry.cpuTime);
+        Json& counters = benchmark["counters"] = Json::Object();
+        for (const auto& [counter, spread] : entry.counters)
+        {
+            counters[counter] = toJson(spread);
+        }
+        benchmark["rounds"] = entry.rounds;
+        benchmark["run_to_run_ns"] = toJson(entry.runToRun);
+        if (entry.threshold)
+        {
+            benchmark["threshold"] = *entry.threshold;
+        }
+    }
+    return json;
+}
+
+
+inline Baseline toBaseline(const Json& json)
+{
+    const Json* version = json.find("version");
+    if (!version || version->asNumber() != Baseline::version)
+    {
+        throw std::runtime_error("Unsupported baseline version");
+    }
+
+    Baseline baseline;
+    if (const Json* context = json.find("context"))
+    {
+        baseline.context = *context;
+    }
+    if (const Json* benchmarks = json.find("benchmarks"))
+    {
+        for (const auto& [name, benchmark] : benchmarks->asObject())
+        {
+            Entry& entry = baseline.benchmarks[name];
+            if (const Json* repetitions = benchmark.find("repetitions"))
+            {
+                entry.repetitions = static_cast<size_t>(repetitions->asNumber());
+            }
+            if (const Json* realTime = benchmark.find("real_time_ns"))
+            {
+                entry.realTime = toSpread(*realTime);
+            }
+            if (const Json* cpuTime = benchmark.find("cpu_time_ns"))
+            {
+                entry.cpuTime = toSpread(*cpuTime);
+            }
+            if (const Json* counters = benchmark.find("counters"))
+            {
+                for (const auto& [counter, spread] : counters->asObject())
+                {
+                    entry.counters[counter] = toSpread(spread);
+                }
+            }
+            if (const Json* rounds = benchmark.find("rounds"))
+            {
+                entry.rounds = static_cast<size_t>(rounds->asNumber());
+            }
+            if (const Json* runToRun = benchmark.find("run_to_run_ns"))
+            {
+                entry.runToRun = toSpread(*runToRun);
+            }
+            if (const Json* threshold = benchmark.find("threshold"))
+            {
+                entry.threshold = threshold->asNumber();
+            }
+        }
+    }
+    return baseline;
+}
+
+
+inline Json readJson(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot read " + path.string());
+    }
+    std::string text(std::istreambuf_iterator<char>(file), {});
+    return Json::parse(text);
+}
+
+
+inline Baseline loadBaseline(const std::filesystem::path& path)
+{
+    return toBaseline(readJson(path));
+}
+
+
+inline void saveBaseline(const std::filesystem::path& path, const Baseline& baseline)
+{
+    std::ofstream file(path);
+    file << toJson(baseline) << '\n';
+    if (!file)
+    {
+        throw std::runtime_error("Cannot write " + path.string());
+    }
+}
+
+
+// The parts of a benchmark context that describe the machine and the
+// build, what changes with every run like the date and the load is left out
+inline const std::vector<std::string_view>& getMachineKeys()
+{
+    static const std::vector<std::string_view> keys{"host_name", "num_cpus", "mhz_per_cpu",
+        "cpu_scaling_enabled", "library_build_type"};
+    return keys;
+}
+
+
+inline Json getMachine(const Json& context)
+{
+    Json machine = Json::Object();
+    for (std::string_view key : getMachineKeys())
+    {
+        if (const Json* value = context.find(key))
+        {
+            machine[key] = *value;
+        }
+    }
+    return machine;
+}
+
+
+// How the machines or builds of two contexts differ, one line per key.
+// Virtual machines report a slightly different clock from boot to boot, a
+// tenth more or less is still the same CPU.
+inline std::vector<std::string> findMachineMismatches(const Json& baseline, const Json& current)
+{
+    constexpr double clockTolerance = 0.1;
+    auto toText = [](const Json* value) {
+        if (!value)
+        {
+            return std::string("none");
+        }
+        std::ostringstream text;
+        text << *value;
+        return text.str();
+    };
+
+    std::vector<std::string> mismatches;
+    for (std::string_view key : getMachineKeys())
+    {
+        const Json* before = baseline.isObject() ? baseline.find(key) : nullptr;
+        const Json* after = current.isObject() ? current.find(key) : nullptr;
+        bool same = toText(before) == toText(after);
+        if (!same && key == "mhz_per_cpu" && before && after && before->isNumber() && after->isNumber())
+        {
+            same = std::abs(after->asNumber() / before->asNumber() - 1) <= clockTolerance;
+        }
+        if (!same)
+        {
+            mismatches.push_back(std::string(key) + ": " + toText(before) + " -> " + toText(after));
+        }
+    }
+    return mismatches;
+}
+
+
+struct GateOptions
+{
+    // Relative slowdown that counts as a regression unless the baseline
+    // sets its own threshold for a benchmark
+    double threshold{0.1};
+    // The change also has to exceed this many times the noise of both
+    // runs, so that noisy benchmarks do not fail the gate at random
+    double noise{3};
+};
+
+
+enum class Verdict
+{
+    unchanged,
+    improved,
+    regressed,
+    // Only in the current run
+    added,
+    // Only in the baseline, fails the gate like a regression
+    missing
+};
+
+
+inline const char* toString(Verdict verdict)
+{
+    switch (verdict)
+    {
+        case Verdict::unchanged: return "unchanged";
+        case Verdict::improved: return "improved";
+        case Verdict::regressed: return "REGRESSED";
+        case Verdict::added: return "new";
+        case Verdict::missing: return "MISSING";
+    }
+    return "";
+}
+
+
+struct Comparison
+{
+    std::string benchmark;
+    // real_time_ns or one of the allocation counters
+    std::string metric;
+    double baseline{0};
+    double current{0};
+    double threshold{0};
+    Verdict verdict{Verdict::unchanged};
+
+    // Relative change, 0.5 for 50% more
+    double getChange() const
+    {
+        return baseline != 0 ? current / baseline - 1 : 0;
+    }
+};
+
+
+// The metrics the gate looks at, lower is better for all of them. Rates
+// follow the time, other user counters may go either way.
+inline const std::vector<std::string_view>& getGatedCounters()
+{
+    static const std::vector<std::string_view> counters{"allocs_per_iter", "max_bytes_used"};
+    return counters;
+}
+
+
+// Scale of the median absolute deviation of normally distributed values
+// to their standard deviation
+constexpr double madToSigma = 1.4826;
+
+inline Verdict judge(const Spread& baseline, const Spread& current, double threshold, double noise)
+{
+    double margin = noise * madToSigma * (baseline.mad + current.mad);
+    double difference = current.median - baseline.median;
+    if (difference > baseline.median * threshold && difference > margin)
+    {
+        return Verdict::regressed;
+    }
+    if (-difference > baseline.median * threshold && -difference > margin)
+    {
+        return Verdict::improved;
+    }
+    return Verdict::unchanged;
+}
+
+
+inline std::vector<Comparison> compare(const Baseline& baseline, const Baseline& current, const GateOptions& options = {})
+{
+    std::vector<Comparison> comparisons;
+    for (const auto& [name, entry] : baseline.benchmarks)
+    {
+        double threshold = entry.threshold.value_or(options.threshold);
+        auto it = current.benchmarks.find(name);
+        if (it == current.benchmarks.end())
+        {
+            comparisons.push_back({name, "real_time_ns", entry.realTime.median, 0, threshold, Verdict::missing});
+            continue;
+        }
+
+        // A time has to stand out from the noise between runs as well
+        const Entry& now = it->second;
+        Spread realTime{entry.realTime.median, std::max(entry.realTime.mad, entry.runToRun.mad)};
+        comparisons.push_back({name, "real_time_ns", entry.realTime.median, now.realTime.median, threshold,
+            judge(realTime, now.realTime, threshold, options.noise)});
+        for (std::string_view counter : getGatedCounters())
+        {
+            auto before = entry.counters.find(std::string(counter));
+            auto after = now.counters.find(std::string(counter));
+            if (before != entry.counters.end() && after != now.counters.end())
+            {
+                comparisons.push_back({name, std::string(counter), before->second.median, after->second.median, threshold,
+                    judge(before->second, after->second, threshold, options.noise)});
+            }
+        }
+    }
+    for (const auto& [name, entry] : current.benchmarks)
+    {
+        if (!baseline.benchmarks.count(name))
+        {
+            comparisons.push_back({name, "real_time_ns", 0, entry.realTime.median, options.threshold, Verdict::added});
+        }
+    }
+    return comparisons;
+}
+
+
+inline bool hasRegressions(const std::vector<Comparison>& comparisons)
+{
+    return std::any_of(comparisons.begin(), comparisons.end(),
+        [](const Comparison& comparison) { return comparison.verdict == Verdict::regressed; });
+}
+
+
+// Regressions and benchmarks that went missing fail the gate, a benchmark
+// that is renamed or removed needs a new baseline
+inline bool failsGate(const std::vector<Comparison>& comparisons)
+{
+    return std::any_of(comparisons.begin(), comparisons.end(), [](const Comparison& comparison) {
+        return comparison.verdict == Verdict::regressed || comparison.verdict == Verdict::missing;
+    });
+}
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Random.hpp"
+
+namespace benchmarking
+{
+// Seed of the synthetic inputs used by the benchmarks. It is fixed so that
+// results of different runs and builds can be compared.
+constexpr std::uint64_t defaultSeed = 1;
+}
@@ -0,0 +1,495 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace benchmarking
+{
+// Just enough JSON to read the output of google benchmark and to read and
+// write baselines. Objects keep their keys sorted, so written files diff
+// well.
+class Json
+{
+public:
+    using Array = std::vector<Json>;
+    using Object = std::map<std::string, Json, std::less<>>;
+
+    Json() = default;
+
+    Json(std::nullptr_t)
+    {
+    }
+
+    Json(bool value) :
+        value(value)
+    {
+    }
+
+    template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>>
+    Json(T value) :
+        value(static_cast<double>(value))
+    {
+    }
+
+    Json(std::string value) :
+        value(std::move(value))
+    {
+    }
+
+    Json(const char* value) :
+        value(std::string(value))
+    {
+    }
+
+    Json(Array value) :
+        value(std::move(value))
+    {
+    }
+
+    Json(Object value) :
+        value(std::move(value))
+    {
+    }
+
+    bool isNull() const
+    {
+        return std::holds_alternative<std::nullptr_t>(value);
+    }
+
+    bool isBool() const
+    {
+        return std::holds_alternative<bool>(value);
+    }
+
+    bool isNumber() const
+    {
+        return std::holds_alternative<double>(value);
+    }
+
+    bool isString() const
+    {
+        return std::holds_alternative<std::string>(value);
+    }
+
+    bool isArray() const
+    {
+        return std::holds_alternative<Array>(value);
+    }
+
+    bool isObject() const
+    {
+        return std::holds_alternative<Object>(value);
+    }
+
+    bool asBool() const
+    {
+        return get<bool>("a boolean");
+    }
+
+    double asNumber() const
+    {
+        return get<double>("a number");
+    }
+
+    const std::string& asString() const
+    {
+        return get<std::string>("a string");
+    }
+
+    const Array& asArray() const
+    {
+        return get<Array>("an array");
+    }
+
+    const Object& asObject() const
+    {
+        return get<Object>("an object");
+    }
+
+    // Turns null into an empty object
+    Json& operator[](std::string_view key)
+    {
+        if (isNull())
+        {
+            value = Object();
+        }
+        auto& object = std::get<Object>(value);
+        auto it = object.find(key);
+        if (it == object.end())
+        {
+            it = object.emplace(std::string(key), Json()).first;
+        }
+        return it->second;
+    }
+
+    // nullptr if this is no object or has no such member
+    const Json* find(std::string_view key) const
+    {
+        if (!isObject())
+        {
+            return nullptr;
+        }
+        const auto& object = std::get<Object>(value);
+        auto it = object.find(key);
+        return it != object.end() ? &it->second : nullptr;
+    }
+
+    static Json parse(std::string_view text)
+    {
+        Parser parser{text};
+        Json json = parser.parseValue();
+        parser.skipSpace();
+        if (parser.pos != text.size())
+        {
+            parser.fail("Unexpected text after the JSON value");
+        }
+        return json;
+    }
+
+    // Pretty printed with two spaces per level
+    void write(std::ostream& out, int indent = 0) const
+    {
+        std::string padding(indent + 2, ' ');
+        if (isNull())
+        {
+            out << "null";
+        }
+        else if (isBool())
+        {
+            out << (asBool() ? "true" : "false");
+        }
+        else if (isNumber())
+        {
+            writeNumber(out, asNumber());
+        }
+        else if (isString())
+        {
+            writeString(out, asString());
+        }
+        else if (isArray())
+        {
+            const auto& array = asArray();
+            out << '[';
+            for (size_t i = 0; i < array.size(); ++i)
+            {
+                out << (i > 0 ? "," : "") << '\n' << padding;
+                array[i].write(out, indent + 2);
+            }
+            closeBlock(out, array.empty(), indent);
+            out << ']';
+        }
+        else
+        {
+            const auto& object = asObject();
+            out << '{';
+            bool first = true;
+            for (const auto& [key, member] : object)
+            {
+                out << (first ? "" : ",") << '\n' << padding;
+                writeString(out, key);
+                out << ": ";
+                member.write(out, indent + 2);
+                first = false;
+            }
+            closeBlock(out, object.empty(), indent);
+            out << '}';
+        }
+    }
+
+private:
+    template<typename T>
+    const T& get(const char* expected) const
+    {
+        if (!std::holds_alternative<T>(value))
+        {
+            throw std::runtime_error(std::string("JSON value is not ") + expected);
+        }
+        return std::get<T>(value);
+    }
+
+    static void closeBlock(std::ostream& out, bool isEmpty, int indent)
+    {
+        if (!isEmpty)
+        {
+            out << '\n' << std::string(indent, ' ');
+        }
+    }
+
+    static void writeNumber(std::ostream& out, double number)
+    {
+        if (!std::isfinite(number))
+        {
+            out << "null";
+            return;
+        }
+        // Shortest representation that reads back to the same double
+        char buffer[32];
+        auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+        out << std::string_view(buffer, end - buffer);
+    }
+
+    static void writeString(std::ostream& out, std::string_view text)
+    {
+        out << '"';
+        for (char c : text)
+        {
+            switch (c)
+            {
+                case '"':  out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char code[8];
+                        std::snprintf(code, sizeof(code), "\\u%04x", c);
+                        out << code;
+                    }
+                    else
+                    {
+                        out << c;
+                    }
+            }
+        }
+        out << '"';
+    }
+
+    struct Parser
+    {
+        std::string_view text;
+        size_t pos = 0;
+
+        [[noreturn]] void fail(const char* message) const
+        {
+            throw std::runtime_error(std::string(message) + " at offset " + std::to_string(pos));
+        }
+
+        void skipSpace()
+        {
+            while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' || text[pos] == '\t'))
+            {
+                pos++;
+            }
+        }
+
+        bool consume(std::string_view token)
+        {
+            if (text.substr(pos, token.size()) == token)
+            {
+                pos += token.size();
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char c)
+        {
+            skipSpace();
+            if (pos >= text.size() || text[pos] != c)
+            {
+                fail("Unexpected character in JSON");
+            }
+            pos++;
+        }
+
+        Json parseValue()
+        {
+            skipSpace();
+            if (pos >= text.size())
+            {
+                fail("Unexpected end of JSON");
+            }
+            char c = text[pos];
+            if (c == '{')
+            {
+                return parseObject();
+            }
+            if (c == '[')
+            {
+                return parseArray();
+            }
+            if (c == '"')
+            {
+                return parseString();
+            }
+            if (consume("true"))
+            {
+                return true;
+            }
+            if (consume("false"))
+            {
+                return false;
+            }
+            if (consume("null"))
+            {
+                return nullptr;
+            }
+            return parseNumber();
+        }
+
+        Json parseObject()
+        {
+            Object object;
+            expect('{');
+            skipSpace();
+            if (consume("}"))
+            {
+                return object;
+            }
+            do
+            {
+                skipSpace();
+                std::string key = parseString();
+                expect(':');
+                object.insert_or_assign(std::move(key), parseValue());
+                skipSpace();
+            }
+            while (consume(","));
+            expect('}');
+            return object;
+        }
+
+        Json parseArray()
+        {
+            Array array;
+            expect('[');
+            skipSpace();
+            if (consume("]"))
+            {
+                return array;
+            }
+            do
+            {
+                array.push_back(parseValue());
+                skipSpace();
+            }
+            while (consume(","));
+            expect(']');
+            return array;
+        }
+
+        std::string parseString()
+        {
+            expect('"');
+            std::string result;
+            while (true)
+            {
+                if (pos >= text.size())
+                {
+                    fail("Unterminated JSON string");
+                }
+                char c = text[pos++];
+                if (c == '"')
+                {
+                    return result;
+                }
+                if (c != '\\')
+                {
+                    result += c;
+                    continue;
+                }
+                if (pos >= text.size())
+                {
+                    fail("Unterminated JSON string");
+                }
+                switch (char escaped = text[pos++])
+                {
+                    case 'b': result += '\b'; break;
+                    case 'f': result += '\f'; break;
+                    case 'n': result += '\n'; break;
+                    case 'r': result += '\r'; break;
+                    case 't': result += '\t'; break;
+                    case 'u': appendUtf8(result, parseCodePoint()); break;
+                    default: result += escaped;
+                }
+            }
+        }
+
+        std::uint32_t parseHex4()
+        {
+            std::uint32_t code = 0;
+            if (pos + 4 > text.size() ||
+                std::from_chars(text.data() + pos, text.data() + pos + 4, code, 16).ptr != text.data() + pos + 4)
+            {
+                fail("Invalid \\u escape in JSON string");
+            }
+            pos += 4;
+            return code;
+        }
+
+        std::uint32_t parseCodePoint()
+        {
+            std::uint32_t code = parseHex4();
+            // A high surrogate followed by a low one
+            if (code >= 0xd800 && code < 0xdc00 && consume("\\u"))
+            {
+                std::uint32_t low = parseHex4();
+                code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+            }
+            return code;
+        }
+
+        static void appendUtf8(std::string& text, std::uint32_t code)
+        {
+            if (code < 0x80)
+            {
+                text += static_cast<char>(code);
+            }
+            else if (code < 0x800)
+            {
+                text += static_cast<char>(0xc0 | (code >> 6));
+                text += static_cast<char>(0x80 | (code & 0x3f));
+            }
+            else if (code < 0x10000)
+            {
+                text += static_cast<char>(0xe0 | (code >> 12));
+                text += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                text += static_cast<char>(0x80 | (code & 0x3f));
+            }
+            else
+            {
+                text += static_cast<char>(0xf0 | (code >> 18));
+                text += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+                text += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                text += static_cast<char>(0x80 | (code & 0x3f));
+            }
+        }
+
+        Json parseNumber()
+        {
+            double number = 0;
+            const char* begin = text.data() + pos;
+            // from_chars does not accept a leading plus, JSON neither
+            auto [end, error] = std::from_chars(begin, text.data() + text.size(), number);
+            if (error != std::errc() || end == begin)
+            {
+                fail("Invalid JSON value");
+            }
+            pos += end - begin;
+            return number;
+        }
+    };
+
+    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> value;
+};
+
+
+inline std::ostream& operator<<(std::ostream& out, const Json& json)
+{
+    json.write(out);
+    return out;
+}
+}
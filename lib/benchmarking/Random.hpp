@@ -0,0 +1,60 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+namespace benchmarking
+{
+// Small seeded generator for synthetic inputs. The standard distributions
+// are implementation defined, so everything is derived from the raw
+// SplitMix64 stream to get the same inputs from every compiler.
+class Random
+{
+public:
+    explicit Random(std::uint64_t seed) : state(seed)
+    {
+    }
+
+    std::uint64_t next()
+    {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [low, high], the modulo bias is irrelevant for the ranges
+    // used by the generators.
+    template<std::integral T>
+    T between(T low, T high)
+    {
+        std::uint64_t range = static_cast<std::uint64_t>(high) - static_cast<std::uint64_t>(low) + 1;
+        return static_cast<T>(static_cast<std::uint64_t>(low) + (range == 0 ? next() : next() % range));
+    }
+
+    bool chance(double probability)
+    {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53 < probability;
+    }
+
+    template<typename Container>
+    auto& pick(Container& container)
+    {
+        return container[between<size_t>(0, std::size(container) - 1)];
+    }
+
+    template<std::random_access_iterator It>
+    void shuffle(It first, It last)
+    {
+        for (auto n = last - first; n > 1; --n)
+        {
+            std::swap(first[n - 1], first[between<decltype(n)>(0, n - 1)]);
+        }
+    }
+
+private:
+    std::uint64_t state;
+};
+}
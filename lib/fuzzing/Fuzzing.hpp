@@ -0,0 +1,267 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Random.hpp"
+
+// Deterministic differential fuzzing: a target generates random cases of
+// growing size, checks an optimised engine against a reference oracle on
+// each of them and shrinks a case that fails to a minimal counterexample.
+//
+// A target is any type with
+//
+//     using Case = ...;
+//     Case generate(benchmarking::Random& random, size_t size) const;
+//     // What differs between engine and oracle, nullopt if they agree
+//     std::optional<std::string> check(const Case& input) const;
+//     // Smaller variants of the case, the most aggressive ones first
+//     std::vector<Case> shrink(const Case& input) const;
+//     // The case as puzzle input
+//     std::string format(const Case& input) const;
+//
+// Every case is generated from a seed of its own, so a failure is
+// reproduced by generating the case with its seed and size again.
+namespace fuzzing
+{
+struct Options
+{
+    std::uint64_t seed{1};
+    // Stops after numOfCases or timeLimit, whichever comes first
+    size_t numOfCases{1000};
+    std::chrono::nanoseconds timeLimit{std::chrono::nanoseconds::max()};
+    // The size of the cases goes from 1 to maxSize and starts over, most
+    // bugs show up in small cases, which are also the fastest
+    size_t maxSize{64};
+    // Checks of shrunk candidates before the smallest failing case so far
+    // is reported
+    size_t maxShrinkSteps{10000};
+};
+
+
+template<typename Case>
+struct Failure
+{
+    Case original;
+    Case minimal;
+    // What differs on the minimal case
+    std::string message;
+    std::uint64_t seed{0};
+    size_t size{0};
+    size_t shrinkSteps{0};
+};
+
+
+template<typename Case>
+struct Outcome
+{
+    size_t numOfCases{0};
+    std::chrono::nanoseconds time{0};
+    std::optional<Failure<Case>> failure;
+
+    double getCasesPerSecond() const
+    {
+        double seconds = std::chrono::duration<double>(time).count();
+        return seconds > 0 ? static_cast<double>(numOfCases) / seconds : 0.0;
+    }
+};
+
+
+template<typename Target>
+using CaseOf = typename Target::Case;
+
+
+// The seed of case index of a run, spread so that neighbouring cases share
+// nothing
+inline std::uint64_t getCaseSeed(std::uint64_t seed, size_t index)
+{
+    return benchmarking::Random(seed ^ (static_cast<std::uint64_t>(index) * 0xD1B54A32D192ED03ull)).next();
+}
+
+
+template<typename Target>
+CaseOf<Target> generateCase(const Target& target, std::uint64_t caseSeed, size_t size)
+{
+    benchmarking::Random random(caseSeed);
+    return target.generate(random, size);
+}
+
+
+// An exception in the engine or the oracle fails the case as well
+template<typename Target>
+std::optional<std::string> checkCase(const Target& target, const CaseOf<Target>& input)
+{
+    try
+    {
+        return target.check(input);
+    }
+    catch (const std::exception& e)
+    {
+        std::string message = "threw: ";
+        message += e.what();
+        return message;
+    }
+}
+
+
+// Greedy minimisation: takes the first candidate that still fails and
+// starts over from it until no candidate fails.
+template<typename Target>
+void shrinkFailure(const Target& target, Failure<CaseOf<Target>>& failure, size_t maxSteps)
+{
+    bool shrunk = true;
+    while (shrunk && failure.shrinkSteps < maxSteps)
+    {
+        shrunk = false;
+        for (auto& candidate : target.shrink(failure.minimal))
+        {
+            if (++failure.shrinkSteps > maxSteps)
+            {
+                break;
+            }
+            if (auto message = checkCase(target, candidate))
+            {
+                failure.minimal = std::move(candidate);
+                failure.message = std::move(*message);
+                shrunk = true;
+                break;
+            }
+        }
+    }
+}
+
+
+// Checks cases until the first one fails, which is then minimised
+template<typename Target>
+Outcome<CaseOf<Target>> fuzz(const Target& target, const Options& options = {})
+{
+    Outcome<CaseOf<Target>> outcome;
+    auto start = std::chrono::steady_clock::now();
+    size_t maxSize = options.maxSize > 0 ? options.maxSize : 1;
+
+    for (size_t i = 0; i < options.numOfCases; ++i)
+    {
+        if (std::chrono::steady_clock::now() - start >= options.timeLimit)
+        {
+            break;
+        }
+
+        std::uint64_t caseSeed = getCaseSeed(options.seed, i);
+        size_t size = 1 + i % maxSize;
+        auto input = generateCase(target, caseSeed, size);
+        ++outcome.numOfCases;
+        if (auto message = checkCase(target, input))
+        {
+            Failure<CaseOf<Target>> failure{input, input, std::move(*message), caseSeed, size, 0};
+            shrinkFailure(target, failure, options.maxShrinkSteps);
+            outcome.failure = std::move(failure);
+            break;
+        }
+    }
+
+    outcome.time = std::chrono::steady_clock::now() - start;
+    return outcome;
+}
+
+
+// "day05  12000 cases  0.412 s  29126 cases/s  ok", a failure adds the
+// minimal counterexample as puzzle input and how to reproduce it
+template<typename Target>
+std::string describe(std::string_view name, const Target& target, const Outcome<CaseOf<Target>>& outcome)
+{
+    std::ostringstream text;
+    text.setf(std::ios::fixed);
+    text.precision(3);
+    text << name << "  " << outcome.numOfCases << " cases  "
+        << std::chrono::duration<double>(outcome.time).count() << " s  ";
+    text.precision(0);
+    text << outcome.getCasesPerSecond() << " cases/s  ";
+    if (!outcome.failure)
+    {
+        text << "ok\n";
+        return text.str();
+    }
+
+    const auto& failure = *outcome.failure;
+    text << "FAILED\n"
+        << "  " << failure.message << '\n'
+        << "  case seed " << failure.seed << " size " << failure.size
+        << ", shrunk in " << failure.shrinkSteps << " steps to:\n"
+        << target.format(failure.minimal);
+    return text.str();
+}
+
+
+// Candidates for a shrunk sequence: without a chunk of half, a quarter, ...
+// of its elements down to single elements, at every position
+template<typename Sequence>
+std::vector<Sequence> removeChunks(const Sequence& sequence, size_t minSize = 0)
+{
+    std::vector<Sequence> candidates;
+    size_t size = sequence.size();
+    if (size <= minSize)
+    {
+        return candidates;
+    }
+    for (size_t chunk = std::min(size / 2, size - minSize); chunk > 0; chunk /= 2)
+    {
+        for (size_t begin = 0; begin + chunk <= size; begin += chunk)
+        {
+            Sequence candidate;
+            candidate.insert(candidate.end(), sequence.begin(), sequence.begin() + begin);
+            candidate.insert(candidate.end(), sequence.begin() + begin + chunk, sequence.end());
+            candidates.push_back(std::move(candidate));
+        }
+    }
+    if (size == 1 && minSize == 0)
+    {
+        candidates.push_back(Sequence());
+    }
+    return candidates;
+}
+
+
+// Candidates for a smaller integer: the minimum, then halfway and one less
+template<typename T>
+std::vector<T> shrinkInteger(T value, T minimum)
+{
+    std::vector<T> candidates;
+    if (value <= minimum)
+    {
+        return candidates;
+    }
+    candidates.push_back(minimum);
+    T half = minimum + (value - minimum) / 2;
+    if (half != minimum)
+    {
+        candidates.push_back(half);
+    }
+    if (value - 1 != half && value - 1 != minimum)
+    {
+        candidates.push_back(value - 1);
+    }
+    return candidates;
+}
+
+
+// "expected 12, got 13" for values that differ
+template<typename T>
+std::optional<std::string> expectEqual(const T& expected, const T& actual)
+{
+    if (expected == actual)
+    {
+        return std::nullopt;
+    }
+    std::ostringstream message;
+    message << "expected " << expected << ", got " << actual;
+    return message.str();
+}
+}
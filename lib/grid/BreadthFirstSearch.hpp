@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+#include "Arena.hpp"
+#include "Grid.hpp"
+
+namespace grid
+{
+// Breadth-first search over the cells of a grid, addressed by index. The
+// grid needs a padding of at least one cell and canEnter has to reject
+// the border, the search itself does no bounds checks.
+//
+// All buffers are allocated once for the dimensions of the grid, from
+// allocations::getResource() like the grid. Cells are
+// marked as reached with the number of the current search, so starting a
+// search costs nothing no matter how large the grid is. Every cell enters
+// the frontier at most once, so the frontier is a preallocated array that
+// is read from the front while being appended to.
+//
+// Sources are expanded in the order they are given and neighbors in
+// reading order. With the sources sorted by index, among equally short
+// paths a cell is reached from the source first in reading order and then
+// by the path whose first step is first in reading order.
+class BreadthFirstSearch
+{
+public:
+    static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+    BreadthFirstSearch() :
+        stamps(allocations::getResource()),
+        distances(allocations::getResource()),
+        parents(allocations::getResource()),
+        frontier(allocations::getResource())
+    {
+    }
+
+    template<typename T>
+    explicit BreadthFirstSearch(const Grid<T>& grid) :
+        offsets(grid.getNeighborOffsets()),
+        stamps(grid.getCells().size(), 0, allocations::getResource()),
+        distances(grid.getCells().size(), allocations::getResource()),
+        parents(grid.getCells().size(), allocations::getResource()),
+        frontier(grid.getCells().size(), allocations::getResource())
+    {
+        assert(grid.getPadding() > 0);
+    }
+
+    // Copies allocate from the current resource like new searches, not from
+    // the one of the original
+    BreadthFirstSearch(const BreadthFirstSearch& other) :
+        offsets(other.offsets),
+        stamps(other.stamps, allocations::getResource()),
+        distances(other.distances, allocations::getResource()),
+        parents(other.parents, allocations::getResource()),
+        frontier(other.frontier, allocations::getResource()),
+        epoch(other.epoch),
+        numOfReached(other.numOfReached)
+    {
+    }
+
+    BreadthFirstSearch(BreadthFirstSearch&&) = default;
+    BreadthFirstSearch& operator=(const BreadthFirstSearch&) = default;
+    BreadthFirstSearch& operator=(BreadthFirstSearch&&) = default;
+
+    template<typename CanEnter>
+    void run(size_t source, CanEnter canEnter)
+    {
+        run(std::span<const size_t>(&source, 1), canEnter);
+    }
+
+    // canEnter(index) tells whether the search may step onto a cell, the
+    // sources are entered regardless.
+    template<typename CanEnter>
+    void run(std::span<const size_t> sources, CanEnter canEnter)
+    {
+        startSearch();
+        size_t head = 0;
+        size_t tail = 0;
+        for (size_t source : sources)
+        {
+            if (stamps[source] != epoch)
+            {
+                reach(source, none, 0);
+                frontier[tail++] = source;
+            }
+        }
+
+        while (head < tail)
+        {
+            size_t current = frontier[head++];
+            int distance = distances[current] + 1;
+            for (std::ptrdiff_t offset : offsets)
+            {
+                size_t next = current + offset;
+                if (stamps[next] != epoch && canEnter(next))
+                {
+                    reach(next, current, distance);
+                    frontier[tail++] = next;
+                }
+            }
+        }
+        numOfReached = tail;
+    }
+
+    bool isReached(size_t index) const
+    {
+        return stamps[index] == epoch;
+    }
+
+    // -1 for cells the last search did not reach
+    int getDistance(size_t index) const
+    {
+        return isReached(index) ? distances[index] : -1;
+    }
+
+    // The cell the search came from, none for sources and cells that were
+    // not reached
+    size_t getParent(size_t index) const
+    {
+        return isReached(index) ? parents[index] : none;
+    }
+
+    size_t getSource(size_t index) const
+    {
+        if (!isReached(index))
+        {
+            return none;
+        }
+        while (parents[index] != none)
+        {
+            index = parents[index];
+        }
+        return index;
+    }
+
+    // The cell right after the source on the path to target, none if
+    // target is a source or was not reached
+    size_t getFirstStep(size_t target) const
+    {
+        if (!isReached(target) || parents[target] == none)
+        {
+            return none;
+        }
+        while (parents[parents[target]] != none)
+        {
+            target = parents[target];
+        }
+        return target;
+    }
+
+    // From the source to target, empty if target was not reached
+    std::vector<size_t> getPath(size_t target) const
+    {
+        std::vector<size_t> path;
+        if (isReached(target))
+        {
+            path.resize(distances[target] + 1);
+            for (auto it = path.rbegin(); it != path.rend(); ++it)
+            {
+                *it = target;
+                target = parents[target];
+            }
+        }
+        return path;
+    }
+
+    // The reached cells by increasing distance
+    std::span<const size_t> getReached() const
+    {
+        return std::span<const size_t>(frontier).first(numOfReached);
+    }
+
+private:
+    void startSearch()
+    {
+        if (++epoch == 0)
+        {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    void reach(size_t index, size_t parent, int distance)
+    {
+        stamps[index] = epoch;
+        parents[index] = parent;
+        distances[index] = distance;
+    }
+
+    std::array<std::ptrdiff_t, 4> offsets{};
+    std::pmr::vector<std::uint32_t> stamps;
+    std::pmr::vector<int> distances;
+    std::pmr::vector<size_t> parents;
+    std::pmr::vector<size_t> frontier;
+    std::uint32_t epoch = 0;
+    size_t numOfReached = 0;
+};
+}
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Arena.hpp"
+
+namespace grid
+{
+struct Position
+{
+    int x;
+    int y;
+
+    bool operator==(const Position& other) const = default;
+};
+
+inline Position operator+(Position lhs, const Position& rhs)
+{
+    return {lhs.x + rhs.x, lhs.y + rhs.y};
+}
+
+// Steps to the orthogonal neighbors in reading order: up, left, right, down
+constexpr std::array<Position, 4> orthogonalSteps{{{0, -1}, {-1, 0}, {1, 0}, {0, 1}}};
+
+// Steps to all eight neighbors in reading order
+constexpr std::array<Position, 8> allSteps{{
+    {-1, -1}, {0, -1}, {1, -1},
+    {-1,  0},          {1,  0},
+    {-1,  1}, {0,  1}, {1,  1}}};
+
+
+struct Tile
+{
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+
+// Walks a width x height area in tiles of at most tileWidth x tileHeight,
+// row of tiles by row of tiles. The tiles at the right and bottom edges
+// are clipped to the area.
+class Tiles
+{
+public:
+    class Iterator
+    {
+    public:
+        using value_type = Tile;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        Iterator(const Tiles* tiles, int x, int y) :
+            tiles(tiles),
+            x(x),
+            y(y)
+        {
+        }
+
+        Tile operator*() const
+        {
+            return {x, y, std::min(tiles->tileWidth, tiles->width - x), std::min(tiles->tileHeight, tiles->height - y)};
+        }
+
+        Iterator& operator++()
+        {
+            x += tiles->tileWidth;
+            if (x >= tiles->width)
+            {
+                x = 0;
+                y = std::min(y + tiles->tileHeight, tiles->height);
+            }
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return x == other.x && y == other.y;
+        }
+
+    private:
+        const Tiles* tiles = nullptr;
+        int x = 0;
+        int y = 0;
+    };
+
+    Tiles(int width, int height, int tileWidth, int tileHeight) :
+        width(width),
+        height(height),
+        tileWidth(tileWidth),
+        tileHeight(tileHeight)
+    {
+        if (tileWidth <= 0 || tileHeight <= 0)
+        {
+            throw std::invalid_argument("Tiles must not be empty");
+        }
+    }
+
+    Iterator begin() const
+    {
+        return width > 0 && height > 0 ? Iterator(this, 0, 0) : end();
+    }
+
+    Iterator end() const
+    {
+        return Iterator(this, 0, std::max(height, 0));
+    }
+
+private:
+    int width;
+    int height;
+    int tileWidth;
+    int tileHeight;
+};
+
+
+// Contiguous row-major 2D storage with runtime dimensions. The grid can be
+// surrounded by a border of padding cells holding a sentinel, so code that
+// looks at neighbors of the outermost cells needs no bounds checks. The
+// border cells are addressed with coordinates just outside of
+// [0, width) x [0, height).
+//
+// The cells are allocated from allocations::getResource(), so grids made
+// while solving live in the arena of the solve.
+//
+// Cells can also be addressed by index; adding one of the neighbor offsets
+// to an index moves to that neighbor, which keeps inner loops free of any
+// coordinate arithmetic.
+template<typename T>
+class Grid
+{
+    static_assert(!std::is_same_v<T, bool>, "std::vector<bool> is not contiguous, use char");
+
+public:
+    Grid() :
+        Grid(0, 0)
+    {
+    }
+
+    Grid(int width, int height, const T& value = T(), int padding = 0, const T& border = T()) :
+        width(width),
+        height(height),
+        padding(padding),
+        stride(width + 2 * padding),
+        cells(allocations::getResource())
+    {
+        if (width < 0 || height < 0 || padding < 0)
+        {
+            throw std::invalid_argument("Negative grid dimensions");
+        }
+        cells.assign(static_cast<size_t>(stride) * (height + 2 * padding), border);
+        fill(value);
+
+        for (size_t i = 0; i < orthogonalSteps.size(); ++i)
+        {
+            neighborOffsets[i] = getOffset(orthogonalSteps[i]);
+        }
+        for (size_t i = 0; i < allSteps.size(); ++i)
+        {
+            allNeighborOffsets[i] = getOffset(allSteps[i]);
+        }
+    }
+
+    // Copies allocate from the current resource like new grids, not from
+    // the one of the original
+    Grid(const Grid& other) :
+        width(other.width),
+        height(other.height),
+        padding(other.padding),
+        stride(other.stride),
+        cells(other.cells, allocations::getResource()),
+        neighborOffsets(other.neighborOffsets),
+        allNeighborOffsets(other.allNeighborOffsets)
+    {
+    }
+
+    Grid(Grid&&) = default;
+    Grid& operator=(const Grid&) = default;
+    Grid& operator=(Grid&&) = default;
+
+    int getWidth() const
+    {
+        return width;
+    }
+
+    int getHeight() const
+    {
+        return height;
+    }
+
+    int getPadding() const
+    {
+        return padding;
+    }
+
+    // Distance between vertically adjacent cells
+    std::ptrdiff_t getStride() const
+    {
+        return stride;
+    }
+
+    // Unchecked access, the border can be read as well
+    T& operator()(int x, int y)
+    {
+        return cells[getIndex(x, y)];
+    }
+
+    const T& operator()(int x, int y) const
+    {
+        return cells[getIndex(x, y)];
+    }
+
+    T& operator()(const Position& p)
+    {
+        return (*this)(p.x, p.y);
+    }
+
+    const T& operator()(const Position& p) const
+    {
+        return (*this)(p.x, p.y);
+    }
+
+    T& operator[](size_t index)
+    {
+        return cells[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return cells[index];
+    }
+
+    // Checked access to the cells inside of the border
+    T& at(int x, int y)
+    {
+        checkInside(x, y);
+        return (*this)(x, y);
+    }
+
+    const T& at(int x, int y) const
+    {
+        checkInside(x, y);
+        return (*this)(x, y);
+    }
+
+    bool isInside(int x, int y) const
+    {
+        return x >= 0 && y >= 0 && x < width && y < height;
+    }
+
+    bool isInside(const Position& p) const
+    {
+        return isInside(p.x, p.y);
+    }
+
+    size_t getIndex(int x, int y) const
+    {
+        assert(x >= -padding && y >= -padding && x < width + padding && y < height + padding);
+        return static_cast<size_t>(y + padding) * stride + (x + padding);
+    }
+
+    size_t getIndex(const Position& p) const
+    {
+        return getIndex(p.x, p.y);
+    }
+
+    Position getPosition(size_t index) const
+    {
+        return {static_cast<int>(index % stride) - padding, static_cast<int>(index / stride) - padding};
+    }
+
+    std::ptrdiff_t getOffset(const Position& step) const
+    {
+        return step.y * stride + step.x;
+    }
+
+    // Index offsets in the order of orthogonalSteps
+    const std::array<std::ptrdiff_t, 4>& getNeighborOffsets() const
+    {
+        return neighborOffsets;
+    }
+
+    // Index offsets in the order of allSteps
+    const std::array<std::ptrdiff_t, 8>& getAllNeighborOffsets() const
+    {
+        return allNeighborOffsets;
+    }
+
+    // The cells of row y inside of the border
+    std::span<T> row(int y)
+    {
+        return std::span<T>(cells).subspan(getIndex(0, y), width);
+    }
+
+    std::span<const T> row(int y) const
+    {
+        return std::span<const T>(cells).subspan(getIndex(0, y), width);
+    }
+
+    // All cells including the border, in index order
+    std::span<T> getCells()
+    {
+        return cells;
+    }
+
+    std::span<const T> getCells() const
+    {
+        return cells;
+    }
+
+    // Fills the cells inside of the border
+    void fill(const T& value)
+    {
+        for (int y = 0; y < height && width > 0; ++y)
+        {
+            std::fill_n(cells.begin() + getIndex(0, y), width, value);
+        }
+    }
+
+    Tiles getTiles(int tileWidth, int tileHeight) const
+    {
+        return Tiles(width, height, tileWidth, tileHeight);
+    }
+
+private:
+    void checkInside(int x, int y) const
+    {
+        if (!isInside(x, y))
+        {
+            throw std::out_of_range("Position outside of the grid");
+        }
+    }
+
+    int width;
+    int height;
+    int padding;
+    int stride;
+    std::pmr::vector<T> cells;
+    std::array<std::ptrdiff_t, 4> neighborOffsets;
+    std::array<std::ptrdiff_t, 8> allNeighborOffsets;
+};
+}
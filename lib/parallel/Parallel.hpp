@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+namespace parallel
+{
+namespace detail
+{
+// AOC_THREADS sets the default, so that test binaries can be run with
+// any number of threads as well
+inline std::atomic<size_t>& configuredNumOfThreads()
+{
+    static std::atomic<size_t> numOfThreads{[]() -> size_t {
+        const char* value = std::getenv("AOC_THREADS");
+        return value ? std::strtoul(value, nullptr, 10) : 0;
+    }()};
+    return numOfThreads;
+}
+
+inline std::atomic<bool>& isSharedPoolCreated()
+{
+    static std::atomic<bool> created{false};
+    return created;
+}
+}
+
+
+// The number of threads of the shared pool the solvers use, 0 for one per
+// hardware thread. It has to be set before the pool is used for the first
+// time.
+inline void setNumOfThreads(size_t numOfThreads)
+{
+    if (detail::isSharedPoolCreated() && resolveNumOfThreads(numOfThreads) != resolveNumOfThreads(detail::configuredNumOfThreads()))
+    {
+        throw std::logic_error("The shared thread pool is already running");
+    }
+    detail::configuredNumOfThreads() = numOfThreads;
+}
+
+inline size_t getNumOfThreads()
+{
+    return resolveNumOfThreads(detail::configuredNumOfThreads());
+}
+
+inline ThreadPool& getSharedPool()
+{
+    static ThreadPool pool((detail::isSharedPoolCreated() = true, getNumOfThreads()));
+    return pool;
+}
+
+namespace detail
+{
+// Without threads to share the work there is no need to start the pool
+inline ThreadPool* getSharedPoolIfThreaded()
+{
+    return getNumOfThreads() > 1 ? &getSharedPool() : nullptr;
+}
+}
+
+
+// Runs body(chunk) for every chunk in [0, numOfChunks), on the calling
+// thread only if pool is null. The calling thread works on the chunks as
+// well and only waits for chunks other threads are busy with, so it is
+// safe to call from a task of the same pool. The first exception is
+// rethrown once all chunks are done, chunks that have not started by then
+// are skipped.
+template<typename Body>
+void runChunks(ThreadPool* pool, size_t numOfChunks, Body body)
+{
+    struct State
+    {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> finished{0};
+        std::atomic<bool> failed{false};
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+
+    auto state = std::make_shared<State>();
+    auto work = [state, numOfChunks, body]() {
+        for (size_t chunk = state->next++; chunk < numOfChunks; chunk = state->next++)
+        {
+            if (!state->failed)
+            {
+                try
+                {
+                    body(chunk);
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(state->mutex);
+                    if (!state->error)
+                    {
+                        state->error = std::current_exception();
+                    }
+                    state->failed = true;
+                }
+            }
+            if (++state->finished == numOfChunks)
+            {
+                std::lock_guard lock(state->mutex);
+                state->done.notify_all();
+            }
+        }
+    };
+
+    size_t numOfThreads = pool ? pool->getNumOfThreads() : 1;
+    for (size_t i = 1; pool && i < std::min(numOfChunks, numOfThreads); ++i)
+    {
+        pool->submit(work);
+    }
+    work();
+
+    std::unique_lock lock(state->mutex);
+    state->done.wait(lock, [&]() { return state->finished == numOfChunks; });
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+}
+
+
+// Calls fn(i) for every i in [begin, end), grain indices per task.
+template<typename Fn>
+void parallelFor(ThreadPool* pool, size_t begin, size_t end, Fn fn, size_t grain = 1)
+{
+    grain = std::max<size_t>(grain, 1);
+    size_t numOfChunks = end > begin ? (end - begin + grain - 1) / grain : 0;
+    runChunks(pool, numOfChunks, [&fn, begin, end, grain](size_t chunk) {
+        size_t last = std::min(end, begin + (chunk + 1) * grain);
+        for (size_t i = begin + chunk * grain; i < last; ++i)
+        {
+            fn(i);
+        }
+    });
+}
+
+template<typename Fn>
+void parallelFor(ThreadPool& pool, size_t begin, size_t end, Fn fn, size_t grain = 1)
+{
+    parallelFor(&pool, begin, end, fn, grain);
+}
+
+// On the shared pool
+template<typename Fn>
+void parallelFor(size_t begin, size_t end, Fn fn, size_t grain = 1)
+{
+    parallelFor(detail::getSharedPoolIfThreaded(), begin, end, fn, grain);
+}
+
+
+// Combines map(i) for every i in [begin, end). The range is cut into
+// chunks of grain indices no matter how many threads there are, each
+// chunk is folded from identity in index order and the chunk results are
+// combined in chunk order. So the result is the same for any number of
+// threads, also when combine is not associative like for floating point.
+template<typename T, typename Map, typename Combine>
+T parallelReduce(ThreadPool* pool, size_t begin, size_t end, T identity, Map map, Combine combine, size_t grain = 1)
+{
+    grain = std::max<size_t>(grain, 1);
+    size_t numOfChunks = end > begin ? (end - begin + grain - 1) / grain : 0;
+    std::vector<T> partials(numOfChunks, identity);
+    runChunks(pool, numOfChunks, [&](size_t chunk) {
+        size_t last = std::min(end, begin + (chunk + 1) * grain);
+        T partial = identity;
+        for (size_t i = begin + chunk * grain; i < last; ++i)
+        {
+            partial = combine(std::move(partial), map(i));
+        }
+        partials[chunk] = std::move(partial);
+    });
+
+    T result = std::move(identity);
+    for (auto& partial : partials)
+    {
+        result = combine(std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+template<typename T, typename Map, typename Combine>
+T parallelReduce(ThreadPool& pool, size_t begin, size_t end, T identity, Map map, Combine combine, size_t grain = 1)
+{
+    return parallelReduce(&pool, begin, end, std::move(identity), map, combine, grain);
+}
+
+// On the shared pool
+template<typename T, typename Map, typename Combine>
+T parallelReduce(size_t begin, size_t end, T identity, Map map, Combine combine, size_t grain = 1)
+{
+    return parallelReduce(detail::getSharedPoolIfThreaded(), begin, end, std::move(identity), map, combine, grain);
+}
+
+
+// Tasks with dependencies between them. A task starts once all the tasks
+// it depends on have finished, dependencies can only be added on tasks
+// that are already in the graph, so there are no cycles. Like runChunks
+// the calling thread runs tasks as well.
+class TaskGraph
+{
+public:
+    using Id = size_t;
+    using Task = std::function<void()>;
+
+    Id add(Task task, std::span<const Id> dependencies = {})
+    {
+        Id id = nodes.size();
+        for (Id dependency : dependencies)
+        {
+            if (dependency >= id)
+            {
+                throw std::invalid_argument("Unknown dependency");
+            }
+            nodes[dependency].successors.push_back(id);
+        }
+        nodes.push_back({std::move(task), {}, dependencies.size()});
+        return id;
+    }
+
+    Id add(Task task, std::initializer_list<Id> dependencies)
+    {
+        return add(std::move(task), std::span<const Id>(dependencies.begin(), dependencies.size()));
+    }
+
+    size_t size() const
+    {
+        return nodes.size();
+    }
+
+    // Runs every task once, the first exception is rethrown after the
+    // tasks that were running have finished. Tasks that have not started
+    // by then are skipped.
+    void run(ThreadPool& pool)
+    {
+        auto state = std::make_shared<State>();
+        state->numOfTasks = nodes.size();
+        state->numOfDependencies.reserve(nodes.size());
+        for (Id id = 0; id < nodes.size(); ++id)
+        {
+            state->numOfDependencies.push_back(nodes[id].numOfDependencies);
+            if (nodes[id].numOfDependencies == 0)
+            {
+                state->ready.push_back(id);
+            }
+        }
+
+        submitHelpers(pool, state, state->ready.size());
+        work(pool, state, true);
+
+        if (state->error)
+        {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    void run()
+    {
+        run(getSharedPool());
+    }
+
+private:
+    struct Node
+    {
+        Task task;
+        std::vector<Id> successors;
+        size_t numOfDependencies;
+    };
+
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<Id> ready;
+        std::vector<size_t> numOfDependencies;
+        size_t numOfTasks = 0;
+        size_t finished = 0;
+        std::exception_ptr error;
+    };
+
+    // The calling thread takes one of the ready tasks itself
+    void submitHelpers(ThreadPool& pool, const std::shared_ptr<State>& state, size_t numOfReady)
+    {
+        for (size_t i = 1; i < std::min(numOfReady, pool.getNumOfThreads()); ++i)
+        {
+            pool.submit([this, &pool, state]() { work(pool, state, false); });
+        }
+    }
+
+    // Helpers return as soon as nothing is ready, they may even start after
+    // run() has returned and must not touch the graph then. The caller
+    // stays until every task is done.
+    void work(ThreadPool& pool, const std::shared_ptr<State>& state, bool isCaller)
+    {
+        std::unique_lock lock(state->mutex);
+        while (state->finished < state->numOfTasks)
+        {
+            if (state->ready.empty())
+            {
+                if (!isCaller)
+                {
+                    return;
+                }
+                state->changed.wait(lock);
+                continue;
+            }
+
+            Id id = state->ready.front();
+            state->ready.pop_front();
+            if (!state->error)
+            {
+                lock.unlock();
+                try
+                {
+                    nodes[id].task();
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    if (!state->error)
+                    {
+                        state->error = std::current_exception();
+                    }
+                    lock.unlock();
+                }
+                lock.lock();
+            }
+
+            state->finished++;
+            size_t numOfReady = 0;
+            for (Id successor : nodes[id].successors)
+            {
+                if (--state->numOfDependencies[successor] == 0)
+                {
+                    state->ready.push_back(successor);
+                    numOfReady++;
+                }
+            }
+            submitHelpers(pool, state, numOfReady);
+            state->changed.notify_all();
+        }
+    }
+
+    std::vector<Node> nodes;
+};
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parallel
+{
+// 0 stands for one thread per hardware thread.
+inline size_t resolveNumOfThreads(size_t numOfThreads)
+{
+    return numOfThreads > 0 ? numOfThreads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+
+// Work-stealing pool. Every worker owns a queue; tasks submitted from a
+// worker go to its own queue and are taken LIFO, idle workers steal FIFO
+// from the others. The first exception thrown by a task is rethrown by
+// wait().
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t numOfThreads = 0)
+    {
+        numOfThreads = resolveNumOfThreads(numOfThreads);
+        for (size_t i = 0; i < numOfThreads; ++i)
+        {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (size_t i = 0; i < numOfThreads; ++i)
+        {
+            workers.emplace_back([this, i]() { work(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    size_t getNumOfThreads() const
+    {
+        return workers.size();
+    }
+
+    void submit(Task task)
+    {
+        size_t queue = currentWorker(this).value_or(nextQueue++ % queues.size());
+        {
+            // Queued under the pool mutex so that a worker that is about
+            // to sleep cannot miss it
+            std::lock_guard lock(mutex);
+            pending++;
+            std::lock_guard queueLock(queues[queue]->mutex);
+            queues[queue]->tasks.push_back(std::move(task));
+        }
+        wakeUp.notify_one();
+    }
+
+    // Blocks until every submitted task, including the ones submitted by
+    // other tasks meanwhile, has finished.
+    void wait()
+    {
+        std::unique_lock lock(mutex);
+        done.wait(lock, [this]() { return pending == 0; });
+        if (error)
+        {
+            std::exception_ptr e = std::exchange(error, nullptr);
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Index of the calling worker if it belongs to pool
+    static std::optional<size_t> currentWorker(const ThreadPool* pool, std::optional<size_t> set = std::nullopt)
+    {
+        thread_local const ThreadPool* owner = nullptr;
+        thread_local size_t index = 0;
+        if (set)
+        {
+            owner = pool;
+            index = *set;
+        }
+        return owner == pool ? std::optional<size_t>(index) : std::nullopt;
+    }
+
+    std::optional<Task> take(size_t self)
+    {
+        {
+            Queue& own = *queues[self];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                Task task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return task;
+            }
+        }
+        for (size_t i = 1; i < queues.size(); ++i)
+        {
+            Queue& victim = *queues[(self + i) % queues.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                Task task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return task;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void work(size_t self)
+    {
+        currentWorker(this, self);
+        while (true)
+        {
+            if (auto task = take(self))
+            {
+                try
+                {
+                    (*task)();
+                }
+                catch (...)
+                {
+                    std::lock_guard lock(mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+
+                std::lock_guard lock(mutex);
+                if (--pending == 0)
+                {
+                    done.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock lock(mutex);
+            wakeUp.wait(lock, [this]() { return stopping || hasQueuedTasks(); });
+            if (stopping && !hasQueuedTasks())
+            {
+                return;
+            }
+        }
+    }
+
+    bool hasQueuedTasks()
+    {
+        for (auto& queue : queues)
+        {
+            std::lock_guard lock(queue->mutex);
+            if (!queue->tasks.empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> nextQueue{0};
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable done;
+    size_t pending{0};
+    bool stopping{false};
+    std::exception_ptr error;
+};
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace profiling
+{
+enum class Counter : int
+{
+    cycles = 0,
+    instructions,
+    cacheMisses,
+    branchMisses,
+    numOf
+};
+
+constexpr size_t numOfCounters = static_cast<size_t>(Counter::numOf);
+
+using CounterValues = std::array<std::uint64_t, numOfCounters>;
+
+constexpr std::array<std::string_view, numOfCounters> counterNames = {
+    "cycles", "instructions", "cache-misses", "branch-misses"
+};
+
+
+// Bit i is set once any thread managed to open counter i
+inline std::atomic<unsigned> availableCounters{0};
+
+
+// Hardware counters of the calling thread, read as one perf_event group.
+// Counters the kernel refuses (no PMU in a VM, perf_event_paranoid, ...)
+// stay unavailable and read as zero.
+class HardwareCounters
+{
+public:
+    HardwareCounters()
+    {
+#if defined(__linux__)
+        constexpr std::array<std::uint64_t, numOfCounters> configs = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES
+        };
+
+        for (size_t i = 0; i < numOfCounters; ++i)
+        {
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = leader < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+            if (fd < 0)
+            {
+                if (leader < 0)
+                {
+                    return;  // Without the leader there is no group to join
+                }
+                continue;
+            }
+            if (leader < 0)
+            {
+                leader = fd;
+            }
+            slots[numOfOpened++] = i;
+            availableCounters.fetch_or(1u << i, std::memory_order_relaxed);
+        }
+
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    ~HardwareCounters()
+    {
+#if defined(__linux__)
+        // Closing the leader releases the whole group
+        if (leader >= 0)
+        {
+            close(leader);
+        }
+#endif
+    }
+
+    CounterValues read() const
+    {
+        CounterValues values{};
+#if defined(__linux__)
+        if (leader < 0)
+        {
+            return values;
+        }
+
+        struct
+        {
+            std::uint64_t nr;
+            std::array<std::uint64_t, numOfCounters> values;
+        } group;
+
+        if (::read(leader, &group, sizeof(group)) > 0)
+        {
+            for (size_t i = 0; i < group.nr && i < numOfOpened; ++i)
+            {
+                values[slots[i]] = group.values[i];
+            }
+        }
+#endif
+        return values;
+    }
+
+    // The counters of the calling thread, opened on first use.
+    static const HardwareCounters& forThisThread()
+    {
+        thread_local HardwareCounters counters;
+        return counters;
+    }
+
+private:
+    int leader{-1};
+    std::array<size_t, numOfCounters> slots{};
+    size_t numOfOpened{0};
+};
+
+
+inline bool isAvailable(Counter counter)
+{
+    return availableCounters.load(std::memory_order_relaxed) & (1u << static_cast<unsigned>(counter));
+}
+}
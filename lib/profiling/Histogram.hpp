@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace profiling
+{
+// Latency histogram in the manner of HdrHistogram: buckets are linear below
+// 2^precisionBits and log-linear above, every power of two is split into
+// 2^precisionBits buckets. A recorded value is off by less than one part in
+// 2^precisionBits, 1% with the default, over the whole range of
+// nanoseconds, while the histogram stays a few kilobytes no matter how many
+// values it records. The counts grow with the largest value.
+class Histogram
+{
+public:
+    static constexpr int defaultPrecisionBits = 7;
+
+    explicit Histogram(int precisionBits = defaultPrecisionBits) :
+        precisionBits(precisionBits)
+    {
+    }
+
+    void record(std::uint64_t value)
+    {
+        size_t index = getIndex(value);
+        if (index >= counts.size())
+        {
+            counts.resize(index + 1, 0);
+        }
+        ++counts[index];
+        ++totalCount;
+        sum += value;
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+
+    void record(std::chrono::nanoseconds duration)
+    {
+        record(static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0)));
+    }
+
+    // Both histograms have to have the same precision
+    void merge(const Histogram& other)
+    {
+        if (other.counts.size() > counts.size())
+        {
+            counts.resize(other.counts.size(), 0);
+        }
+        for (size_t i = 0; i < other.counts.size(); ++i)
+        {
+            counts[i] += other.counts[i];
+        }
+        totalCount += other.totalCount;
+        sum += other.sum;
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+    }
+
+    std::uint64_t getCount() const
+    {
+        return totalCount;
+    }
+
+    // Exact, not rounded to a bucket; 0 while empty
+    std::uint64_t getMin() const
+    {
+        return totalCount ? minimum : 0;
+    }
+
+    std::uint64_t getMax() const
+    {
+        return maximum;
+    }
+
+    double getMean() const
+    {
+        return totalCount ? static_cast<double>(sum) / static_cast<double>(totalCount) : 0.0;
+    }
+
+    // The smallest bucket bound that at least percentile % of the values
+    // do not exceed, percentile in [0, 100]. 0 and 100 are the exact
+    // minimum and maximum.
+    std::uint64_t getPercentile(double percentile) const
+    {
+        if (totalCount == 0 || percentile <= 0)
+        {
+            return getMin();
+        }
+        double rank = std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(totalCount));
+        std::uint64_t target = std::max<std::uint64_t>(static_cast<std::uint64_t>(rank), 1);
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            seen += counts[i];
+            if (seen >= target)
+            {
+                return std::clamp(getUpperBound(i), minimum, maximum);
+            }
+        }
+        return maximum;
+    }
+
+    std::chrono::nanoseconds getPercentileDuration(double percentile) const
+    {
+        return std::chrono::nanoseconds(getPercentile(percentile));
+    }
+
+    // Bucket of a value: the value itself below 2^precisionBits, above the
+    // position of the highest bit picks the power of two and the next
+    // precisionBits bits the bucket within it.
+    size_t getIndex(std::uint64_t value) const
+    {
+        std::uint64_t linear = std::uint64_t(1) << precisionBits;
+        if (value < linear)
+        {
+            return static_cast<size_t>(value);
+        }
+        int shift = std::bit_width(value) - (precisionBits + 1);
+        std::uint64_t mantissa = value >> shift;
+        return static_cast<size_t>((static_cast<std::uint64_t>(shift) + 1) * linear + (mantissa - linear));
+    }
+
+    // Largest value that falls into the bucket
+    std::uint64_t getUpperBound(size_t index) const
+    {
+        std::uint64_t linear = std::uint64_t(1) << precisionBits;
+        if (index < linear)
+        {
+            return index;
+        }
+        std::uint64_t shift = index / linear - 1;
+        std::uint64_t mantissa = index % linear + linear;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+private:
+    int precisionBits;
+    std::vector<std::uint64_t> counts;
+    std::uint64_t totalCount{0};
+    std::uint64_t sum{0};
+    std::uint64_t minimum{std::numeric_limits<std::uint64_t>::max()};
+    std::uint64_t maximum{0};
+};
+}
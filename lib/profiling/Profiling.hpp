@@ -0,0 +1,30 @@
+#pragma once
+
+// Named scoped zones that measure wall time and, where the kernel allows it,
+// hardware counters of the calling thread. Everything is compiled out unless
+// AOC_PROFILING is defined (cmake -DAOC_PROFILING=ON); the collected zones
+// are reported to stderr at process exit.
+//
+//     void tick()
+//     {
+//         AOC_PROFILE_ZONE("day13::Navigator::tick");
+//         ...
+//     }
+
+#ifdef AOC_PROFILING
+
+#include "Zones.hpp"
+
+#define AOC_PROFILE_CONCAT_IMPL(a, b) a##b
+#define AOC_PROFILE_CONCAT(a, b) AOC_PROFILE_CONCAT_IMPL(a, b)
+
+#define AOC_PROFILE_ZONE(name) \
+    static ::profiling::ZoneStats& AOC_PROFILE_CONCAT(aocProfileStats, __LINE__) = \
+        ::profiling::Registry::get().add(name); \
+    ::profiling::ScopedZone AOC_PROFILE_CONCAT(aocProfileZone, __LINE__)(AOC_PROFILE_CONCAT(aocProfileStats, __LINE__))
+
+#else
+
+#define AOC_PROFILE_ZONE(name) static_cast<void>(0)
+
+#endif
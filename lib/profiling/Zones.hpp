@@ -0,0 +1,207 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "Allocations.hpp"
+#include "Counters.hpp"
+
+namespace profiling
+{
+// Totals of one zone over all threads. Nested zones are inclusive.
+struct ZoneStats
+{
+    explicit ZoneStats(std::string_view name) :
+        name(name)
+    {
+    }
+
+    void add(std::chrono::nanoseconds wallTime, const CounterValues& counterDeltas,
+        const allocations::Stats& allocated)
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        nanoseconds.fetch_add(wallTime.count(), std::memory_order_relaxed);
+        allocationCount.fetch_add(allocated.count, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(allocated.bytes, std::memory_order_relaxed);
+        for (size_t i = 0; i < numOfCounters; ++i)
+        {
+            counters[i].fetch_add(counterDeltas[i], std::memory_order_relaxed);
+        }
+    }
+
+    const std::string name;
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> nanoseconds{0};
+    std::array<std::atomic<std::uint64_t>, numOfCounters> counters{};
+    std::atomic<std::uint64_t> allocationCount{0};
+    std::atomic<std::uint64_t> allocatedBytes{0};
+};
+
+
+inline void report(std::ostream& out);
+
+
+class Registry
+{
+public:
+    static Registry& get()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    // Zones live until exit, references to them stay valid.
+    ZoneStats& add(std::string_view name)
+    {
+        std::lock_guard lock(mutex);
+        for (auto& zone : zones)
+        {
+            if (zone.name == name)
+            {
+                return zone;
+            }
+        }
+        return zones.emplace_back(name);
+    }
+
+    template<typename Function>
+    void forEach(Function&& function)
+    {
+        std::lock_guard lock(mutex);
+        for (const auto& zone : zones)
+        {
+            function(zone);
+        }
+    }
+
+private:
+    Registry() = default;
+
+    ~Registry()
+    {
+        if (!zones.empty())
+        {
+            report(std::cerr);
+        }
+    }
+
+    std::mutex mutex;
+    std::deque<ZoneStats> zones;
+};
+
+
+class ScopedZone
+{
+public:
+    explicit ScopedZone(ZoneStats& stats) :
+        stats(stats),
+        counters(HardwareCounters::forThisThread()),
+        startCounters(counters.read()),
+        start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+
+    ~ScopedZone()
+    {
+        auto wallTime = std::chrono::steady_clock::now() - start;
+        CounterValues deltas = counters.read();
+        for (size_t i = 0; i < numOfCounters; ++i)
+        {
+            deltas[i] -= startCounters[i];
+        }
+        stats.add(wallTime, deltas, allocated.stop());
+    }
+
+private:
+    ZoneStats& stats;
+    const HardwareCounters& counters;
+    CounterValues startCounters;
+    allocations::Scope allocated;
+    std::chrono::steady_clock::time_point start;
+};
+
+
+// One line per zone: calls, total and mean wall time, counters per call,
+// instructions per cycle and allocations per call. Counters that could not
+// be opened and allocations without tracking show "-".
+inline void report(std::ostream& out)
+{
+    auto flags = out.flags();
+
+    out << std::left << std::setw(40) << "zone" << std::right
+        << std::setw(10) << "calls"
+        << std::setw(14) << "total ms"
+        << std::setw(14) << "mean ns";
+    for (auto name : counterNames)
+    {
+        out << std::setw(16) << name;
+    }
+    out << std::setw(8) << "IPC"
+        << std::setw(12) << "allocs"
+        << std::setw(14) << "alloc bytes" << '\n';
+
+    Registry::get().forEach([&](const ZoneStats& zone) {
+        std::uint64_t calls = zone.calls.load();
+        if (calls == 0)
+        {
+            return;
+        }
+        std::uint64_t nanoseconds = zone.nanoseconds.load();
+
+        out << std::left << std::setw(40) << zone.name << std::right
+            << std::setw(10) << calls
+            << std::fixed << std::setprecision(3)
+            << std::setw(14) << nanoseconds / 1e6
+            << std::setprecision(0)
+            << std::setw(14) << static_cast<double>(nanoseconds) / calls;
+
+        for (size_t i = 0; i < numOfCounters; ++i)
+        {
+            if (isAvailable(static_cast<Counter>(i)))
+            {
+                out << std::setw(16) << static_cast<double>(zone.counters[i].load()) / calls;
+            }
+            else
+            {
+                out << std::setw(16) << "-";
+            }
+        }
+
+        std::uint64_t cycles = zone.counters[static_cast<size_t>(Counter::cycles)].load();
+        std::uint64_t instructions = zone.counters[static_cast<size_t>(Counter::instructions)].load();
+        if (cycles > 0)
+        {
+            out << std::setprecision(2) << std::setw(8) << static_cast<double>(instructions) / cycles;
+        }
+        else
+        {
+            out << std::setw(8) << "-";
+        }
+
+        if (allocations::isTracking())
+        {
+            out << std::setprecision(1)
+                << std::setw(12) << static_cast<double>(zone.allocationCount.load()) / calls
+                << std::setprecision(0)
+                << std::setw(14) << static_cast<double>(zone.allocatedBytes.load()) / calls;
+        }
+        else
+        {
+            out << std::setw(12) << "-" << std::setw(14) << "-";
+        }
+        out << '\n';
+    });
+    out.flags(flags);
+}
+}
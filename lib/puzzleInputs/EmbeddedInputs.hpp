@@ -0,0 +1,40 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace puzzleInputs
+{
+// Inputs compiled into the executable by aoc_embed_inputs() in CMake, by
+// the path of the file they were read from. MappedInput hands them out
+// instead of reading the file. They are registered while static objects
+// are constructed and only read afterwards, so no locking is needed.
+inline std::map<std::string, std::string_view, std::less<>>& getEmbeddedInputs()
+{
+    static std::map<std::string, std::string_view, std::less<>> inputs;
+    return inputs;
+}
+
+inline void embed(const std::filesystem::path& path, std::string_view text)
+{
+    getEmbeddedInputs().insert_or_assign(path.lexically_normal().string(), text);
+}
+
+inline std::optional<std::string_view> findEmbedded(const std::filesystem::path& path)
+{
+    const auto& inputs = getEmbeddedInputs();
+    if (inputs.empty())
+    {
+        return std::nullopt;
+    }
+    auto it = inputs.find(path.lexically_normal().string());
+    if (it == inputs.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+}
@@ -0,0 +1,37 @@
+# Writes HEADER with the FILES ('|' separated) as constexpr string_views in
+# NAMESPACE and SOURCE, which registers them with puzzleInputs::embed().
+# Run by aoc_embed_inputs() with cmake -P.
+
+string(REPLACE "|" ";" files "${FILES}")
+get_filename_component(headerName ${HEADER} NAME)
+
+set(header "// Generated from the puzzle inputs by GenerateEmbeddedInputs.cmake\n")
+string(APPEND header "#pragma once\n\n#include <string_view>\n\nnamespace ${NAMESPACE}\n{\n")
+set(registrations "")
+
+foreach(file IN LISTS files)
+    get_filename_component(name ${file} NAME_WE)
+    string(MAKE_C_IDENTIFIER ${name} name)
+
+    # Every byte as a \x escape, 16 of them per line. CMake regular
+    # expressions have no repetition counts.
+    file(READ ${file} hex HEX)
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "\\\\x\\1" escaped "${hex}")
+    string(REPEAT "\\\\x[0-9a-f][0-9a-f]" 16 line)
+    string(REGEX REPLACE "(${line})" "\\1\"\n    \"" escaped "${escaped}")
+
+    string(APPEND header "inline constexpr char ${name}_data[] =\n    \"${escaped}\";\n\n")
+    string(APPEND header "inline constexpr std::string_view ${name}(${name}_data, sizeof(${name}_data) - 1);\n\n")
+    string(APPEND registrations "        puzzleInputs::embed(\"${file}\", ${NAMESPACE}::${name});\n")
+endforeach()
+
+string(APPEND header "}\n")
+
+set(source "// Generated from the puzzle inputs by GenerateEmbeddedInputs.cmake\n")
+string(APPEND source "#include \"EmbeddedInputs.hpp\"\n#include \"${headerName}\"\n\n")
+string(APPEND source "namespace\n{\nstruct Registration\n{\n    Registration()\n    {\n")
+string(APPEND source "${registrations}")
+string(APPEND source "    }\n} registration;\n}\n")
+
+file(WRITE ${HEADER} "${header}")
+file(WRITE ${SOURCE} "${source}")
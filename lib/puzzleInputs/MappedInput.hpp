@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "EmbeddedInputs.hpp"
+
+namespace puzzleInputs
+{
+// The line without the '\r' of a "\r\n" line ending, so that input saved
+// with Windows line endings reads the same
+constexpr std::string_view trimLineEnd(std::string_view line)
+{
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+
+// Splits text into lines the same way std::getline does: the terminating
+// '\n' is not part of the line and a trailing newline does not produce an
+// extra empty line. A '\r' before it is dropped as well. The yielded views
+// point into the original text.
+class Lines
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        constexpr iterator() = default;
+
+        constexpr iterator(std::string_view remainingIn) : remaining(remainingIn), atEnd(false)
+        {
+            next();
+        }
+
+        constexpr reference operator*() const { return line; }
+        constexpr pointer operator->() const { return &line; }
+
+        constexpr iterator& operator++()
+        {
+            next();
+            return *this;
+        }
+
+        constexpr iterator operator++(int)
+        {
+            iterator previous = *this;
+            next();
+            return previous;
+        }
+
+        constexpr bool operator==(const iterator& other) const
+        {
+            return atEnd == other.atEnd &&
+                (atEnd || line.data() == other.line.data());
+        }
+
+    private:
+        constexpr void next()
+        {
+            if (remaining.empty())
+            {
+                atEnd = true;
+                return;
+            }
+
+            size_t end = remaining.find('\n');
+            if (end == std::string_view::npos)
+            {
+                line = trimLineEnd(remaining);
+                remaining = {};
+            }
+            else
+            {
+                line = trimLineEnd(remaining.substr(0, end));
+                remaining.remove_prefix(end + 1);
+            }
+        }
+
+        std::string_view remaining;
+        std::string_view line;
+        bool atEnd{true};
+    };
+
+    constexpr explicit Lines(std::string_view textIn) : text(textIn)
+    {
+    }
+
+    constexpr iterator begin() const { return iterator(text); }
+    constexpr iterator end() const { return iterator(); }
+
+private:
+    std::string_view text;
+};
+
+
+// Number of lines as Lines splits them
+constexpr size_t countLines(std::string_view text)
+{
+    size_t count = 0;
+    for (auto it = Lines(text).begin(); it != Lines(text).end(); ++it)
+    {
+        count++;
+    }
+    return count;
+}
+
+
+// Read-only, memory-mapped view of an input file. The content stays valid
+// for the lifetime of the object and is never copied. Inputs embedded into
+// the executable are not read at all.
+class MappedInput
+{
+public:
+    explicit MappedInput(const std::filesystem::path& filepath)
+    {
+        if (auto embedded = findEmbedded(filepath))
+        {
+            data = const_cast<char*>(embedded->data());
+            size = embedded->size();
+            return;
+        }
+
+        int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                "Failed to open " + filepath.string());
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(),
+                "Failed to stat " + filepath.string());
+        }
+
+        size = static_cast<size_t>(info.st_size);
+        if (size > 0)
+        {
+            data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                int error = errno;
+                ::close(fd);
+                data = nullptr;
+                throw std::system_error(error, std::generic_category(),
+                    "Failed to map " + filepath.string());
+            }
+            ::madvise(data, size, MADV_SEQUENTIAL);
+            mapped = true;
+        }
+        ::close(fd);
+    }
+
+    MappedInput(const MappedInput&) = delete;
+    MappedInput& operator=(const MappedInput&) = delete;
+
+    MappedInput(MappedInput&& other) noexcept :
+        data(std::exchange(other.data, nullptr)),
+        size(std::exchange(other.size, 0)),
+        mapped(std::exchange(other.mapped, false))
+    {
+    }
+
+    MappedInput& operator=(MappedInput&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+            mapped = std::exchange(other.mapped, false);
+        }
+        return *this;
+    }
+
+    ~MappedInput()
+    {
+        unmap();
+    }
+
+    std::string_view view() const
+    {
+        return data ? std::string_view(static_cast<const char*>(data), size) : std::string_view();
+    }
+
+    Lines lines() const
+    {
+        return Lines(view());
+    }
+
+private:
+    void unmap()
+    {
+        if (mapped)
+        {
+            ::munmap(data, size);
+        }
+    }
+
+    void* data{nullptr};
+    size_t size{0};
+    // False for embedded inputs
+    bool mapped{false};
+};
+}
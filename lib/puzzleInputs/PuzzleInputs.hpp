@@ -2,6 +2,8 @@
 
 #include <filesystem>
 
+#include "MappedInput.hpp"
+
 #if !defined(APP_ROOT_DIR)
     #error "APP_ROOT_DIR is not configured"
 #endif
@@ -12,4 +14,9 @@ inline std::filesystem::path getInputDirectory()
 {
     return std::filesystem::path(APP_ROOT_DIR) / "inputs";
 }
+
+inline MappedInput openInput(const std::filesystem::path& filename)
+{
+    return MappedInput(getInputDirectory() / filename);
+}
 }
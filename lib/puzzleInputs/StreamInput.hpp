@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "MappedInput.hpp"
+
+namespace puzzleInputs
+{
+// Reads input that is not a seekable file (stdin, pipes) in chunks of at
+// most chunkSize bytes. Each chunk is valid until the next call to next().
+class ChunkReader
+{
+public:
+    static constexpr size_t defaultChunkSize = 64 * 1024;
+
+    // Reads from a file descriptor, e.g. STDIN_FILENO
+    explicit ChunkReader(int fd, size_t chunkSize = defaultChunkSize) :
+        buffer(chunkSize),
+        source([fd](char* data, size_t size) { return readFd(fd, data, size); })
+    {
+    }
+
+    // Hands out text in pieces, mostly for tests of chunk boundaries
+    ChunkReader(std::string_view text, size_t chunkSize) :
+        buffer(chunkSize),
+        source([text](char* data, size_t size) mutable {
+            size_t n = std::min(size, text.size());
+            std::copy_n(text.data(), n, data);
+            text.remove_prefix(n);
+            return n;
+        })
+    {
+    }
+
+    std::optional<std::string_view> next()
+    {
+        size_t n = source(buffer.data(), buffer.size());
+        if (n == 0)
+        {
+            return std::nullopt;
+        }
+        return std::string_view(buffer.data(), n);
+    }
+
+private:
+    static size_t readFd(int fd, char* data, size_t size)
+    {
+        while (true)
+        {
+            ssize_t n = ::read(fd, data, size);
+            if (n >= 0)
+            {
+                return static_cast<size_t>(n);
+            }
+            if (errno != EINTR)
+            {
+                throw std::system_error(errno, std::generic_category(), "Failed to read input");
+            }
+        }
+    }
+
+    std::vector<char> buffer;
+    std::function<size_t(char*, size_t)> source;
+};
+
+
+// Splits the chunks into lines like Lines does. A line that spans chunks
+// is assembled in a carry buffer, so memory is bounded by the chunk size
+// plus the longest line. Each line is valid until the next call to next().
+class LineReader
+{
+public:
+    explicit LineReader(ChunkReader& reader) :
+        reader(reader)
+    {
+    }
+
+    std::optional<std::string_view> next()
+    {
+        while (true)
+        {
+            size_t end = chunk.find('\n');
+            if (end != std::string_view::npos)
+            {
+                std::string_view line = chunk.substr(0, end);
+                chunk.remove_prefix(end + 1);
+                if (carry.empty())
+                {
+                    return trimLineEnd(line);
+                }
+                carry.append(line);
+                current.swap(carry);
+                carry.clear();
+                return trimLineEnd(current);
+            }
+
+            carry.append(chunk);
+            auto nextChunk = reader.next();
+            if (!nextChunk)
+            {
+                chunk = {};
+                if (carry.empty())
+                {
+                    return std::nullopt;
+                }
+                current.swap(carry);
+                carry.clear();
+                return trimLineEnd(current);
+            }
+            chunk = *nextChunk;
+        }
+    }
+
+private:
+    ChunkReader& reader;
+    std::string_view chunk;
+    std::string carry;
+    std::string current;
+};
+
+
+// For solvers that need the whole input at once
+inline std::string readAll(ChunkReader& reader)
+{
+    std::string text;
+    while (auto chunk = reader.next())
+    {
+        text.append(*chunk);
+    }
+    return text;
+}
+}
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace scanner
+{
+namespace detail
+{
+// GCC reports the 8 byte loads below when inlined into a call that it can
+// see has a shorter literal, even though the callers check the length.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+
+// The tricks below take the first character as the least significant byte
+// of the word loaded from it, other targets parse with std::from_chars
+constexpr bool hasSwarDigits = std::endian::native == std::endian::little;
+
+constexpr std::uint64_t repeat(std::uint8_t byte)
+{
+    return 0x0101010101010101ull * byte;
+}
+
+// Number of leading ASCII digits in the 8 bytes starting at text.
+inline int countDigits(const char* text)
+{
+    std::uint64_t chunk;
+    std::memcpy(&chunk, text, sizeof(chunk));
+
+    // A byte is a digit when its high nibble is 3 both before and after
+    // adding 6. A carry out of a non-digit byte can only corrupt the bytes
+    // after it, which are never counted.
+    std::uint64_t nonDigits =
+        ((chunk & repeat(0xF0)) ^ repeat(0x30)) |
+        (((chunk + repeat(0x06)) & repeat(0xF0)) ^ repeat(0x30));
+
+    return nonDigits == 0 ? 8 : std::countr_zero(nonDigits) / 8;
+}
+
+// Converts 1-8 ASCII digits starting at text with a handful of multiplies
+// instead of one multiply-add per digit. Requires 8 readable bytes.
+inline std::uint32_t parseDigits(const char* text, int count)
+{
+    std::uint64_t chunk;
+    std::memcpy(&chunk, text, sizeof(chunk));
+
+    // Push the digits to the most significant end, the vacated bytes
+    // become leading zeros.
+    chunk = (chunk & repeat(0x0F)) << (8 * (8 - count));
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFull;
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFull;
+    chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFFull;
+    return static_cast<std::uint32_t>(chunk);
+}
+
+#pragma GCC diagnostic pop
+}
+
+
+constexpr bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+
+constexpr bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+
+// Parses integers, characters and literals from a string_view without
+// allocating. All operations skip leading whitespace. The try* operations
+// leave the position untouched on failure, the others throw
+// std::runtime_error. Everything works in constant expressions as well,
+// where a failure is a compile error.
+class Scanner
+{
+public:
+    constexpr explicit Scanner(std::string_view textIn) : text(textIn)
+    {
+    }
+
+    constexpr std::string_view remaining() const
+    {
+        return text.substr(pos);
+    }
+
+    constexpr bool atEnd() const
+    {
+        return pos >= text.size();
+    }
+
+    constexpr void skipWhitespace()
+    {
+        while (pos < text.size() && isWhitespace(text[pos]))
+        {
+            pos++;
+        }
+    }
+
+    // Skips whitespace and tells if anything is left after it.
+    constexpr bool hasMore()
+    {
+        skipWhitespace();
+        return !atEnd();
+    }
+
+    constexpr bool skip(char c)
+    {
+        skipWhitespace();
+        if (pos < text.size() && text[pos] == c)
+        {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    constexpr bool skip(std::string_view literal)
+    {
+        skipWhitespace();
+        if (remaining().starts_with(literal))
+        {
+            pos += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    constexpr void expect(char c)
+    {
+        if (!skip(c))
+        {
+            fail(std::string("Expected '") + c + "'");
+        }
+    }
+
+    constexpr void expect(std::string_view literal)
+    {
+        if (!skip(literal))
+        {
+            fail("Expected \"" + std::string(literal) + "\"");
+        }
+    }
+
+    constexpr std::optional<char> tryChar()
+    {
+        skipWhitespace();
+        if (atEnd())
+        {
+            return std::nullopt;
+        }
+        return text[pos++];
+    }
+
+    // Next run of non-whitespace characters, empty at the end of input.
+    constexpr std::string_view word()
+    {
+        skipWhitespace();
+        size_t begin = pos;
+        while (pos < text.size() && !isWhitespace(text[pos]))
+        {
+            pos++;
+        }
+        return text.substr(begin, pos - begin);
+    }
+
+    // Everything up to the delimiter or the end of input. The delimiter is
+    // consumed but not returned.
+    constexpr std::string_view until(char delimiter)
+    {
+        size_t end = text.find(delimiter, pos);
+        std::string_view field;
+        if (end == std::string_view::npos)
+        {
+            field = text.substr(pos);
+            pos = text.size();
+        }
+        else
+        {
+            field = text.substr(pos, end - pos);
+            pos = end + 1;
+        }
+        return field;
+    }
+
+    template<std::integral T>
+    constexpr std::optional<T> tryInteger()
+    {
+        skipWhitespace();
+        size_t begin = pos;
+        bool negative = false;
+
+        if (pos < text.size() && (text[pos] == '-' || text[pos] == '+'))
+        {
+            negative = text[pos] == '-';
+            pos++;
+        }
+
+        if (negative && std::is_unsigned_v<T>)
+        {
+            pos = begin;
+            return std::nullopt;
+        }
+
+        std::optional<T> value = parseMagnitude<T>(negative);
+        if (!value)
+        {
+            pos = begin;
+        }
+        return value;
+    }
+
+    template<std::integral T>
+    constexpr T integer()
+    {
+        std::optional<T> value = tryInteger<T>();
+        if (!value)
+        {
+            fail("Expected an integer");
+        }
+        return *value;
+    }
+
+private:
+    template<std::integral T>
+    constexpr std::optional<T> parseMagnitude(bool negative)
+    {
+        if (std::is_constant_evaluated())
+        {
+            return parseDigitByDigit<T>(negative);
+        }
+
+        const char* first = text.data() + pos;
+        const char* last = text.data() + text.size();
+
+        if (first == last || !isDigit(*first))
+        {
+            return std::nullopt;
+        }
+
+        if constexpr (detail::hasSwarDigits)
+        {
+            if (last - first >= 8)
+            {
+                int digits = detail::countDigits(first);
+                if (digits < 8)
+                {
+                    std::int64_t magnitude = detail::parseDigits(first, digits);
+                    std::int64_t value = negative ? -magnitude : magnitude;
+                    if (!std::in_range<T>(value))
+                    {
+                        fail("Integer out of range");
+                    }
+                    pos += digits;
+                    return static_cast<T>(value);
+                }
+            }
+        }
+
+        // Long digit runs, the last few bytes of the input and big-endian
+        // targets
+        if (negative)
+        {
+            first--;
+        }
+        T value{};
+        auto [end, error] = std::from_chars(first, last, value);
+        if (error == std::errc::result_out_of_range)
+        {
+            fail("Integer out of range");
+        }
+        if (error != std::errc())
+        {
+            return std::nullopt;
+        }
+        pos = end - text.data();
+        return value;
+    }
+
+    // Without the tricks above, which do not work at compile time
+    template<std::integral T>
+    constexpr std::optional<T> parseDigitByDigit(bool negative)
+    {
+        if (pos >= text.size() || !isDigit(text[pos]))
+        {
+            return std::nullopt;
+        }
+
+        constexpr std::uint64_t max = std::numeric_limits<T>::max();
+        std::uint64_t limit = negative ? max + 1 : max;
+        std::uint64_t magnitude = 0;
+        size_t end = pos;
+        for (; end < text.size() && isDigit(text[end]); ++end)
+        {
+            std::uint64_t digit = text[end] - '0';
+            if (magnitude > (limit - digit) / 10)
+            {
+                fail("Integer out of range");
+            }
+            magnitude = magnitude * 10 + digit;
+        }
+        pos = end;
+        return static_cast<T>(negative ? 0 - magnitude : magnitude);
+    }
+
+    [[noreturn]] void fail(const std::string& what) const
+    {
+        throw std::runtime_error(what + " at \"" + std::string(remaining().substr(0, 20)) + "\"");
+    }
+
+    std::string_view text;
+    size_t pos{0};
+};
+
+
+// Parses a whole string_view as a single integer, surrounding whitespace
+// is allowed.
+template<std::integral T>
+constexpr T toInteger(std::string_view text)
+{
+    Scanner scanner(text);
+    T value = scanner.integer<T>();
+    if (scanner.hasMore())
+    {
+        throw std::runtime_error("Unexpected characters after integer in \"" + std::string(text) + "\"");
+    }
+    return value;
+}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Simd.hpp"
+
+// Searches of a byte value in blocks of 32 bytes, such as small histograms
+// padded to a full register.
+namespace simd
+{
+constexpr int byteBlockSize = 32;
+
+namespace detail
+{
+inline std::uint32_t findByteScalar(const std::uint8_t* block, std::uint8_t value)
+{
+    std::uint32_t found = 0;
+    for (int i = 0; i < byteBlockSize; ++i)
+    {
+        found |= static_cast<std::uint32_t>(block[i] == value) << i;
+    }
+    return found;
+}
+
+
+inline size_t countBlocksWithByteScalar(const std::uint8_t* blocks, size_t numOfBlocks, std::uint8_t value)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < numOfBlocks; ++i)
+    {
+        count += findByteScalar(blocks + i * byteBlockSize, value) != 0;
+    }
+    return count;
+}
+
+
+#if AOC_SIMD_X86
+AOC_TARGET_AVX2 inline std::uint32_t findByteAvx2(const std::uint8_t* block, std::uint8_t value)
+{
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i equal = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(static_cast<char>(value)));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(equal));
+}
+
+
+AOC_TARGET_AVX2 inline size_t countBlocksWithByteAvx2(const std::uint8_t* blocks, size_t numOfBlocks, std::uint8_t value)
+{
+    const __m256i wanted = _mm256_set1_epi8(static_cast<char>(value));
+    size_t count = 0;
+    for (size_t i = 0; i < numOfBlocks; ++i)
+    {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks + i * byteBlockSize));
+        __m256i equal = _mm256_cmpeq_epi8(bytes, wanted);
+        count += !_mm256_testz_si256(equal, equal);
+    }
+    return count;
+}
+#endif
+}
+
+
+// Bit i is set if block[i] is value
+inline std::uint32_t findByte(const std::uint8_t* block, std::uint8_t value)
+{
+#if AOC_SIMD_X86
+    if (useAvx2())
+    {
+        return detail::findByteAvx2(block, value);
+    }
+#endif
+    return detail::findByteScalar(block, value);
+}
+
+
+// How many of the consecutive blocks contain value, one dispatch for all
+// of them
+inline size_t countBlocksWithByte(const std::uint8_t* blocks, size_t numOfBlocks, std::uint8_t value)
+{
+#if AOC_SIMD_X86
+    if (useAvx2())
+    {
+        return detail::countBlocksWithByteAvx2(blocks, numOfBlocks, value);
+    }
+#endif
+    return detail::countBlocksWithByteScalar(blocks, numOfBlocks, value);
+}
+}
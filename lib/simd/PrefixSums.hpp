@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "Simd.hpp"
+
+// Sums and prefix sums of int values in 64 bit, so that no sum of up to 2^32
+// values overflows.
+namespace simd
+{
+namespace detail
+{
+inline long sumScalar(const int* values, size_t size)
+{
+    long total = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        total += values[i];
+    }
+    return total;
+}
+
+
+// Writes start plus the sum of the values before each one to sums, returns
+// start plus the sum of all values
+inline long prefixSumsScalar(const int* values, size_t size, long start, long* sums)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        sums[i] = start;
+        start += values[i];
+    }
+    return start;
+}
+
+
+#if AOC_SIMD_X86
+// Widens eight values at a time into two accumulators of four 64 bit lanes
+AOC_TARGET_AVX2 inline long sumAvx2(const int* values, size_t size)
+{
+    __m256i low = _mm256_setzero_si256();
+    __m256i high = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        low = _mm256_add_epi64(low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(block)));
+        high = _mm256_add_epi64(high, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(block, 1)));
+    }
+
+    __m256i both = _mm256_add_epi64(low, high);
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(both), _mm256_extracti128_si256(both, 1));
+    long total = _mm_cvtsi128_si64(half) + _mm_extract_epi64(half, 1);
+    return total + sumScalar(values + i, size - i);
+}
+
+
+// Scans four values at a time in 64 bit lanes: shifted copies of the
+// block by one and two lanes add up to the inclusive sums within it, the
+// last lane is carried into the next block.
+AOC_TARGET_AVX2 inline long prefixSumsAvx2(const int* values, size_t size, long start, long* sums)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i carry = _mm256_set1_epi64x(start);
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        __m256i block = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+        // [a, b, c, d] + [0, a, b, c]
+        __m256i scan = _mm256_add_epi64(block,
+            _mm256_blend_epi32(_mm256_permute4x64_epi64(block, 0x90), zero, 0x03));
+        // + [0, 0, a, a + b]
+        scan = _mm256_add_epi64(scan,
+            _mm256_blend_epi32(_mm256_permute4x64_epi64(scan, 0x40), zero, 0x0F));
+        scan = _mm256_add_epi64(scan, carry);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums + i), _mm256_sub_epi64(scan, block));
+        carry = _mm256_permute4x64_epi64(scan, 0xFF);
+    }
+    return prefixSumsScalar(values + i, size - i, _mm256_extract_epi64(carry, 0), sums + i);
+}
+#endif
+}
+
+
+inline long sum(std::span<const int> values)
+{
+#if AOC_SIMD_X86
+    if (useAvx2())
+    {
+        return detail::sumAvx2(values.data(), values.size());
+    }
+#endif
+    return detail::sumScalar(values.data(), values.size());
+}
+
+
+// Exclusive prefix sums from start: sums[i] is start plus the sum of the
+// values before i. Returns start plus the sum of all values, so that
+// consecutive blocks of values chain.
+inline long prefixSums(std::span<const int> values, long start, long* sums)
+{
+#if AOC_SIMD_X86
+    if (useAvx2())
+    {
+        return detail::prefixSumsAvx2(values.data(), values.size(), start, sums);
+    }
+#endif
+    return detail::prefixSumsScalar(values.data(), values.size(), start, sums);
+}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+// Kernels are compiled for AVX2 with a function attribute and chosen at run
+// time, the rest of the build stays at the baseline instruction set:
+//
+//     AOC_TARGET_AVX2 long sumAvx2(const int* values, size_t size) { ... }
+//
+//     if (simd::useAvx2())
+//     {
+//         return sumAvx2(values, size);
+//     }
+//     return sumScalar(values, size);
+//
+// AOC_SIMD_X86 is 0 where the intrinsics are not available and with
+// -DAOC_SIMD=OFF, the kernels then only have their scalar versions.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(AOC_NO_SIMD)
+#define AOC_SIMD_X86 1
+#define AOC_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#else
+#define AOC_SIMD_X86 0
+#define AOC_TARGET_AVX2
+#endif
+
+namespace simd
+{
+namespace detail
+{
+// AOC_SIMD=0 in the environment turns the kernels off, to compare them with
+// the scalar versions
+inline std::atomic<bool>& isEnabled()
+{
+    static std::atomic<bool> enabled{[]() {
+        const char* value = std::getenv("AOC_SIMD");
+        return !value || std::strcmp(value, "0") != 0;
+    }()};
+    return enabled;
+}
+}
+
+
+inline bool isAvx2Supported()
+{
+#if AOC_SIMD_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+
+// Whether kernels take their AVX2 path
+inline bool useAvx2()
+{
+    return isAvx2Supported() && detail::isEnabled().load(std::memory_order_relaxed);
+}
+
+
+inline void setEnabled(bool enabled)
+{
+    detail::isEnabled() = enabled;
+}
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Arena.hpp"
+#include "MappedInput.hpp"
+#include "Parallel.hpp"
+#include "Registry.hpp"
+#include "Runner.hpp"
+
+namespace solvers
+{
+// The inputs of a batch: the regular files of a directory sorted by name,
+// or the files listed in a manifest, one per line. Relative paths in a
+// manifest are relative to the manifest, empty lines and lines starting
+// with '#' are skipped.
+inline std::vector<std::filesystem::path> findBatchInputs(const std::filesystem::path& batch)
+{
+    std::vector<std::filesystem::path> inputs;
+    if (std::filesystem::is_directory(batch))
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(batch))
+        {
+            if (entry.is_regular_file())
+            {
+                inputs.push_back(entry.path());
+            }
+        }
+        std::sort(inputs.begin(), inputs.end());
+        return inputs;
+    }
+
+    puzzleInputs::MappedInput manifest(batch);
+    for (std::string_view line : puzzleInputs::Lines(manifest.view()))
+    {
+        while (!line.empty() && (line.back() == ' ' || line.back() == '\r'))
+        {
+            line.remove_suffix(1);
+        }
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+        std::filesystem::path input(line);
+        inputs.push_back(input.is_absolute() ? input : batch.parent_path() / input);
+    }
+    return inputs;
+}
+
+
+// What a thread of the batch keeps from one input to the next. The arenas
+// grow to what the largest input so far needed, so grids, search buffers
+// and the containers of the parsed input reuse the same memory.
+struct Scratch
+{
+    allocations::ScratchArena parseArena;
+    allocations::ScratchArena partArena;
+};
+
+
+struct BatchSummary
+{
+    size_t numOfThreads{0};
+    size_t numOfInputs{0};
+    size_t numOfFailures{0};
+    std::chrono::nanoseconds wallTime{0};
+    // Sum of all parse, build and solve times
+    std::chrono::nanoseconds work{0};
+};
+
+
+// Solves every input with the same solver. The inputs are handed out one
+// at a time to one shard per thread of the pool, so a few slow inputs do
+// not hold up the others. onResult(index, result) is called as soon as an
+// input is solved, in the order they finish and never concurrently; the
+// results are not kept.
+template<typename OnResult>
+BatchSummary runBatch(const Solver& solver, const std::vector<std::filesystem::path>& inputs,
+    parallel::ThreadPool* pool, OnResult onResult)
+{
+    BatchSummary summary;
+    summary.numOfThreads = pool ? pool->getNumOfThreads() : 1;
+    summary.numOfInputs = inputs.size();
+
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    auto start = std::chrono::steady_clock::now();
+
+    parallel::runChunks(pool, std::min(summary.numOfThreads, inputs.size()), [&](size_t) {
+        Scratch scratch;
+        for (size_t i = next++; i < inputs.size(); i = next++)
+        {
+            Result result;
+            try
+            {
+                puzzleInputs::MappedInput text(inputs[i]);
+                result = run(solver, text.view(), scratch.parseArena, scratch.partArena);
+            }
+            catch (const std::exception& e)
+            {
+                result.solver = &solver;
+                result.error = e.what();
+            }
+            scratch.parseArena.release();
+            result.input = inputs[i];
+
+            std::lock_guard lock(mutex);
+            summary.numOfFailures += !result.error.empty();
+            summary.work += result.parseTime + result.buildTime;
+            for (const auto& time : result.solveTimes)
+            {
+                summary.work += time;
+            }
+            onResult(i, result);
+        }
+    });
+
+    summary.wallTime = std::chrono::steady_clock::now() - start;
+    return summary;
+}
+
+
+// On the shared pool the solvers split their work on
+template<typename OnResult>
+BatchSummary runBatch(const Solver& solver, const std::vector<std::filesystem::path>& inputs, OnResult onResult)
+{
+    return runBatch(solver, inputs, parallel::detail::getSharedPoolIfThreaded(), std::move(onResult));
+}
+}
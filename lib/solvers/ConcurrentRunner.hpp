@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "Arena.hpp"
+#include "MappedInput.hpp"
+#include "Registry.hpp"
+#include "ResultCache.hpp"
+#include "Runner.hpp"
+#include "ThreadPool.hpp"
+
+namespace solvers
+{
+struct Job
+{
+    const Solver* solver;
+    std::filesystem::path input;
+};
+
+
+// The longest chain of dependent tasks: a parse and build followed by its
+// slower part. No number of threads gets the wall time below it.
+struct CriticalPath
+{
+    const Result* result{nullptr};
+    int part{0};
+    std::chrono::nanoseconds length{0};
+};
+
+
+struct Summary
+{
+    size_t numOfThreads{0};
+    std::chrono::nanoseconds wallTime{0};
+    // Sum of all parse, build and solve times
+    std::chrono::nanoseconds work{0};
+    CriticalPath criticalPath;
+};
+
+
+inline CriticalPath findCriticalPath(const std::vector<Result>& results)
+{
+    CriticalPath path;
+    for (const auto& result : results)
+    {
+        auto slowest = std::max_element(result.solveTimes.begin(), result.solveTimes.end());
+        auto length = result.parseTime + result.buildTime + *slowest;
+        if (!path.result || length > path.length)
+        {
+            path.result = &result;
+            path.part = static_cast<int>(slowest - result.solveTimes.begin()) + 1;
+            path.length = length;
+        }
+    }
+    return path;
+}
+
+
+// Runs every job on the pool. Each parse and build is a task that submits
+// one task per part once the input is built, so parts of a slow day run side by side
+// with other days. Results are in the order of the jobs.
+inline std::vector<Result> runConcurrently(const std::vector<Job>& jobs, parallel::ThreadPool& pool,
+    Summary* summary = nullptr, const ResultCache* cache = nullptr)
+{
+    // Everything the part tasks of one job share
+    struct State
+    {
+        std::optional<puzzleInputs::MappedInput> text;
+        // Has to outlive parsed, the parts only read from it
+        allocations::Arena parseArena;
+        Solver::Parsed parsed;
+        std::mutex errorMutex;
+        std::optional<Result> cached;
+        std::atomic<int> remainingParts{Solver::numOfParts};
+    };
+
+    std::vector<Result> results(jobs.size());
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        pool.submit([&job = jobs[i], &result = results[i], &pool, cache]() {
+            result.solver = job.solver;
+            result.input = job.input;
+
+            auto state = std::make_shared<State>();
+            try
+            {
+                state->text.emplace(job.input);
+                if (cache)
+                {
+                    state->cached = cache->lookup(*job.solver, state->text->view());
+                    if (state->cached && cache->getMode() == ResultCache::Mode::use)
+                    {
+                        result = *state->cached;
+                        result.input = job.input;
+                        return;
+                    }
+                }
+
+                result.parseTime = measure([&]() {
+                    allocations::ResourceScope scope(state->parseArena);
+                    state->parsed = job.solver->parse(state->text->view());
+                }, result.parseAllocations);
+                result.buildTime = measure([&]() {
+                    allocations::ResourceScope scope(state->parseArena);
+                    state->parsed = job.solver->build(state->parsed);
+                }, result.buildAllocations);
+            }
+            catch (const std::exception& e)
+            {
+                result.error = e.what();
+                return;
+            }
+
+            for (int part = 1; part <= Solver::numOfParts; ++part)
+            {
+                pool.submit([&job, &result, state, part, cache]() {
+                    try
+                    {
+                        allocations::Arena arena;
+                        result.solveTimes[part - 1] = measure([&]() {
+                            allocations::ResourceScope scope(arena);
+                            result.answers[part - 1] = job.solver->solve(part, state->parsed);
+                        }, result.solveAllocations[part - 1]);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::lock_guard lock(state->errorMutex);
+                        result.error = e.what();
+                    }
+
+                    // The last part to finish completes the result
+                    if (--state->remainingParts == 0 && cache)
+                    {
+                        cache->verifyAndStore(result, state->cached, state->text->view());
+                    }
+                });
+            }
+        });
+    }
+    pool.wait();
+
+    if (summary)
+    {
+        summary->numOfThreads = pool.getNumOfThreads();
+        summary->wallTime = std::chrono::steady_clock::now() - start;
+        summary->work = std::chrono::nanoseconds(0);
+        for (const auto& result : results)
+        {
+            summary->work += result.parseTime + result.buildTime;
+            for (const auto& time : result.solveTimes)
+            {
+                summary->work += time;
+            }
+        }
+        summary->criticalPath = findCriticalPath(results);
+    }
+    return results;
+}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace solvers
+{
+// 64 bit content hash for cache keys, not meant to withstand attacks.
+// Eight bytes per step, each mixed with a multiply-xorshift round.
+inline std::uint64_t hash64(std::string_view data, std::uint64_t seed = 0)
+{
+    constexpr std::uint64_t k = 0x9E3779B97F4A7C15ull;
+    auto mix = [](std::uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        return h ^ (h >> 33);
+    };
+
+    std::uint64_t h = seed ^ (data.size() * k);
+    size_t i = 0;
+    for (; i + 8 <= data.size(); i += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data.data() + i, sizeof(word));
+        h = (h ^ mix(word * k)) * k + 0x632BE59BD9B4E019ull;
+    }
+
+    std::uint64_t tail = 0;
+    if (i < data.size())
+    {
+        std::memcpy(&tail, data.data() + i, data.size() - i);
+    }
+    h ^= mix(tail * k + data.size() - i);
+    return mix(h);
+}
+
+
+inline std::string toHex(std::uint64_t value)
+{
+    constexpr char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i, value >>= 4)
+    {
+        hex[i] = digits[value & 0xF];
+    }
+    return hex;
+}
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "Histogram.hpp"
+#include "MappedInput.hpp"
+#include "Registry.hpp"
+#include "Runner.hpp"
+
+namespace solvers
+{
+enum class Phase : int
+{
+    parse = 0,
+    build,
+    part1,
+    part2,
+    // Everything of one run, what a request to the solver would take
+    total,
+    numOf
+};
+
+constexpr size_t numOfPhases = static_cast<size_t>(Phase::numOf);
+
+constexpr std::array<std::string_view, numOfPhases> phaseNames = {
+    "parse", "build", "part1", "part2", "total"
+};
+
+
+// Latencies of the phases of one solver over repeated runs on one input
+struct Latencies
+{
+    const Solver* solver{nullptr};
+    std::filesystem::path input;
+    std::array<profiling::Histogram, numOfPhases> phases;
+    Solver::Answers answers;
+    // Empty when every run succeeded with the same answers
+    std::string error;
+
+    const profiling::Histogram& get(Phase phase) const
+    {
+        return phases[static_cast<size_t>(phase)];
+    }
+
+    void record(const Result& result)
+    {
+        auto total = result.parseTime + result.buildTime;
+        phases[static_cast<size_t>(Phase::parse)].record(result.parseTime);
+        phases[static_cast<size_t>(Phase::build)].record(result.buildTime);
+        for (int part = 1; part <= Solver::numOfParts; ++part)
+        {
+            phases[static_cast<size_t>(Phase::part1) + part - 1].record(result.solveTimes[part - 1]);
+            total += result.solveTimes[part - 1];
+        }
+        phases[static_cast<size_t>(Phase::total)].record(total);
+    }
+};
+
+
+// Solves the text repetitions times, each run from scratch like a single
+// run, and records every phase. The input is read once, so file I/O is not
+// part of any phase. Stops at the first failed run and at answers that
+// differ from the ones of the first run.
+inline Latencies measureLatencies(const Solver& solver, std::string_view text, int repetitions)
+{
+    Latencies latencies;
+    latencies.solver = &solver;
+    for (int i = 0; i < repetitions; ++i)
+    {
+        Result result = run(solver, text);
+        if (!result.error.empty())
+        {
+            latencies.error = result.error;
+            break;
+        }
+        if (i == 0)
+        {
+            latencies.answers = result.answers;
+        }
+        else if (result.answers != latencies.answers)
+        {
+            latencies.error = "Answers differ between repetitions";
+            break;
+        }
+        latencies.record(result);
+    }
+    return latencies;
+}
+
+
+inline Latencies measureLatencies(const Solver& solver, const std::filesystem::path& input, int repetitions)
+{
+    Latencies latencies;
+    try
+    {
+        puzzleInputs::MappedInput text(input);
+        latencies = measureLatencies(solver, text.view(), repetitions);
+    }
+    catch (const std::exception& e)
+    {
+        latencies.solver = &solver;
+        latencies.error = e.what();
+    }
+    latencies.input = input;
+    return latencies;
+}
+}
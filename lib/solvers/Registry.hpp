@@ -0,0 +1,240 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "StreamInput.hpp"
+
+namespace solvers
+{
+// Whatever a solver computes is reported as text.
+template<typename T>
+std::string toAnswer(const T& value)
+{
+    if constexpr (std::is_convertible_v<const T&, std::string>)
+    {
+        return std::string(value);
+    }
+    else
+    {
+        std::ostringstream answer;
+        answer << value;
+        return answer.str();
+    }
+}
+
+
+// One day of one year: a parse step that turns the input text into the
+// solver's own representation and two parts that compute the answers from
+// it. The parsed value may refer to the input text, which has to outlive it.
+// Solvers that precompute something both parts query (a summed-area table,
+// a scoreboard) do it in an optional build step between the two, so that
+// it is timed on its own.
+class Solver
+{
+public:
+    using Parsed = std::shared_ptr<const void>;
+    using Parse = std::function<Parsed(std::string_view)>;
+    using Build = std::function<Parsed(const Parsed&)>;
+    using Part = std::function<std::string(const Parsed&)>;
+    using Answers = std::array<std::string, 2>;
+    // Solves both parts while reading the input once
+    using Stream = std::function<Answers(puzzleInputs::ChunkReader&)>;
+
+    static constexpr int numOfParts = 2;
+
+    Solver(int year, int day, std::filesystem::path defaultInput, Parse parse, std::array<Part, numOfParts> parts) :
+        year(year),
+        day(day),
+        defaultInput(std::move(defaultInput)),
+        parseInput(std::move(parse)),
+        parts(std::move(parts))
+    {
+    }
+
+    int getYear() const
+    {
+        return year;
+    }
+
+    int getDay() const
+    {
+        return day;
+    }
+
+    // "2018/day01"
+    std::string getName() const
+    {
+        return std::to_string(year) + (day < 10 ? "/day0" : "/day") + std::to_string(day);
+    }
+
+    const std::filesystem::path& getDefaultInput() const
+    {
+        return defaultInput;
+    }
+
+    Parsed parse(std::string_view text) const
+    {
+        return parseInput(text);
+    }
+
+    bool hasBuild() const
+    {
+        return static_cast<bool>(buildInput);
+    }
+
+    // What the parts take, the parsed value itself without a build step
+    Parsed build(const Parsed& parsed) const
+    {
+        return buildInput ? buildInput(parsed) : parsed;
+    }
+
+    void setBuild(Build build)
+    {
+        buildInput = std::move(build);
+    }
+
+    // part is 1 or 2
+    std::string solve(int part, const Parsed& parsed) const
+    {
+        return parts.at(part - 1)(parsed);
+    }
+
+    bool canStream() const
+    {
+        return static_cast<bool>(streamInput);
+    }
+
+    Answers stream(puzzleInputs::ChunkReader& input) const
+    {
+        return streamInput(input);
+    }
+
+    void setStream(Stream stream)
+    {
+        streamInput = std::move(stream);
+    }
+
+private:
+    int year;
+    int day;
+    std::filesystem::path defaultInput;
+    Parse parseInput;
+    Build buildInput;
+    std::array<Part, numOfParts> parts;
+    Stream streamInput;
+};
+
+
+class Registry
+{
+public:
+    // parse takes the input text and returns any type T, part1 and part2
+    // take a const T& and return anything that toAnswer accepts.
+    template<typename ParseFunction, typename Part1, typename Part2>
+    void add(int year, int day, std::filesystem::path defaultInput,
+        ParseFunction parse, Part1 part1, Part2 part2)
+    {
+        using T = std::decay_t<std::invoke_result_t<ParseFunction, std::string_view>>;
+
+        solvers.emplace_back(year, day, std::move(defaultInput),
+            [parse](std::string_view text) -> Solver::Parsed {
+                return std::make_shared<const T>(parse(text));
+            },
+            std::array<Solver::Part, Solver::numOfParts>{
+                makePart<T>(std::move(part1)),
+                makePart<T>(std::move(part2))
+            });
+    }
+
+    // With a build step between: build takes the parsed const T& and
+    // returns any type U, part1 and part2 take a const U&. The parsed value
+    // is kept alive as long as the built one, which may refer to it.
+    template<typename ParseFunction, typename BuildFunction, typename Part1, typename Part2>
+    void add(int year, int day, std::filesystem::path defaultInput,
+        ParseFunction parse, BuildFunction build, Part1 part1, Part2 part2)
+    {
+        using T = std::decay_t<std::invoke_result_t<ParseFunction, std::string_view>>;
+        using U = std::decay_t<std::invoke_result_t<BuildFunction, const T&>>;
+
+        struct Built
+        {
+            Solver::Parsed parsed;
+            U value;
+        };
+
+        solvers.emplace_back(year, day, std::move(defaultInput),
+            [parse](std::string_view text) -> Solver::Parsed {
+                return std::make_shared<const T>(parse(text));
+            },
+            std::array<Solver::Part, Solver::numOfParts>{
+                makePart<U>(std::move(part1)),
+                makePart<U>(std::move(part2))
+            });
+        solvers.back().setBuild([build](const Solver::Parsed& parsed) -> Solver::Parsed {
+            auto built = std::make_shared<const Built>(Built{parsed, build(*static_cast<const T*>(parsed.get()))});
+            return Solver::Parsed(built, &built->value);
+        });
+    }
+
+    // Lets an added solver consume its input as it arrives. stream takes a
+    // puzzleInputs::ChunkReader& and returns a pair of answers.
+    template<typename StreamFunction>
+    void addStream(int year, int day, StreamFunction stream)
+    {
+        for (auto& solver : solvers)
+        {
+            if (solver.getYear() == year && solver.getDay() == day)
+            {
+                solver.setStream([stream](puzzleInputs::ChunkReader& input) {
+                    auto [part1, part2] = stream(input);
+                    return Solver::Answers{toAnswer(part1), toAnswer(part2)};
+                });
+                return;
+            }
+        }
+        throw std::invalid_argument("No solver for " + std::to_string(year) + " day " + std::to_string(day));
+    }
+
+    const std::vector<Solver>& getSolvers() const
+    {
+        return solvers;
+    }
+
+    // All solvers, the ones of a year or a single day.
+    std::vector<const Solver*> select(std::optional<int> year = std::nullopt,
+        std::optional<int> day = std::nullopt) const
+    {
+        std::vector<const Solver*> selected;
+        for (const auto& solver : solvers)
+        {
+            if ((!year || solver.getYear() == *year) && (!day || solver.getDay() == *day))
+            {
+                selected.push_back(&solver);
+            }
+        }
+        return selected;
+    }
+
+private:
+    template<typename T, typename PartFunction>
+    static Solver::Part makePart(PartFunction part)
+    {
+        return [part](const Solver::Parsed& parsed) {
+            return toAnswer(part(*static_cast<const T*>(parsed.get())));
+        };
+    }
+
+    std::vector<Solver> solvers;
+};
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BatchRunner.hpp"
+#include "ConcurrentRunner.hpp"
+#include "Latencies.hpp"
+#include "Runner.hpp"
+
+namespace solvers
+{
+inline double toMilliseconds(std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+
+inline std::string escapeJson(std::string_view text)
+{
+    std::string escaped;
+    for (char c : text)
+    {
+        switch (c)
+        {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", c);
+                    escaped += code;
+                }
+                else
+                {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+
+// "  12 allocs      4096 B  peak      1024 B", empty without tracking
+inline std::string formatAllocations(const allocations::Stats& stats)
+{
+    if (!allocations::isTracking())
+    {
+        return "";
+    }
+    std::ostringstream text;
+    text << std::setw(10) << stats.count << " allocs "
+        << std::setw(12) << stats.bytes << " B  peak "
+        << std::setw(12) << stats.peak << " B";
+    return text.str();
+}
+
+
+inline std::string formatJsonAllocations(const allocations::Stats& stats)
+{
+    std::ostringstream json;
+    json << "{\"count\": " << stats.count
+        << ", \"bytes\": " << stats.bytes
+        << ", \"peak\": " << stats.peak << "}";
+    return json.str();
+}
+
+
+inline void printText(std::ostream& out, const std::vector<Result>& results)
+{
+    out << std::fixed << std::setprecision(3);
+    for (const auto& result : results)
+    {
+        out << result.solver->getName() << "  " << result.input.string()
+            << (result.cached ? "  (cached)" : "") << '\n';
+        if (!result.error.empty())
+        {
+            out << "  error: " << result.error << '\n';
+            continue;
+        }
+
+        // A streamed run solves both parts while parsing
+        out << (result.streamed ? "  stream  " : "  parse   ") << std::setw(10) << toMilliseconds(result.parseTime) << " ms"
+            << formatAllocations(result.parseAllocations) << '\n';
+        if (result.solver->hasBuild() && !result.streamed)
+        {
+            out << "  build   " << std::setw(10) << toMilliseconds(result.buildTime) << " ms"
+                << formatAllocations(result.buildAllocations) << '\n';
+        }
+        for (int part = 1; part <= Solver::numOfParts; ++part)
+        {
+            const std::string& answer = result.answers[part - 1];
+            out << "  part " << part << "  " << std::setw(10) << toMilliseconds(result.solveTimes[part - 1]) << " ms"
+                << formatAllocations(result.solveAllocations[part - 1]);
+            // Multi-line answers (rendered letters) start on their own line
+            out << (answer.find('\n') == std::string::npos ? "  " : "\n") << answer << '\n';
+        }
+    }
+}
+
+
+inline void printJsonResult(std::ostream& out, const Result& result)
+{
+    out << "{\"year\": " << result.solver->getYear()
+        << ", \"day\": " << result.solver->getDay()
+        << ", \"input\": \"" << escapeJson(result.input.string()) << "\""
+        << ", \"cached\": " << (result.cached ? "true" : "false")
+        << ", \"streamed\": " << (result.streamed ? "true" : "false");
+
+    if (result.error.empty())
+    {
+        out << ", \"parse_ns\": " << result.parseTime.count();
+        if (allocations::isTracking())
+        {
+            out << ", \"parse_allocations\": " << formatJsonAllocations(result.parseAllocations);
+        }
+        if (result.solver->hasBuild() && !result.streamed)
+        {
+            out << ", \"build_ns\": " << result.buildTime.count();
+            if (allocations::isTracking())
+            {
+                out << ", \"build_allocations\": " << formatJsonAllocations(result.buildAllocations);
+            }
+        }
+        out << ", \"parts\": [";
+        for (int part = 1; part <= Solver::numOfParts; ++part)
+        {
+            out << (part > 1 ? ", " : "")
+                << "{\"part\": " << part
+                << ", \"answer\": \"" << escapeJson(result.answers[part - 1]) << "\""
+                << ", \"solve_ns\": " << result.solveTimes[part - 1].count();
+            if (allocations::isTracking())
+            {
+                out << ", \"allocations\": " << formatJsonAllocations(result.solveAllocations[part - 1]);
+            }
+            out << "}";
+        }
+        out << "]";
+    }
+    else
+    {
+        out << ", \"error\": \"" << escapeJson(result.error) << "\"";
+    }
+    out << "}";
+}
+
+
+inline void printJsonResults(std::ostream& out, const std::vector<Result>& results, std::string_view indent)
+{
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        out << indent << "  ";
+        printJsonResult(out, results[i]);
+        out << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    out << indent << "]";
+}
+
+
+inline void printJson(std::ostream& out, const std::vector<Result>& results)
+{
+    printJsonResults(out, results, "");
+    out << '\n';
+}
+
+
+inline void printSummary(std::ostream& out, const Summary& summary)
+{
+    const auto& path = summary.criticalPath;
+    out << std::fixed << std::setprecision(3)
+        << "threads        " << summary.numOfThreads << '\n'
+        << "wall time      " << std::setw(10) << toMilliseconds(summary.wallTime) << " ms\n"
+        << "work           " << std::setw(10) << toMilliseconds(summary.work) << " ms\n"
+        << "critical path  " << std::setw(10) << toMilliseconds(path.length) << " ms";
+    if (path.result)
+    {
+        out << "  " << path.result->solver->getName() << " parse + part " << path.part;
+    }
+    out << '\n';
+}
+
+
+// With a summary the results move into an object next to it.
+inline void printJson(std::ostream& out, const std::vector<Result>& results, const Summary& summary)
+{
+    const auto& path = summary.criticalPath;
+    out << "{\n"
+        << "  \"threads\": " << summary.numOfThreads << ",\n"
+        << "  \"wall_ns\": " << summary.wallTime.count() << ",\n"
+        << "  \"work_ns\": " << summary.work.count() << ",\n"
+        << "  \"critical_path\": {\"length_ns\": " << path.length.count();
+    if (path.result)
+    {
+        out << ", \"year\": " << path.result->solver->getYear()
+            << ", \"day\": " << path.result->solver->getDay()
+            << ", \"part\": " << path.part;
+    }
+    out << "},\n"
+        << "  \"results\": ";
+    printJsonResults(out, results, "  ");
+    out << "\n}\n";
+}
+
+
+// One line per input of a batch as soon as it is solved:
+// "<input>  <parse + build + solve time> ms  <part 1>  <part 2>". Multi-line
+// answers are written with \n escapes to keep it one line.
+inline void printBatchResult(std::ostream& out, const Result& result)
+{
+    out << result.input.string();
+    if (!result.error.empty())
+    {
+        out << "  error: " << result.error << std::endl;
+        return;
+    }
+
+    auto time = result.parseTime + result.buildTime;
+    for (const auto& solveTime : result.solveTimes)
+    {
+        time += solveTime;
+    }
+    out << std::fixed << std::setprecision(3) << "  " << toMilliseconds(time) << " ms";
+    for (const auto& answer : result.answers)
+    {
+        out << "  " << (answer.find('\n') == std::string::npos ? answer : escapeJson(answer));
+    }
+    out << std::endl;
+}
+
+
+// The same as a line of JSON, for JSON Lines output
+inline void printBatchJsonResult(std::ostream& out, const Result& result)
+{
+    printJsonResult(out, result);
+    out << std::endl;
+}
+
+
+inline void printBatchSummary(std::ostream& out, const BatchSummary& summary)
+{
+    out << std::fixed << std::setprecision(3)
+        << "inputs         " << summary.numOfInputs << '\n'
+        << "failed         " << summary.numOfFailures << '\n'
+        << "threads        " << summary.numOfThreads << '\n'
+        << "wall time      " << std::setw(10) << toMilliseconds(summary.wallTime) << " ms\n"
+        << "work           " << std::setw(10) << toMilliseconds(summary.work) << " ms" << std::endl;
+}
+
+
+// p50, p99 and max of every phase in ms, solvers without a build step have
+// no build line
+inline void printLatencies(std::ostream& out, const std::vector<Latencies>& results)
+{
+    out << std::fixed << std::setprecision(3);
+    for (const auto& latencies : results)
+    {
+        const auto& total = latencies.get(Phase::total);
+        out << latencies.solver->getName() << "  " << latencies.input.string()
+            << "  " << total.getCount() << (total.getCount() == 1 ? " run\n" : " runs\n");
+        if (!latencies.error.empty())
+        {
+            out << "  error: " << latencies.error << '\n';
+        }
+        if (total.getCount() == 0)
+        {
+            continue;
+        }
+
+        out << "          " << std::setw(10) << "p50 ms" << std::setw(11) << "p99 ms" << std::setw(11) << "max ms" << '\n';
+        for (size_t i = 0; i < numOfPhases; ++i)
+        {
+            if (static_cast<Phase>(i) == Phase::build && !latencies.solver->hasBuild())
+            {
+                continue;
+            }
+            const auto& histogram = latencies.phases[i];
+            out << "  " << std::left << std::setw(6) << phaseNames[i] << std::right << "  "
+                << std::setw(10) << toMilliseconds(histogram.getPercentileDuration(50)) << ' '
+                << std::setw(10) << toMilliseconds(histogram.getPercentileDuration(99)) << ' '
+                << std::setw(10) << toMilliseconds(std::chrono::nanoseconds(histogram.getMax())) << '\n';
+        }
+    }
+}
+
+
+inline void printJsonLatencies(std::ostream& out, const std::vector<Latencies>& results)
+{
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& latencies = results[i];
+        out << "  {\"year\": " << latencies.solver->getYear()
+            << ", \"day\": " << latencies.solver->getDay()
+            << ", \"input\": \"" << escapeJson(latencies.input.string()) << "\""
+            << ", \"runs\": " << latencies.get(Phase::total).getCount();
+        if (!latencies.error.empty())
+        {
+            out << ", \"error\": \"" << escapeJson(latencies.error) << "\"";
+        }
+        out << ", \"phases\": {";
+        const char* separator = "";
+        for (size_t phase = 0; phase < numOfPhases; ++phase)
+        {
+            if (static_cast<Phase>(phase) == Phase::build && !latencies.solver->hasBuild())
+            {
+                continue;
+            }
+            const auto& histogram = latencies.phases[phase];
+            out << separator << "\"" << phaseNames[phase] << "\": {"
+                << "\"min_ns\": " << histogram.getMin()
+                << ", \"mean_ns\": " << static_cast<std::uint64_t>(histogram.getMean())
+                << ", \"p50_ns\": " << histogram.getPercentile(50)
+                << ", \"p99_ns\": " << histogram.getPercentile(99)
+                << ", \"max_ns\": " << histogram.getMax() << "}";
+            separator = ", ";
+        }
+        out << "}}" << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    out << "]\n";
+}
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unistd.h>
+
+#include "Hash.hpp"
+#include "MappedInput.hpp"
+#include "Registry.hpp"
+#include "Runner.hpp"
+
+namespace solvers
+{
+// Any rebuild may change any solver, so the binary itself identifies the
+// build: the hash of the running executable. nullopt if it cannot be read,
+// no other value would tell builds apart.
+inline std::optional<std::uint64_t> hashExecutable()
+{
+    static const std::optional<std::uint64_t> hash = []() -> std::optional<std::uint64_t> {
+        try
+        {
+            puzzleInputs::MappedInput executable(std::filesystem::read_symlink("/proc/self/exe"));
+            return hash64(executable.view());
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+    }();
+    return hash;
+}
+
+
+// $XDG_CACHE_HOME/aoc, ~/.cache/aoc or a directory below /tmp
+inline std::filesystem::path getDefaultCacheDirectory()
+{
+    if (const char* cache = std::getenv("XDG_CACHE_HOME"); cache && *cache)
+    {
+        return std::filesystem::path(cache) / "aoc";
+    }
+    if (const char* home = std::getenv("HOME"); home && *home)
+    {
+        return std::filesystem::path(home) / ".cache" / "aoc";
+    }
+    return std::filesystem::temp_directory_path() / "aoc-cache";
+}
+
+
+// Answers and timings on disk, one file per (solver, build, input content).
+// Files are written to a temporary name and renamed, so concurrent runs
+// never see half written entries. Without a build hash nothing is looked up
+// or stored, every run solves.
+class ResultCache
+{
+public:
+    enum class Mode
+    {
+        // Return cached results, solve and store missing ones
+        use,
+        // Always solve, report answers that differ from the cached ones
+        // as errors and store the new results
+        verify
+    };
+
+    ResultCache(std::filesystem::path directory, Mode mode = Mode::use,
+        std::optional<std::uint64_t> buildHash = hashExecutable()) :
+        directory(std::move(directory)),
+        mode(mode),
+        buildHash(buildHash)
+    {
+    }
+
+    Mode getMode() const
+    {
+        return mode;
+    }
+
+    bool isEnabled() const
+    {
+        return buildHash.has_value();
+    }
+
+    std::filesystem::path getPath(const Solver& solver, std::string_view input) const
+    {
+        std::string name = solver.getName();
+        std::uint64_t key = hash64(name, buildHash.value_or(0));
+        std::string file = std::to_string(solver.getYear());
+        file += (solver.getDay() < 10 ? "-day0" : "-day");
+        file += std::to_string(solver.getDay());
+        file += '-';
+        file += toHex(key);
+        file += '-';
+        file += toHex(hash64(input));
+        return directory / file;
+    }
+
+    std::optional<Result> lookup(const Solver& solver, std::string_view input) const
+    {
+        if (!isEnabled())
+        {
+            return std::nullopt;
+        }
+        std::ifstream file(getPath(solver, input), std::ios::binary);
+        if (!file)
+        {
+            return std::nullopt;
+        }
+
+        Result result;
+        result.solver = &solver;
+        std::string magic;
+        std::int64_t parseTime = 0;
+        std::int64_t buildTime = 0;
+        file >> magic >> parseTime >> buildTime;
+        if (!file || magic != fileMagic)
+        {
+            return std::nullopt;
+        }
+        result.parseTime = std::chrono::nanoseconds(parseTime);
+        result.buildTime = std::chrono::nanoseconds(buildTime);
+
+        for (int part = 1; part <= Solver::numOfParts; ++part)
+        {
+            std::int64_t solveTime = 0;
+            size_t length = 0;
+            file >> solveTime >> length;
+            if (!file || file.get() != '\n')
+            {
+                return std::nullopt;
+            }
+            std::string& answer = result.answers[part - 1];
+            answer.resize(length);
+            file.read(answer.data(), static_cast<std::streamsize>(length));
+            if (!file)
+            {
+                return std::nullopt;
+            }
+            result.solveTimes[part - 1] = std::chrono::nanoseconds(solveTime);
+        }
+        result.cached = true;
+        return result;
+    }
+
+    // Failed results are not stored. Errors while writing are ignored, the
+    // cache is only an optimisation.
+    void store(const Result& result, std::string_view input) const
+    {
+        if (!result.error.empty() || !isEnabled())
+        {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        auto path = getPath(*result.solver, input);
+        auto temporary = path;
+        temporary += ".tmp";
+        temporary += std::to_string(::getpid());
+        temporary += '-';
+        temporary += std::to_string(nextTemporary());
+
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file << fileMagic << ' ' << result.parseTime.count() << ' ' << result.buildTime.count() << '\n';
+            for (int part = 1; part <= Solver::numOfParts; ++part)
+            {
+                const std::string& answer = result.answers[part - 1];
+                file << result.solveTimes[part - 1].count() << ' ' << answer.size() << '\n' << answer << '\n';
+            }
+            if (!file)
+            {
+                std::filesystem::remove(temporary, error);
+                return;
+            }
+        }
+        std::filesystem::rename(temporary, path, error);
+        if (error)
+        {
+            std::filesystem::remove(temporary, error);
+        }
+    }
+
+    // Compares a fresh result with the cached one, if any, and stores it
+    // unless they differ.
+    void verifyAndStore(Result& result, const std::optional<Result>& cached, std::string_view input) const
+    {
+        if (cached && result.error.empty())
+        {
+            for (int part = 1; part <= Solver::numOfParts; ++part)
+            {
+                if (cached->answers[part - 1] != result.answers[part - 1])
+                {
+                    result.error = "Part ";
+                    result.error += std::to_string(part);
+                    result.error += " differs from the cached answer \"";
+                    result.error += cached->answers[part - 1];
+                    result.error += '"';
+                    return;
+                }
+            }
+        }
+        store(result, input);
+    }
+
+private:
+    static constexpr std::string_view fileMagic = "aoc-result-v2";
+
+    static unsigned long nextTemporary()
+    {
+        static std::atomic<unsigned long> counter{0};
+        return counter++;
+    }
+
+    std::filesystem::path directory;
+    Mode mode;
+    std::optional<std::uint64_t> buildHash;
+};
+
+
+// Runs the solver unless the cache already knows the answers for this
+// input. In verify mode it always runs and compares.
+inline Result runCached(const Solver& solver, std::string_view text, const ResultCache& cache)
+{
+    std::optional<Result> cached = cache.lookup(solver, text);
+    if (cached && cache.getMode() == ResultCache::Mode::use)
+    {
+        return *cached;
+    }
+
+    Result result = run(solver, text);
+    cache.verifyAndStore(result, cached, text);
+    return result;
+}
+
+
+inline Result runCached(const Solver& solver, const std::filesystem::path& input, const ResultCache& cache)
+{
+    Result result;
+    try
+    {
+        puzzleInputs::MappedInput text(input);
+        result = runCached(solver, text.view(), cache);
+    }
+    catch (const std::exception& e)
+    {
+        result.solver = &solver;
+        result.error = e.what();
+    }
+    result.input = input;
+    return result;
+}
+}
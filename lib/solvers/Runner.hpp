@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "Allocations.hpp"
+#include "Arena.hpp"
+#include "MappedInput.hpp"
+#include "StreamInput.hpp"
+#include "Registry.hpp"
+
+namespace solvers
+{
+struct Result
+{
+    const Solver* solver{nullptr};
+    std::filesystem::path input;
+    std::chrono::nanoseconds parseTime{0};
+    // Zero for solvers without a build step
+    std::chrono::nanoseconds buildTime{0};
+    std::array<std::string, Solver::numOfParts> answers;
+    std::array<std::chrono::nanoseconds, Solver::numOfParts> solveTimes{};
+    // Only filled when allocations are tracked
+    allocations::Stats parseAllocations;
+    allocations::Stats buildAllocations;
+    std::array<allocations::Stats, Solver::numOfParts> solveAllocations;
+    // Empty when the solver succeeded
+    std::string error;
+    // Answers and timings come from the ResultCache
+    bool cached{false};
+    // Both parts were solved while reading, parseTime covers everything
+    bool streamed{false};
+};
+
+
+template<typename Function>
+std::chrono::nanoseconds measure(Function&& function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::steady_clock::now() - start;
+}
+
+
+// Also counts the allocations made by the function on this thread.
+template<typename Function>
+std::chrono::nanoseconds measure(Function&& function, allocations::Stats& allocated)
+{
+    allocations::Scope scope;
+    auto time = measure(std::forward<Function>(function));
+    allocated = scope.stop();
+    return time;
+}
+
+
+// Parses the text once, builds what the parts query and runs both parts on
+// it. Exceptions thrown by the solver end up in Result::error.
+//
+// The parsed and built input is allocated from parseArena, each part from partArena,
+// which is released once the part is solved. parseArena has to be released
+// by the caller, the result does not refer to it.
+template<typename ParseArena, typename PartArena>
+Result run(const Solver& solver, std::string_view text, ParseArena& parseArena, PartArena& partArena)
+{
+    Result result;
+    result.solver = &solver;
+
+    try
+    {
+        Solver::Parsed parsed;
+        result.parseTime = measure([&]() {
+            allocations::ResourceScope scope(parseArena);
+            parsed = solver.parse(text);
+        }, result.parseAllocations);
+        result.buildTime = measure([&]() {
+            allocations::ResourceScope scope(parseArena);
+            parsed = solver.build(parsed);
+        }, result.buildAllocations);
+
+        for (int part = 1; part <= Solver::numOfParts; ++part)
+        {
+            result.solveTimes[part - 1] = measure([&]() {
+                allocations::ResourceScope scope(partArena);
+                result.answers[part - 1] = solver.solve(part, parsed);
+            }, result.solveAllocations[part - 1]);
+            partArena.release();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        partArena.release();
+        result.error = e.what();
+    }
+    return result;
+}
+
+
+// The parsed input lives in an arena of its own, each part allocates from
+// an arena that is dropped as a whole once the part is solved.
+inline Result run(const Solver& solver, std::string_view text)
+{
+    allocations::Arena parseArena;
+    allocations::Arena partArena;
+    return run(solver, text, parseArena, partArena);
+}
+
+
+inline Result run(const Solver& solver, const std::filesystem::path& input)
+{
+    Result result;
+    try
+    {
+        puzzleInputs::MappedInput text(input);
+        result = run(solver, text.view());
+    }
+    catch (const std::exception& e)
+    {
+        result.solver = &solver;
+        result.error = e.what();
+    }
+    result.input = input;
+    return result;
+}
+
+
+// Input that can only be read once. Solvers that support it consume the
+// chunks as they arrive, the others get the whole text.
+inline Result run(const Solver& solver, puzzleInputs::ChunkReader& input, std::filesystem::path name = "-")
+{
+    Result result;
+    if (solver.canStream())
+    {
+        result.solver = &solver;
+        result.streamed = true;
+        try
+        {
+            allocations::Arena arena;
+            result.parseTime = measure([&]() {
+                allocations::ResourceScope scope(arena);
+                result.answers = solver.stream(input);
+            }, result.parseAllocations);
+        }
+        catch (const std::exception& e)
+        {
+            result.error = e.what();
+        }
+    }
+    else
+    {
+        try
+        {
+            std::string text = puzzleInputs::readAll(input);
+            result = run(solver, std::string_view(text));
+        }
+        catch (const std::exception& e)
+        {
+            result.solver = &solver;
+            result.error = e.what();
+        }
+    }
+    result.input = std::move(name);
+    return result;
+}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <CppUTest/MemoryLeakWarningPlugin.h>
+#include <CppUTest/TestHarness.h>
+#include <CppUTest/TestPlugin.h>
+#include <CppUTest/TestRegistry.h>
+
+#include "TestTiming.hpp"
+
+namespace testTiming
+{
+// Feeds the tests of a CppUTest run into a Recorder. Install it with
+// TestRegistry::getCurrentRegistry()->installPlugin(), the -r option of
+// CommandLineTestRunner repeats the tests.
+//
+// CommandLineTestRunner installs its MemoryLeakWarningPlugin after this one, so
+// postTestAction runs inside the leak checked window of each test. The samples
+// are therefore allocated with the new/delete overloads disabled, and must be
+// freed that way too: call disableLeakDetection() once the tests have run.
+class CppUTestPlugin : public TestPlugin
+{
+public:
+    explicit CppUTestPlugin(Recorder& recorderIn) :
+        TestPlugin("TestTiming"),
+        recorder(recorderIn)
+    {
+    }
+
+    void preTestAction(UtestShell&, TestResult& result) override
+    {
+        failuresBefore = result.getFailureCount();
+        recorder.start();
+    }
+
+    void postTestAction(UtestShell& test, TestResult& result) override
+    {
+        MemoryLeakWarningPlugin::saveAndDisableNewDeleteOverloads();
+        {
+            std::string name = test.getGroup().asCharString();
+            name += '.';
+            name += test.getName().asCharString();
+            recorder.stop(name, result.getFailureCount() == failuresBefore);
+        }
+        MemoryLeakWarningPlugin::restoreNewDeleteOverloads();
+    }
+
+    static void disableLeakDetection()
+    {
+        MemoryLeakWarningPlugin::saveAndDisableNewDeleteOverloads();
+    }
+
+private:
+    Recorder& recorder;
+    size_t failuresBefore{0};
+};
+}
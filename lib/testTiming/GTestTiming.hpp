@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "TestTiming.hpp"
+
+namespace testTiming
+{
+// Feeds the tests of a gtest run into a Recorder. gtest owns the listener
+// once it is appended, the recorder has to outlive RUN_ALL_TESTS().
+class GTestListener : public testing::EmptyTestEventListener
+{
+public:
+    explicit GTestListener(Recorder& recorderIn) : recorder(recorderIn)
+    {
+    }
+
+    void OnTestStart(const testing::TestInfo&) override
+    {
+        recorder.start();
+    }
+
+    void OnTestEnd(const testing::TestInfo& info) override
+    {
+        std::string test = info.test_suite_name();
+        test += '.';
+        test += info.name();
+        recorder.stop(test, !info.result()->Failed());
+    }
+
+private:
+    Recorder& recorder;
+};
+
+
+// Call after testing::InitGoogleTest(). AOC_TEST_REPEAT maps to
+// --gtest_repeat, which still wins when given on the command line.
+inline void install(Recorder& recorder, const Options& options)
+{
+    if (!options.output)
+    {
+        return;
+    }
+    if (options.repeat > 1 && GTEST_FLAG_GET(repeat) == 1)
+    {
+        GTEST_FLAG_SET(repeat, options.repeat);
+    }
+    testing::UnitTest::GetInstance()->listeners().Append(new GTestListener(recorder));
+}
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "Json.hpp"
+
+namespace testTiming
+{
+// Peak resident set size of the process in bytes. On Linux the peak can be
+// reset, so it is the peak since the last resetPeakRss().
+inline size_t getPeakRss()
+{
+#if defined(__linux__)
+    if (std::FILE* status = std::fopen("/proc/self/status", "r"))
+    {
+        char line[256];
+        size_t kilobytes = 0;
+        bool found = false;
+        while (!found && std::fgets(line, sizeof(line), status))
+        {
+            found = std::sscanf(line, "VmHWM: %zu kB", &kilobytes) == 1;
+        }
+        std::fclose(status);
+        if (found)
+        {
+            return kilobytes * 1024;
+        }
+    }
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#else
+    return 0;
+#endif
+}
+
+
+// Sets the peak resident set size back to the current one, false where the
+// kernel does not support it and the peak is the one of the whole process
+inline bool resetPeakRss()
+{
+#if defined(__linux__)
+    std::FILE* clearRefs = std::fopen("/proc/self/clear_refs", "w");
+    if (!clearRefs)
+    {
+        return false;
+    }
+    bool reset = std::fputs("5", clearRefs) >= 0;
+    return std::fclose(clearRefs) == 0 && reset;
+#else
+    return false;
+#endif
+}
+
+
+// CPU time of all threads of the process, the solvers run on a thread pool
+inline std::chrono::nanoseconds getCpuTime()
+{
+    timespec time{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+
+struct Sample
+{
+    std::chrono::nanoseconds wallTime{0};
+    std::chrono::nanoseconds cpuTime{0};
+    size_t peakRss{0};
+    bool passed{true};
+};
+
+
+// AOC_TEST_TIMING names the JSON file to write, nothing is recorded without
+// it. AOC_TEST_REPEAT runs the tests that many times, which gives the
+// baseline the repetitions it needs for the median and the noise.
+struct Options
+{
+    std::optional<std::filesystem::path> output;
+    int repeat{1};
+
+    static Options fromEnvironment()
+    {
+        Options options;
+        if (const char* output = std::getenv("AOC_TEST_TIMING"); output && *output)
+        {
+            options.output = output;
+        }
+        if (const char* repeat = std::getenv("AOC_TEST_REPEAT"))
+        {
+            options.repeat = std::max(1, std::atoi(repeat));
+        }
+        return options;
+    }
+};
+
+
+// Measures the tests one at a time, the test framework calls start() and
+// stop() around each of them. The results are written in the JSON format of
+// google benchmark, one run per test and repetition, so that benchgate can
+// record and compare them like any benchmark:
+//
+//     AOC_TEST_TIMING=timing.json AOC_TEST_REPEAT=10 aoc2018 --gtest_filter=*.solution
+//     benchgate compare baseline.json timing.json
+class Recorder
+{
+public:
+    void start()
+    {
+        resetPeakRss();
+        startCpuTime = getCpuTime();
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    void stop(const std::string& test, bool passed)
+    {
+        Sample sample;
+        sample.wallTime = std::chrono::steady_clock::now() - startTime;
+        sample.cpuTime = getCpuTime() - startCpuTime;
+        sample.peakRss = getPeakRss();
+        sample.passed = passed;
+
+        auto [it, inserted] = samples.try_emplace(test);
+        if (inserted)
+        {
+            order.push_back(test);
+        }
+        it->second.push_back(sample);
+    }
+
+    const std::vector<Sample>& getSamples(const std::string& test) const
+    {
+        return samples.at(test);
+    }
+
+    size_t getNumOfTests() const
+    {
+        return order.size();
+    }
+
+    benchmarking::Json toJson(std::string_view executable) const
+    {
+        using benchmarking::Json;
+
+        Json output;
+        Json& context = output["context"];
+        context["executable"] = std::string(executable);
+        context["host_name"] = getHostName();
+        context["num_cpus"] = std::thread::hardware_concurrency();
+#if defined(NDEBUG)
+        context["library_build_type"] = "release";
+#else
+        context["library_build_type"] = "debug";
+#endif
+
+        Json::Array benchmarks;
+        for (const std::string& test : order)
+        {
+            const std::vector<Sample>& runs = samples.at(test);
+            for (size_t i = 0; i < runs.size(); ++i)
+            {
+                Json run;
+                run["name"] = test;
+                run["run_name"] = test;
+                run["run_type"] = "iteration";
+                run["repetitions"] = runs.size();
+                run["repetition_index"] = i;
+                run["threads"] = 1;
+                run["iterations"] = 1;
+                run["real_time"] = std::chrono::duration<double, std::milli>(runs[i].wallTime).count();
+                run["cpu_time"] = std::chrono::duration<double, std::milli>(runs[i].cpuTime).count();
+                run["time_unit"] = "ms";
+                run["peak_rss_bytes"] = runs[i].peakRss;
+                if (!runs[i].passed)
+                {
+                    // Failed runs say nothing about the performance
+                    run["error_occurred"] = true;
+                    run["error_message"] = "Test failed";
+                }
+                benchmarks.push_back(std::move(run));
+            }
+        }
+        output["benchmarks"] = std::move(benchmarks);
+        return output;
+    }
+
+    void write(const std::filesystem::path& path, std::string_view executable) const
+    {
+        std::ofstream file(path);
+        file << toJson(executable) << '\n';
+        if (!file)
+        {
+            throw std::runtime_error("Cannot write " + path.string());
+        }
+    }
+
+private:
+    static std::string getHostName()
+    {
+#if defined(__linux__)
+        char name[256] = {};
+        if (gethostname(name, sizeof(name) - 1) == 0)
+        {
+            return name;
+        }
+#endif
+        return "unknown";
+    }
+
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::nanoseconds startCpuTime{0};
+    std::map<std::string, std::vector<Sample>> samples;
+    std::vector<std::string> order;
+};
+
+
+// Writes the results if AOC_TEST_TIMING asked for them, returns the exit
+// code of the test run or 1 if the file cannot be written
+inline int finish(const Recorder& recorder, const Options& options, const char* executable, int result)
+{
+    if (!options.output)
+    {
+        return result;
+    }
+    try
+    {
+        recorder.write(*options.output, std::filesystem::path(executable).filename().string());
+        std::fprintf(stderr, "Timing of %zu tests written to %s\n", recorder.getNumOfTests(), options.output->c_str());
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return result;
+}
+}
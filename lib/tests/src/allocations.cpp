@@ -0,0 +1,180 @@
+#include <list>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Allocations.hpp"
+#include "Arena.hpp"
+
+namespace allocations {
+
+// The library tests link TrackingNewDelete.cpp
+TEST(Allocations, tracking)
+{
+    EXPECT_TRUE(isTracking());
+}
+
+TEST(Allocations, scopeCountsAllocations)
+{
+    Scope scope;
+    auto a = std::make_unique<std::uint64_t[]>(100);
+    {
+        auto b = std::make_unique<std::uint64_t[]>(100);
+    }
+    auto c = std::make_unique<char>('c');
+    Stats stats = scope.stop();
+
+    EXPECT_EQ(3u, stats.count);
+    EXPECT_GE(stats.bytes, 1601u);
+    // a and b were alive at the same time
+    EXPECT_GE(stats.peak, 1600u);
+    EXPECT_LT(stats.peak, stats.bytes);
+}
+
+TEST(Allocations, scopesNest)
+{
+    Scope outer;
+    auto a = std::make_unique<std::uint64_t[]>(1000);
+    a.reset();
+
+    Scope inner;
+    auto b = std::make_unique<std::uint64_t[]>(10);
+    Stats innerStats = inner.stop();
+    Stats outerStats = outer.stop();
+
+    EXPECT_EQ(1u, innerStats.count);
+    EXPECT_LT(innerStats.peak, 8000u);
+    EXPECT_EQ(2u, outerStats.count);
+    EXPECT_GE(outerStats.peak, 8000u);
+}
+
+TEST(Allocations, otherThreadsAreNotCounted)
+{
+    Scope scope;
+    std::thread thread([]() {
+        std::vector<int> values(1000);
+    });
+    thread.join();
+    Stats stats = scope.stop();
+    // std::thread allocates its state on this thread, the vector is not
+    EXPECT_LT(stats.bytes, 4000u);
+}
+
+TEST(Allocations, countingResource)
+{
+    CountingResource resource(std::pmr::new_delete_resource());
+    {
+        std::pmr::vector<int> values(&resource);
+        for (int i = 0; i < 100; ++i)
+        {
+            values.push_back(i);
+        }
+        EXPECT_GT(resource.getLiveBytes(), 0u);
+    }
+
+    Stats stats = resource.getStats();
+    EXPECT_GE(stats.count, 2u);
+    EXPECT_GE(stats.peak, 400u);
+    EXPECT_EQ(0u, resource.getLiveBytes());
+}
+
+TEST(Arena, allocatesFromBlocks)
+{
+    CountingResource upstream(std::pmr::new_delete_resource());
+    {
+        Arena arena(1024, &upstream);
+        EXPECT_EQ(0u, upstream.getStats().count);
+
+        std::pmr::list<int> values(&arena);
+        for (int i = 0; i < 1000; ++i)
+        {
+            values.push_back(i);
+        }
+        EXPECT_GE(arena.getAllocatedBytes(), 1000 * sizeof(int));
+        // Growing blocks, not one upstream allocation per node
+        EXPECT_LT(upstream.getStats().count, 10u);
+    }
+    EXPECT_EQ(0u, upstream.getLiveBytes());
+}
+
+TEST(Arena, release)
+{
+    CountingResource upstream(std::pmr::new_delete_resource());
+    Arena arena(256, &upstream);
+    {
+        std::pmr::vector<char> values(4096, 'x', &arena);
+    }
+    EXPECT_GT(upstream.getLiveBytes(), 0u);
+
+    arena.release();
+    EXPECT_EQ(0u, upstream.getLiveBytes());
+    EXPECT_EQ(0u, arena.getAllocatedBytes());
+
+    std::pmr::vector<char> values(16, 'y', &arena);
+    EXPECT_EQ('y', values.back());
+}
+
+TEST(Arena, resourceScopesNest)
+{
+    EXPECT_EQ(std::pmr::get_default_resource(), getResource());
+
+    Arena outer;
+    Arena inner;
+    {
+        ResourceScope outerScope(outer);
+        EXPECT_EQ(&outer, getResource());
+        {
+            ResourceScope innerScope(inner);
+            std::pmr::map<int, int> values(getResource());
+            values[1] = 2;
+            EXPECT_EQ(&inner, values.get_allocator().resource());
+            EXPECT_GT(inner.getAllocatedBytes(), 0u);
+        }
+        EXPECT_EQ(&outer, getResource());
+        EXPECT_EQ(0u, outer.getAllocatedBytes());
+    }
+    EXPECT_EQ(std::pmr::get_default_resource(), getResource());
+}
+
+TEST(Arena, resourceIsPerThread)
+{
+    Arena arena;
+    ResourceScope scope(arena);
+    std::pmr::memory_resource* other = nullptr;
+    std::thread thread([&other]() { other = getResource(); });
+    thread.join();
+    EXPECT_EQ(std::pmr::get_default_resource(), other);
+    EXPECT_EQ(&arena, getResource());
+}
+
+TEST(ScratchArena, keepsItsMemory)
+{
+    CountingResource upstream(std::pmr::new_delete_resource());
+    {
+        ScratchArena arena(1024, &upstream);
+        EXPECT_EQ(1u, upstream.getStats().count);
+        {
+            std::pmr::vector<int> values(10000, 1, &arena);
+        }
+        arena.release();
+        EXPECT_GE(arena.getCapacity(), 10000 * sizeof(int));
+        size_t numOfAllocations = upstream.getStats().count;
+
+        // Uses of the same size are served from the buffer
+        for (int i = 0; i < 3; ++i)
+        {
+            std::pmr::vector<int> values(10000, 2, &arena);
+            EXPECT_EQ(2, values.back());
+            arena.release();
+        }
+        EXPECT_EQ(numOfAllocations, upstream.getStats().count);
+        EXPECT_EQ(0u, arena.getAllocatedBytes());
+    }
+    EXPECT_EQ(0u, upstream.getLiveBytes());
+}
+
+}
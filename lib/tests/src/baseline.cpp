@@ -0,0 +1,246 @@
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Baseline.hpp"
+#include "Json.hpp"
+
+namespace benchmarking {
+
+TEST(Json, parse)
+{
+    Json json = Json::parse(R"( {"name": "BM_a/8", "values": [1, -2.5e3, true, null], "text": "a\"b\\né"} )");
+    EXPECT_EQ("BM_a/8", json.find("name")->asString());
+    const auto& values = json.find("values")->asArray();
+    ASSERT_EQ(4u, values.size());
+    EXPECT_EQ(1, values[0].asNumber());
+    EXPECT_EQ(-2500, values[1].asNumber());
+    EXPECT_TRUE(values[2].asBool());
+    EXPECT_TRUE(values[3].isNull());
+    EXPECT_EQ("a\"b\\n\xc3\xa9", json.find("text")->asString());
+    EXPECT_EQ(nullptr, json.find("missing"));
+
+    EXPECT_THROW(Json::parse("{\"a\": }"), std::runtime_error);
+    EXPECT_THROW(Json::parse("[1, 2"), std::runtime_error);
+    EXPECT_THROW(Json::parse("1 2"), std::runtime_error);
+    EXPECT_THROW(json.find("name")->asNumber(), std::runtime_error);
+}
+
+TEST(Json, writeReadsBack)
+{
+    Json json;
+    json["b"] = 0.1;
+    json["a"] = Json::Array{1, "two\n", false};
+    json["c"] = Json::Object();
+
+    std::ostringstream text;
+    text << json;
+    EXPECT_EQ("{\n  \"a\": [\n    1,\n    \"two\\n\",\n    false\n  ],\n  \"b\": 0.1,\n  \"c\": {}\n}", text.str());
+
+    Json copy = Json::parse(text.str());
+    EXPECT_EQ(0.1, copy.find("b")->asNumber());
+    EXPECT_EQ("two\n", copy.find("a")->asArray()[1].asString());
+}
+
+TEST(Baseline, medianAndMad)
+{
+    Spread spread = getSpread({10, 11, 9, 10, 100});
+    EXPECT_EQ(10, spread.median);
+    EXPECT_EQ(1, spread.mad);
+
+    spread = getSpread({4, 1, 3, 2});
+    EXPECT_EQ(2.5, spread.median);
+    EXPECT_EQ(1, spread.mad);
+    EXPECT_EQ(0, getMedian({}));
+}
+
+namespace {
+
+// The output of google benchmark with two repetitions
+const char* results = R"({
+  "context": {"host_name": "test", "num_cpus": 4},
+  "benchmarks": [
+    {"name": "BM_run/8", "run_name": "BM_run/8", "run_type": "iteration", "repetitions": 2,
+     "repetition_index": 0, "threads": 1, "iterations": 100, "real_time": 1.0, "cpu_time": 0.9,
+     "time_unit": "ms", "allocs_per_iter": 12, "max_bytes_used": 4096, "items_per_second": 1000},
+    {"name": "BM_run/8", "run_name": "BM_run/8", "run_type": "iteration", "repetitions": 2,
+     "repetition_index": 1, "threads": 1, "iterations": 100, "real_time": 1.2, "cpu_time": 1.1,
+     "time_unit": "ms", "allocs_per_iter": 12, "max_bytes_used": 4096, "items_per_second": 900},
+    {"name": "BM_run/8_mean", "run_name": "BM_run/8", "run_type": "aggregate", "aggregate_name": "mean",
+     "real_time": 1.1, "cpu_time": 1.0, "time_unit": "ms"},
+    {"name": "BM_parse", "run_name": "BM_parse", "run_type": "iteration", "iterations": 1000,
+     "real_time": 500, "cpu_time": 500, "time_unit": "ns"}
+  ]
+})";
+
+Baseline createBaseline(double time, double allocations, double mad = 0)
+{
+    Baseline baseline;
+    Entry& entry = baseline.benchmarks["BM_run"];
+    entry.repetitions = 5;
+    entry.realTime = {time, mad};
+    entry.counters["allocs_per_iter"] = {allocations, 0};
+    return baseline;
+}
+
+}
+
+TEST(Baseline, collectRuns)
+{
+    Runs runs;
+    collectRuns(Json::parse(results), runs);
+    ASSERT_EQ(2u, runs.size());
+
+    const Samples& run = runs.at("BM_run/8");
+    EXPECT_EQ((std::vector<double>{1e6, 1.2e6}), run.realTimes);
+    EXPECT_EQ((std::vector<double>{12, 12}), run.counters.at("allocs_per_iter"));
+    EXPECT_EQ(1u, run.counters.count("items_per_second"));
+    EXPECT_EQ(0u, run.counters.count("iterations"));
+    EXPECT_EQ((std::vector<double>{500}), runs.at("BM_parse").realTimes);
+
+    Baseline baseline = summarize(runs);
+    EXPECT_EQ(2u, baseline.benchmarks.at("BM_run/8").repetitions);
+    EXPECT_DOUBLE_EQ(1.1e6, baseline.benchmarks.at("BM_run/8").realTime.median);
+}
+
+TEST(Baseline, jsonRoundTrip)
+{
+    Json output = Json::parse(results);
+    Runs runs;
+    collectRuns(output, runs);
+    Baseline baseline = summarize(runs, *output.find("context"));
+    baseline.benchmarks["BM_parse"].threshold = 0.5;
+
+    Baseline copy = toBaseline(toJson(baseline));
+    EXPECT_EQ("test", copy.context.find("host_name")->asString());
+    ASSERT_EQ(2u, copy.benchmarks.size());
+    const Entry& entry = copy.benchmarks.at("BM_run/8");
+    EXPECT_DOUBLE_EQ(1.1e6, entry.realTime.median);
+    EXPECT_DOUBLE_EQ(1e5, entry.realTime.mad);
+    EXPECT_EQ(12, entry.counters.at("allocs_per_iter").median);
+    EXPECT_FALSE(entry.threshold);
+    EXPECT_EQ(0.5, copy.benchmarks.at("BM_parse").threshold);
+    EXPECT_EQ(1u, entry.rounds);
+
+    Baseline twice = toBaseline(toJson(summarize(std::vector<Runs>{runs, runs})));
+    EXPECT_EQ(2u, twice.benchmarks.at("BM_run/8").rounds);
+    EXPECT_DOUBLE_EQ(1.1e6, twice.benchmarks.at("BM_run/8").runToRun.median);
+
+    Json json = toJson(baseline);
+    json["version"] = 0;
+    EXPECT_THROW(toBaseline(json), std::runtime_error);
+
+    // Recording again keeps the hand tuned threshold
+    Baseline recorded = summarize(runs);
+    keepThresholds(recorded, copy);
+    EXPECT_EQ(0.5, recorded.benchmarks.at("BM_parse").threshold);
+}
+
+TEST(Baseline, compare)
+{
+    GateOptions options;
+    options.threshold = 0.1;
+    options.noise = 3;
+
+    // Within the threshold
+    auto comparisons = compare(createBaseline(100, 10), createBaseline(105, 10), options);
+    ASSERT_EQ(2u, comparisons.size());
+    EXPECT_FALSE(hasRegressions(comparisons));
+
+    // Twice as slow
+    comparisons = compare(createBaseline(100, 10), createBaseline(200, 10), options);
+    EXPECT_EQ(Verdict::regressed, comparisons[0].verdict);
+    EXPECT_EQ(1.0, comparisons[0].getChange());
+    EXPECT_EQ(Verdict::unchanged, comparisons[1].verdict);
+    EXPECT_TRUE(hasRegressions(comparisons));
+
+    // Slower, but no more than the noise of the runs
+    comparisons = compare(createBaseline(100, 10, 10), createBaseline(130, 10, 10), options);
+    EXPECT_EQ(Verdict::unchanged, comparisons[0].verdict);
+
+    // More allocations, faster
+    comparisons = compare(createBaseline(100, 10), createBaseline(50, 20), options);
+    EXPECT_EQ(Verdict::improved, comparisons[0].verdict);
+    EXPECT_EQ("allocs_per_iter", comparisons[1].metric);
+    EXPECT_EQ(Verdict::regressed, comparisons[1].verdict);
+
+    // A threshold per benchmark
+    Baseline tolerant = createBaseline(100, 10);
+    tolerant.benchmarks["BM_run"].threshold = 1.5;
+    EXPECT_FALSE(hasRegressions(compare(tolerant, createBaseline(200, 10), options)));
+
+    Baseline other = createBaseline(100, 10);
+    other.benchmarks["BM_other"] = other.benchmarks["BM_run"];
+    comparisons = compare(other, createBaseline(100, 10), options);
+    EXPECT_EQ(Verdict::missing, comparisons[0].verdict);
+    EXPECT_TRUE(failsGate(comparisons));
+    comparisons = compare(createBaseline(100, 10), other, options);
+    EXPECT_EQ(Verdict::added, comparisons.back().verdict);
+    EXPECT_FALSE(hasRegressions(comparisons));
+    EXPECT_FALSE(failsGate(comparisons));
+}
+
+TEST(Baseline, noiseBetweenRuns)
+{
+    GateOptions options;
+
+    // Steady within the runs, but the runs of the baseline were 10% apart
+    Baseline drifting = createBaseline(100, 10);
+    drifting.benchmarks["BM_run"].runToRun = {110, 10};
+    EXPECT_FALSE(failsGate(compare(drifting, createBaseline(130, 10), options)));
+    EXPECT_TRUE(failsGate(compare(drifting, createBaseline(200, 10), options)));
+    EXPECT_TRUE(failsGate(compare(createBaseline(100, 10), createBaseline(130, 10), options)));
+}
+
+TEST(Baseline, fastestOfRuns)
+{
+    Runs slow;
+    slow["BM_run"].realTimes = {200, 210, 190};
+    slow["BM_slowOnly"].realTimes = {50};
+    Runs fast;
+    fast["BM_run"].realTimes = {100, 105, 95};
+    Runs medium;
+    medium["BM_run"].realTimes = {150};
+
+    Baseline baseline = summarize(std::vector<Runs>{slow, fast, medium});
+    const Entry& entry = baseline.benchmarks.at("BM_run");
+    EXPECT_EQ(100, entry.realTime.median);
+    EXPECT_EQ(5, entry.realTime.mad);
+    EXPECT_EQ(3u, entry.rounds);
+    EXPECT_EQ(150, entry.runToRun.median);
+    EXPECT_EQ(50, entry.runToRun.mad);
+    EXPECT_EQ(1u, baseline.benchmarks.at("BM_slowOnly").rounds);
+
+    // A run again replaces only the benchmarks it made faster
+    Baseline current = summarize(slow);
+    keepFastest(current, summarize(medium));
+    EXPECT_EQ(150, current.benchmarks.at("BM_run").realTime.median);
+    keepFastest(current, summarize(slow));
+    EXPECT_EQ(150, current.benchmarks.at("BM_run").realTime.median);
+    EXPECT_EQ(50, current.benchmarks.at("BM_slowOnly").realTime.median);
+}
+
+TEST(Baseline, machineMismatches)
+{
+    Json recorded = Json::parse(R"({"host_name": "vm", "num_cpus": 1, "mhz_per_cpu": 2000,
+        "cpu_scaling_enabled": false, "library_build_type": "release", "date": "2026-10-17"})");
+    Json context = recorded;
+    context["date"] = "2026-10-18";
+    context["mhz_per_cpu"] = 2100;
+    EXPECT_TRUE(findMachineMismatches(recorded, context).empty());
+    EXPECT_EQ(5u, getMachine(context).asObject().size());
+
+    context["mhz_per_cpu"] = 3000;
+    context["library_build_type"] = "debug";
+    auto mismatches = findMachineMismatches(recorded, context);
+    ASSERT_EQ(2u, mismatches.size());
+    EXPECT_EQ("mhz_per_cpu: 2000 -> 3000", mismatches[0]);
+    EXPECT_EQ("library_build_type: \"release\" -> \"debug\"", mismatches[1]);
+
+    EXPECT_EQ(5u, findMachineMismatches(Json(), context).size());
+}
+
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Fuzzing.hpp"
+
+namespace fuzzing {
+
+namespace {
+
+// Sorts with std::sort as the oracle. The engine under test drops
+// duplicates of values above a threshold, or throws on them.
+struct SortTarget
+{
+    using Case = std::vector<int>;
+
+    int brokenAbove{1000};
+    bool throws{false};
+
+    Case generate(benchmarking::Random& random, size_t size) const
+    {
+        Case values(size);
+        for (auto& value : values)
+        {
+            value = random.between(0, 99);
+        }
+        return values;
+    }
+
+    std::optional<std::string> check(const Case& input) const
+    {
+        Case expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        Case actual = input;
+        std::sort(actual.begin(), actual.end());
+        auto duplicate = std::adjacent_find(actual.begin(), actual.end(),
+            [this](int a, int b) { return a == b && a > brokenAbove; });
+        if (duplicate != actual.end())
+        {
+            if (throws)
+            {
+                throw std::runtime_error("duplicate");
+            }
+            actual.erase(duplicate);
+        }
+        return expectEqual(expected.size(), actual.size());
+    }
+
+    std::vector<Case> shrink(const Case& input) const
+    {
+        auto candidates = removeChunks(input);
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            for (int value : shrinkInteger(input[i], 0))
+            {
+                candidates.push_back(input);
+                candidates.back()[i] = value;
+            }
+        }
+        return candidates;
+    }
+
+    std::string format(const Case& input) const
+    {
+        std::string text;
+        for (int value : input)
+        {
+            text += std::to_string(value);
+            text += '\n';
+        }
+        return text;
+    }
+};
+
+}
+
+TEST(Fuzzing, passes)
+{
+    SortTarget target;
+    auto outcome = fuzz(target, {.seed = 3, .numOfCases = 500});
+    EXPECT_FALSE(outcome.failure);
+    EXPECT_EQ(500u, outcome.numOfCases);
+    EXPECT_GT(outcome.getCasesPerSecond(), 0.0);
+    EXPECT_NE(std::string::npos, describe("sort", target, outcome).find("500 cases"));
+
+    outcome = fuzz(target, {.numOfCases = 1000000, .timeLimit = std::chrono::milliseconds(20)});
+    EXPECT_LT(outcome.numOfCases, 1000000u);
+}
+
+TEST(Fuzzing, shrinksToMinimalCounterexample)
+{
+    SortTarget target{50};
+    auto outcome = fuzz(target, {.seed = 7});
+    ASSERT_TRUE(outcome.failure);
+    const auto& failure = *outcome.failure;
+    EXPECT_EQ("expected 2, got 1", failure.message);
+    // Shrinking one element at a time cannot lower both of the pair
+    ASSERT_EQ(2u, failure.minimal.size());
+    EXPECT_EQ(failure.minimal[0], failure.minimal[1]);
+    EXPECT_GT(failure.minimal[0], 50);
+    EXPECT_GE(failure.original.size(), failure.minimal.size());
+
+    // The seed and size reproduce the original case
+    EXPECT_EQ(failure.original, generateCase(target, failure.seed, failure.size));
+    EXPECT_TRUE(target.check(failure.original));
+
+    // Runs with the same seed find the same case
+    auto again = fuzz(target, {.seed = 7});
+    ASSERT_TRUE(again.failure);
+    EXPECT_EQ(failure.original, again.failure->original);
+    EXPECT_EQ(outcome.numOfCases, again.numOfCases);
+
+    std::string text = describe("sort", target, outcome);
+    EXPECT_NE(std::string::npos, text.find("FAILED"));
+    std::string value = std::to_string(failure.minimal[0]);
+    EXPECT_NE(std::string::npos, text.find(value + '\n' + value + '\n'));
+}
+
+TEST(Fuzzing, exceptionsFail)
+{
+    SortTarget target{50, true};
+    auto outcome = fuzz(target);
+    ASSERT_TRUE(outcome.failure);
+    EXPECT_EQ("threw: duplicate", outcome.failure->message);
+    EXPECT_EQ(2u, outcome.failure->minimal.size());
+}
+
+TEST(Fuzzing, shrinkCandidates)
+{
+    std::string text = "abcd";
+    auto candidates = removeChunks(text);
+    EXPECT_EQ((std::vector<std::string>{"cd", "ab", "bcd", "acd", "abd", "abc"}), candidates);
+    EXPECT_EQ((std::vector<std::string>{"bcd", "acd", "abd", "abc"}), removeChunks(text, 3));
+    EXPECT_TRUE(removeChunks(text, 4).empty());
+    EXPECT_EQ((std::vector<std::string>{""}), removeChunks(std::string("a")));
+
+    EXPECT_EQ((std::vector<int>{0, 5, 9}), shrinkInteger(10, 0));
+    EXPECT_EQ((std::vector<int>{2}), shrinkInteger(3, 2));
+    EXPECT_TRUE(shrinkInteger(2, 2).empty());
+}
+
+}
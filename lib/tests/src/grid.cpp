@@ -0,0 +1,219 @@
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Arena.hpp"
+#include "BreadthFirstSearch.hpp"
+#include "Grid.hpp"
+
+namespace grid {
+
+TEST(Grid, rowMajor)
+{
+    Grid<int> grid(3, 2, 7);
+    EXPECT_EQ(3, grid.getWidth());
+    EXPECT_EQ(2, grid.getHeight());
+    EXPECT_EQ(6u, grid.getCells().size());
+
+    grid(2, 0) = 1;
+    grid(0, 1) = 2;
+    EXPECT_EQ((std::vector<int>{7, 7, 1, 2, 7, 7}), std::vector<int>(grid.getCells().begin(), grid.getCells().end()));
+    EXPECT_EQ(3u, grid.getIndex(0, 1));
+    EXPECT_EQ((Position{2, 1}), grid.getPosition(5));
+    EXPECT_EQ(2, grid.row(1)[0]);
+}
+
+TEST(Grid, padding)
+{
+    Grid<char> grid(2, 2, '.', 1, '#');
+    EXPECT_EQ(4, grid.getStride());
+    EXPECT_EQ(16u, grid.getCells().size());
+    EXPECT_EQ('#', grid(-1, -1));
+    EXPECT_EQ('#', grid(2, 1));
+    EXPECT_EQ('.', grid(1, 1));
+    EXPECT_EQ((Position{-1, 0}), grid.getPosition(grid.getIndex(-1, 0)));
+
+    grid.fill('x');
+    EXPECT_EQ('x', grid(0, 0));
+    EXPECT_EQ('#', grid(0, -1));
+
+    std::span<char> row = grid.row(1);
+    EXPECT_EQ(2u, row.size());
+    EXPECT_EQ(&grid(0, 1), row.data());
+}
+
+TEST(Grid, checkedAccess)
+{
+    Grid<int> grid(2, 3, 0, 1);
+    EXPECT_NO_THROW(grid.at(1, 2));
+    EXPECT_THROW(grid.at(2, 0), std::out_of_range);
+    EXPECT_THROW(grid.at(0, -1), std::out_of_range);
+    EXPECT_TRUE(grid.isInside(Position{1, 2}));
+    EXPECT_FALSE(grid.isInside(Position{-1, 0}));
+    EXPECT_THROW(Grid<int>(-1, 1), std::invalid_argument);
+}
+
+TEST(Grid, neighborOffsets)
+{
+    Grid<int> grid(4, 4, 0, 1);
+    for (int i = 0; i < grid.getWidth() * grid.getHeight(); ++i)
+    {
+        grid(i % 4, i / 4) = i;
+    }
+
+    size_t center = grid.getIndex(1, 2);
+    std::vector<int> neighbors;
+    for (std::ptrdiff_t offset : grid.getNeighborOffsets())
+    {
+        neighbors.push_back(grid[center + offset]);
+    }
+    EXPECT_EQ((std::vector<int>{5, 8, 10, 13}), neighbors);
+
+    neighbors.clear();
+    for (std::ptrdiff_t offset : grid.getAllNeighborOffsets())
+    {
+        neighbors.push_back(grid[center + offset]);
+    }
+    EXPECT_EQ((std::vector<int>{4, 5, 6, 8, 10, 12, 13, 14}), neighbors);
+
+    for (size_t i = 0; i < orthogonalSteps.size(); ++i)
+    {
+        Position p = Position{1, 2} + orthogonalSteps[i];
+        EXPECT_EQ(grid.getIndex(p), center + grid.getNeighborOffsets()[i]);
+    }
+}
+
+TEST(Grid, tiles)
+{
+    Grid<int> grid(5, 3);
+    std::vector<int> covered(15, 0);
+    int numOfTiles = 0;
+    for (Tile tile : grid.getTiles(2, 2))
+    {
+        numOfTiles++;
+        EXPECT_LE(tile.width, 2);
+        EXPECT_LE(tile.height, 2);
+        for (int y = tile.y; y < tile.y + tile.height; ++y)
+        {
+            for (int x = tile.x; x < tile.x + tile.width; ++x)
+            {
+                covered[y * 5 + x]++;
+            }
+        }
+    }
+    EXPECT_EQ(6, numOfTiles);
+    EXPECT_EQ(std::vector<int>(15, 1), covered);
+
+    Tiles tiles(5, 3, 4, 4);
+    auto it = tiles.begin();
+    EXPECT_EQ(4, (*it).width);
+    EXPECT_EQ(3, (*it).height);
+    ++it;
+    EXPECT_EQ(4, (*it).x);
+    EXPECT_EQ(1, (*it).width);
+    EXPECT_TRUE(++it == tiles.end());
+
+    Grid<int> empty;
+    EXPECT_TRUE(empty.getTiles(2, 2).begin() == empty.getTiles(2, 2).end());
+    EXPECT_THROW(Tiles(1, 1, 0, 1), std::invalid_argument);
+}
+
+static Grid<char> readMaze(std::string_view text, int width, int height)
+{
+    Grid<char> maze(width, height, '.', 1, '#');
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            maze(x, y) = text[y * (width + 1) + x];
+        }
+    }
+    return maze;
+}
+
+TEST(Grid, allocatesFromTheCurrentResource)
+{
+    Grid<int> outside(4, 4, 1);
+    Grid<int> padded(4, 4, 1, 1);
+    BreadthFirstSearch outsideSearch(padded);
+    allocations::Arena arena;
+    {
+        allocations::ResourceScope scope(arena);
+        Grid<int> grid(16, 16, 0, 1);
+        EXPECT_GE(arena.getAllocatedBytes(), 18u * 18 * sizeof(int));
+
+        size_t allocated = arena.getAllocatedBytes();
+        Grid<int> copy = outside;
+        EXPECT_GT(arena.getAllocatedBytes(), allocated);
+        EXPECT_EQ(1, copy(3, 3));
+
+        allocated = arena.getAllocatedBytes();
+        BreadthFirstSearch search(grid);
+        EXPECT_GT(arena.getAllocatedBytes(), allocated);
+
+        allocated = arena.getAllocatedBytes();
+        BreadthFirstSearch searchCopy = outsideSearch;
+        EXPECT_GE(arena.getAllocatedBytes(), allocated + 6u * 6 * sizeof(size_t));
+    }
+    EXPECT_EQ(1, outside(0, 0));
+}
+
+TEST(BreadthFirstSearch, distancesAndPaths)
+{
+    Grid<char> maze = readMaze(
+        "...#\n"
+        ".#.#\n"
+        ".#..\n", 4, 3);
+    BreadthFirstSearch search(maze);
+    auto isOpen = [&maze](size_t index) { return maze[index] == '.'; };
+
+    search.run(maze.getIndex(0, 2), isOpen);
+    EXPECT_EQ(0, search.getDistance(maze.getIndex(0, 2)));
+    EXPECT_EQ(2, search.getDistance(maze.getIndex(0, 0)));
+    EXPECT_EQ(7, search.getDistance(maze.getIndex(3, 2)));
+    EXPECT_EQ(-1, search.getDistance(maze.getIndex(1, 1)));
+    EXPECT_FALSE(search.isReached(maze.getIndex(3, 0)));
+    EXPECT_EQ(BreadthFirstSearch::none, search.getParent(maze.getIndex(0, 2)));
+    EXPECT_EQ(maze.getIndex(0, 1), search.getFirstStep(maze.getIndex(3, 2)));
+    EXPECT_EQ(8u, search.getReached().size());
+
+    std::vector<Position> path;
+    for (size_t index : search.getPath(maze.getIndex(2, 1)))
+    {
+        path.push_back(maze.getPosition(index));
+    }
+    EXPECT_EQ((std::vector<Position>{{0, 2}, {0, 1}, {0, 0}, {1, 0}, {2, 0}, {2, 1}}), path);
+
+    // A new search forgets the previous one
+    search.run(maze.getIndex(3, 2), [&maze](size_t index) { return maze[index] == '.' && maze.getPosition(index).x > 1; });
+    EXPECT_EQ(3, search.getDistance(maze.getIndex(2, 0)));
+    EXPECT_FALSE(search.isReached(maze.getIndex(0, 2)));
+}
+
+TEST(BreadthFirstSearch, readingOrderTieBreaking)
+{
+    Grid<char> open(5, 5, '.', 1, '#');
+    BreadthFirstSearch search(open);
+    auto isOpen = [&open](size_t index) { return open[index] == '.'; };
+
+    // Up and right both lead to (3, 2) equally fast, up comes first
+    search.run(open.getIndex(2, 3), isOpen);
+    EXPECT_EQ(open.getIndex(2, 2), search.getFirstStep(open.getIndex(3, 2)));
+    // Left comes before down and up before right
+    search.run(open.getIndex(2, 2), isOpen);
+    EXPECT_EQ(open.getIndex(1, 2), search.getFirstStep(open.getIndex(1, 4)));
+    EXPECT_EQ(open.getIndex(2, 1), search.getFirstStep(open.getIndex(4, 1)));
+
+    // Equally far sources, the first in reading order wins
+    std::vector<size_t> sources{open.getIndex(2, 0), open.getIndex(0, 2), open.getIndex(4, 2)};
+    search.run(sources, isOpen);
+    EXPECT_EQ(open.getIndex(2, 0), search.getSource(open.getIndex(2, 2)));
+    EXPECT_EQ(open.getIndex(2, 0), search.getSource(open.getIndex(1, 1)));
+    EXPECT_EQ(open.getIndex(0, 2), search.getSource(open.getIndex(1, 3)));
+    EXPECT_EQ(open.getIndex(4, 2), search.getSource(open.getIndex(4, 4)));
+    EXPECT_EQ(2, search.getDistance(open.getIndex(2, 2)));
+}
+
+}
@@ -0,0 +1,125 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "MappedInput.hpp"
+
+namespace puzzleInputs {
+
+static std::vector<std::string_view> split(std::string_view text)
+{
+    Lines lines(text);
+    return std::vector<std::string_view>(lines.begin(), lines.end());
+}
+
+class MappedInputTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        filepath = std::filesystem::temp_directory_path() /
+            ("mappedInput_" + std::to_string(::getpid()) + ".txt");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(filepath);
+    }
+
+    void write(const std::string& content)
+    {
+        std::ofstream output(filepath, std::ios::binary);
+        output << content;
+    }
+
+    std::filesystem::path filepath;
+};
+
+TEST(Lines, behavesLikeGetline)
+{
+    EXPECT_TRUE(split("").empty());
+    EXPECT_EQ(std::vector<std::string_view>({"a"}), split("a"));
+    EXPECT_EQ(std::vector<std::string_view>({"a"}), split("a\n"));
+    EXPECT_EQ(std::vector<std::string_view>({"a", "", "b"}), split("a\n\nb"));
+    EXPECT_EQ(std::vector<std::string_view>({"", ""}), split("\n\n"));
+}
+
+TEST(Lines, windowsLineEndings)
+{
+    EXPECT_EQ(std::vector<std::string_view>({"a", "", "b"}), split("a\r\n\r\nb\r\n"));
+    EXPECT_EQ(std::vector<std::string_view>({"a", "b"}), split("a\r\nb\r"));
+    EXPECT_EQ(std::vector<std::string_view>({"a\rb"}), split("a\rb\n"));
+}
+
+TEST(Lines, countLines)
+{
+    static_assert(countLines("") == 0);
+    static_assert(countLines("a\n") == 1);
+    static_assert(countLines("a\n\nb") == 3);
+}
+
+TEST(Lines, viewsPointIntoText)
+{
+    std::string_view text = "first\nsecond";
+    auto lines = split(text);
+    ASSERT_EQ(2, lines.size());
+    EXPECT_EQ(text.data(), lines[0].data());
+    EXPECT_EQ(text.data() + 6, lines[1].data());
+}
+
+TEST_F(MappedInputTest, view)
+{
+    write("1 2 3\n4 5 6\n");
+    MappedInput input(filepath);
+    EXPECT_EQ("1 2 3\n4 5 6\n", input.view());
+
+    auto lines = input.lines();
+    EXPECT_EQ(2, std::distance(lines.begin(), lines.end()));
+}
+
+TEST_F(MappedInputTest, windowsLineEndings)
+{
+    write("1 2 3\r\n4 5 6\r\n");
+    MappedInput input(filepath);
+    auto lines = input.lines();
+    EXPECT_EQ(std::vector<std::string_view>({"1 2 3", "4 5 6"}), std::vector<std::string_view>(lines.begin(), lines.end()));
+}
+
+TEST_F(MappedInputTest, emptyFile)
+{
+    write("");
+    MappedInput input(filepath);
+    EXPECT_TRUE(input.view().empty());
+    EXPECT_EQ(input.lines().begin(), input.lines().end());
+}
+
+TEST_F(MappedInputTest, move)
+{
+    write("abc");
+    MappedInput input(filepath);
+    MappedInput moved(std::move(input));
+    EXPECT_TRUE(input.view().empty());
+    EXPECT_EQ("abc", moved.view());
+}
+
+TEST(MappedInput, missingFile)
+{
+    EXPECT_THROW(MappedInput("/nonexistent/input.txt"), std::system_error);
+}
+
+
+TEST_F(MappedInputTest, embedded)
+{
+    write("file");
+    embed(filepath.parent_path() / "." / filepath.filename(), "embedded");
+    EXPECT_EQ("embedded", MappedInput(filepath).view());
+    getEmbeddedInputs().clear();
+    EXPECT_EQ("file", MappedInput(filepath).view());
+}
+
+}
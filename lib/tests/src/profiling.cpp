@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Histogram.hpp"
+#include "Zones.hpp"
+
+namespace profiling {
+
+TEST(Profiling, zonesAccumulate)
+{
+    ZoneStats& stats = Registry::get().add("test::zonesAccumulate");
+    EXPECT_EQ(&stats, &Registry::get().add("test::zonesAccumulate"));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ScopedZone zone(stats);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(3u, stats.calls.load());
+    EXPECT_GE(stats.nanoseconds.load(), 3000000u);
+}
+
+TEST(Profiling, report)
+{
+    ZoneStats& stats = Registry::get().add("test::report");
+    {
+        ScopedZone zone(stats);
+    }
+
+    std::ostringstream out;
+    report(out);
+    EXPECT_NE(std::string::npos, out.str().find("test::report"));
+    EXPECT_NE(std::string::npos, out.str().find("cache-misses"));
+}
+
+TEST(Histogram, buckets)
+{
+    Histogram histogram(2);
+    // Linear below 4, then 4 buckets per power of two
+    EXPECT_EQ(3u, histogram.getIndex(3));
+    EXPECT_EQ(4u, histogram.getIndex(4));
+    EXPECT_EQ(7u, histogram.getIndex(7));
+    EXPECT_EQ(8u, histogram.getIndex(8));
+    EXPECT_EQ(8u, histogram.getIndex(9));
+    EXPECT_EQ(9u, histogram.getIndex(10));
+    EXPECT_EQ(9u, histogram.getUpperBound(8));
+    EXPECT_EQ(11u, histogram.getUpperBound(9));
+
+    Histogram precise;
+    for (std::uint64_t value : {std::uint64_t(1000), std::uint64_t(123456789), UINT64_MAX})
+    {
+        std::uint64_t bound = precise.getUpperBound(precise.getIndex(value));
+        EXPECT_GE(bound, value);
+        EXPECT_LE(bound - value, value / 128);
+    }
+}
+
+TEST(Histogram, percentiles)
+{
+    Histogram histogram;
+    EXPECT_EQ(0u, histogram.getPercentile(50));
+
+    for (std::uint64_t value = 1; value <= 1000; ++value)
+    {
+        histogram.record(value * 1000);
+    }
+    EXPECT_EQ(1000u, histogram.getCount());
+    EXPECT_EQ(1000u, histogram.getMin());
+    EXPECT_EQ(1000000u, histogram.getMax());
+    EXPECT_DOUBLE_EQ(500500.0, histogram.getMean());
+
+    // Within the 1% of a bucket above the exact value
+    EXPECT_GE(histogram.getPercentile(50), 500000u);
+    EXPECT_LE(histogram.getPercentile(50), 505000u);
+    EXPECT_GE(histogram.getPercentile(99), 990000u);
+    EXPECT_LE(histogram.getPercentile(99), 1000000u);
+    EXPECT_EQ(1000000u, histogram.getPercentile(100));
+    EXPECT_EQ(1000u, histogram.getPercentile(0));
+}
+
+TEST(Histogram, tail)
+{
+    Histogram histogram;
+    for (int i = 0; i < 99; ++i)
+    {
+        histogram.record(std::chrono::microseconds(10));
+    }
+    histogram.record(std::chrono::milliseconds(50));
+
+    // The upper bound of the bucket of 10 us
+    EXPECT_EQ(10047u, histogram.getPercentile(50));
+    EXPECT_EQ(10047u, histogram.getPercentile(99));
+    EXPECT_EQ(std::chrono::milliseconds(50), histogram.getPercentileDuration(99.9));
+}
+
+TEST(Histogram, merge)
+{
+    Histogram first;
+    Histogram second;
+    first.record(5);
+    second.record(1000000);
+    second.record(7);
+    first.merge(second);
+    EXPECT_EQ(3u, first.getCount());
+    EXPECT_EQ(5u, first.getMin());
+    EXPECT_EQ(1000000u, first.getMax());
+    EXPECT_EQ(7u, first.getPercentile(50));
+}
+
+}
@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Random.hpp"
+
+namespace benchmarking {
+
+TEST(Random, sameSeedSameSequence)
+{
+    Random a(42);
+    Random b(42);
+    Random c(43);
+    for (int i = 0; i < 100; ++i)
+    {
+        std::uint64_t value = a.next();
+        EXPECT_EQ(value, b.next());
+        EXPECT_NE(value, c.next());
+    }
+}
+
+TEST(Random, knownSequence)
+{
+    // First values of the SplitMix64 reference implementation for seed 0,
+    // the generated inputs must not change between compilers
+    Random random(0);
+    EXPECT_EQ(0xE220A8397B1DCDAFull, random.next());
+    EXPECT_EQ(0x6E789E6AA1B965F4ull, random.next());
+}
+
+TEST(Random, betweenStaysInRange)
+{
+    Random random(1);
+    for (int i = 0; i < 1000; ++i)
+    {
+        int value = random.between(-3, 3);
+        EXPECT_GE(value, -3);
+        EXPECT_LE(value, 3);
+    }
+    EXPECT_EQ(7, random.between(7, 7));
+}
+
+TEST(Random, shuffleIsPermutation)
+{
+    Random random(1);
+    std::vector<int> values(50);
+    std::iota(values.begin(), values.end(), 0);
+    random.shuffle(values.begin(), values.end());
+
+    std::vector<int> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < 50; ++i)
+    {
+        EXPECT_EQ(i, sorted[i]);
+    }
+}
+
+}
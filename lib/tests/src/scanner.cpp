@@ -0,0 +1,111 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "Scanner.hpp"
+
+namespace scanner {
+
+TEST(Scanner, integers)
+{
+    Scanner s("12 -34 +56 7");
+    EXPECT_EQ(12, s.integer<int>());
+    EXPECT_EQ(-34, s.integer<int>());
+    EXPECT_EQ(56, s.integer<int>());
+    EXPECT_EQ(7, s.integer<int>());
+    EXPECT_FALSE(s.hasMore());
+}
+
+TEST(Scanner, allDigitRunLengths)
+{
+    // Exercises both the 8 byte fast path and the tail near the end of input
+    std::string digits;
+    for (int length = 1; length <= 18; ++length)
+    {
+        digits += std::to_string(length % 10);
+        std::string text = digits + " " + digits + std::string(10, ' ');
+        Scanner s(text);
+        EXPECT_EQ(std::stoll(digits), s.integer<long long>());
+        EXPECT_EQ(-std::stoll(digits), toInteger<long long>("-" + digits));
+        EXPECT_EQ(std::stoll(digits), s.integer<long long>());
+    }
+}
+
+TEST(Scanner, leadingZeros)
+{
+    EXPECT_EQ(7, toInteger<int>("0007"));
+    EXPECT_EQ(7, toInteger<int>("00000007         "));
+}
+
+TEST(Scanner, outOfRange)
+{
+    EXPECT_THROW(toInteger<std::uint8_t>("256        "), std::runtime_error);
+    EXPECT_THROW(toInteger<std::int8_t>("-129"), std::runtime_error);
+    EXPECT_EQ(-128, toInteger<std::int8_t>("-128       "));
+    EXPECT_THROW(toInteger<int>("99999999999"), std::runtime_error);
+}
+
+TEST(Scanner, failedIntegerDoesNotConsume)
+{
+    Scanner s("  -x");
+    EXPECT_FALSE(s.tryInteger<int>().has_value());
+    EXPECT_EQ('-', s.tryChar());
+
+    Scanner u("-5");
+    EXPECT_FALSE(u.tryInteger<unsigned>().has_value());
+    EXPECT_EQ(-5, u.integer<int>());
+}
+
+TEST(Scanner, delimitersAndLiterals)
+{
+    Scanner s("position=< 3, -4> x");
+    s.expect("position=<");
+    EXPECT_EQ(3, s.integer<int>());
+    s.expect(',');
+    EXPECT_EQ(-4, s.integer<int>());
+    s.expect('>');
+    EXPECT_FALSE(s.skip('y'));
+    EXPECT_THROW(s.expect("z"), std::runtime_error);
+    EXPECT_EQ("x", s.word());
+    EXPECT_EQ("", s.word());
+}
+
+TEST(Scanner, until)
+{
+    Scanner s("a, b;c");
+    EXPECT_EQ("a, b", s.until(';'));
+    EXPECT_EQ("c", s.until(';'));
+    EXPECT_TRUE(s.atEnd());
+    EXPECT_EQ("", s.until(';'));
+}
+
+TEST(Scanner, trailingCharacters)
+{
+    EXPECT_EQ(1, toInteger<int>(" 1 "));
+    EXPECT_THROW(toInteger<int>("1a"), std::runtime_error);
+}
+
+
+TEST(Scanner, constantExpressions)
+{
+    constexpr auto parsePair = [](std::string_view text) {
+        Scanner s(text);
+        s.expect('<');
+        int x = s.integer<int>();
+        s.expect(',');
+        int y = s.integer<int>();
+        s.expect('>');
+        return std::pair(x, y);
+    };
+    static_assert(parsePair("< -12, 345678901 >") == std::pair(-12, 345678901));
+    static_assert(toInteger<std::int8_t>("-128") == -128);
+    static_assert(toInteger<std::uint64_t>("18446744073709551615") == 18446744073709551615ull);
+    static_assert(!Scanner("-1").tryInteger<unsigned>());
+    EXPECT_EQ(parsePair("<1,2>"), std::pair(1, 2));
+}
+
+}
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ByteSearch.hpp"
+#include "PrefixSums.hpp"
+#include "Random.hpp"
+
+namespace simd {
+
+namespace {
+
+// Every length up to a few blocks, to cover the scalar tails
+std::vector<std::vector<int>> getCases()
+{
+    benchmarking::Random random(5);
+    std::vector<std::vector<int>> cases;
+    for (int size = 0; size < 40; ++size)
+    {
+        std::vector<int> values(size);
+        for (auto& value : values)
+        {
+            value = random.between(-1000, 1000);
+        }
+        cases.push_back(values);
+    }
+    // Sums far outside of int
+    cases.push_back(std::vector<int>(37, INT_MAX));
+    cases.push_back(std::vector<int>(41, INT_MIN));
+    return cases;
+}
+
+}
+
+TEST(Simd, sum)
+{
+    for (const auto& values : getCases())
+    {
+        long expected = detail::sumScalar(values.data(), values.size());
+        EXPECT_EQ(expected, sum(values));
+#if AOC_SIMD_X86
+        if (isAvx2Supported())
+        {
+            EXPECT_EQ(expected, detail::sumAvx2(values.data(), values.size()));
+        }
+#endif
+    }
+    EXPECT_EQ(37L * INT_MAX, sum(std::vector<int>(37, INT_MAX)));
+}
+
+TEST(Simd, prefixSums)
+{
+    EXPECT_EQ(6, prefixSums(std::vector<int>{1, 2, 3}, 0, std::vector<long>(3).data()));
+
+    for (const auto& values : getCases())
+    {
+        std::vector<long> expected(values.size());
+        long expectedTotal = detail::prefixSumsScalar(values.data(), values.size(), -7, expected.data());
+
+        std::vector<long> sums(values.size());
+        EXPECT_EQ(expectedTotal, prefixSums(values, -7, sums.data()));
+        EXPECT_EQ(expected, sums);
+#if AOC_SIMD_X86
+        if (isAvx2Supported())
+        {
+            std::fill(sums.begin(), sums.end(), 0);
+            EXPECT_EQ(expectedTotal, detail::prefixSumsAvx2(values.data(), values.size(), -7, sums.data()));
+            EXPECT_EQ(expected, sums);
+        }
+#endif
+    }
+}
+
+TEST(Simd, disabled)
+{
+    std::vector<int> values = {5, -2, 8, 1, 1, 1, 1, 1, 1};
+    std::vector<long> sums(values.size());
+    setEnabled(false);
+    EXPECT_FALSE(useAvx2());
+    EXPECT_EQ(17, sum(values));
+    EXPECT_EQ(17, prefixSums(values, 0, sums.data()));
+    setEnabled(true);
+    EXPECT_EQ(isAvx2Supported(), useAvx2());
+    EXPECT_EQ((std::vector<long>{0, 5, 3, 11, 12, 13, 14, 15, 16}), sums);
+}
+
+TEST(Simd, findByte)
+{
+    std::array<std::uint8_t, byteBlockSize> block{};
+    block[0] = 2;
+    block[7] = 3;
+    block[25] = 2;
+    block[31] = 255;
+    for (auto [value, expected] : {std::pair<int, std::uint32_t>{2, 0x02000001u}, {3, 0x80u}, {255, 0x80000000u}, {1, 0}})
+    {
+        EXPECT_EQ(expected, findByte(block.data(), value));
+        EXPECT_EQ(expected, detail::findByteScalar(block.data(), value));
+#if AOC_SIMD_X86
+        if (isAvx2Supported())
+        {
+            EXPECT_EQ(expected, detail::findByteAvx2(block.data(), value));
+        }
+#endif
+    }
+    EXPECT_EQ(0x7DFFFF7Eu, findByte(block.data(), 0));
+}
+
+TEST(Simd, countBlocksWithByte)
+{
+    std::vector<std::uint8_t> blocks(5 * byteBlockSize);
+    blocks[0] = 2;
+    blocks[byteBlockSize + 31] = 2;
+    blocks[2 * byteBlockSize + 4] = 3;
+    blocks[4 * byteBlockSize + 9] = 2;
+    blocks[4 * byteBlockSize + 10] = 2;
+    for (auto [numOfBlocks, value, expected] : {std::tuple<size_t, int, size_t>{5, 2, 3}, {5, 3, 1}, {2, 2, 2}, {2, 3, 0}, {0, 2, 0}, {5, 0, 5}})
+    {
+        EXPECT_EQ(expected, countBlocksWithByte(blocks.data(), numOfBlocks, value));
+        EXPECT_EQ(expected, detail::countBlocksWithByteScalar(blocks.data(), numOfBlocks, value));
+#if AOC_SIMD_X86
+        if (isAvx2Supported())
+        {
+            EXPECT_EQ(expected, detail::countBlocksWithByteAvx2(blocks.data(), numOfBlocks, value));
+        }
+#endif
+    }
+}
+
+}
@@ -0,0 +1,504 @@
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "Arena.hpp"
+#include "BatchRunner.hpp"
+#include "ConcurrentRunner.hpp"
+#include "Latencies.hpp"
+#include "Registry.hpp"
+#include "Report.hpp"
+#include "ResultCache.hpp"
+#include "Runner.hpp"
+#include "Scanner.hpp"
+#include "StreamInput.hpp"
+
+namespace solvers {
+
+namespace {
+
+Registry createRegistry()
+{
+    Registry registry;
+    registry.add(2000, 1, "numbers.txt",
+        [](std::string_view text) {
+            std::vector<int> numbers;
+            scanner::Scanner s(text);
+            while (s.hasMore())
+            {
+                numbers.push_back(s.integer<int>());
+            }
+            return numbers;
+        },
+        [](const std::vector<int>& numbers) { return numbers.size(); },
+        [](const std::vector<int>& numbers) { return std::to_string(numbers.front()) + "!"; });
+    registry.add(2000, 2, "other.txt",
+        [](std::string_view text) { return text; },
+        [](std::string_view) { return 1; },
+        [](std::string_view) -> int { throw std::runtime_error("no answer"); });
+    registry.add(2001, 1, "next.txt",
+        [](std::string_view text) { return text.size(); },
+        [](size_t size) { return size; },
+        [](size_t size) { return size * 2; });
+    return registry;
+}
+
+}
+
+TEST(Registry, select)
+{
+    Registry registry = createRegistry();
+    EXPECT_EQ(3u, registry.select().size());
+    EXPECT_EQ(2u, registry.select(2000).size());
+    ASSERT_EQ(1u, registry.select(2000, 2).size());
+    EXPECT_EQ("2000/day02", registry.select(2000, 2).front()->getName());
+    EXPECT_EQ(2u, registry.select(std::nullopt, 1).size());
+    EXPECT_TRUE(registry.select(1999).empty());
+}
+
+TEST(Registry, run)
+{
+    Registry registry = createRegistry();
+    Result result = run(*registry.select(2000, 1).front(), std::string_view("3 1 4 1 5\n"));
+    EXPECT_TRUE(result.error.empty());
+    EXPECT_EQ("5", result.answers[0]);
+    EXPECT_EQ("3!", result.answers[1]);
+}
+
+TEST(Registry, runAllocatesFromArenas)
+{
+    Registry registry;
+    registry.add(2000, 1, "letters.txt",
+        [](std::string_view text) {
+            std::pmr::string letters(text, allocations::getResource());
+            EXPECT_NE(std::pmr::get_default_resource(), letters.get_allocator().resource());
+            return letters;
+        },
+        [](const std::pmr::string& letters) {
+            // The part gets an arena of its own, the parsed input stays valid
+            EXPECT_NE(letters.get_allocator().resource(), allocations::getResource());
+            return letters.size();
+        },
+        [](const std::pmr::string& letters) { return letters; });
+    Result result = run(*registry.select(2000, 1).front(), std::string_view("abcdefghijklmnopqrstuvwxyz"));
+    EXPECT_TRUE(result.error.empty());
+    EXPECT_EQ("26", result.answers[0]);
+    EXPECT_EQ("abcdefghijklmnopqrstuvwxyz", result.answers[1]);
+    EXPECT_EQ(std::pmr::get_default_resource(), allocations::getResource());
+}
+
+TEST(Registry, runStream)
+{
+    Registry registry = createRegistry();
+    registry.addStream(2001, 1, [](puzzleInputs::ChunkReader& input) {
+        size_t size = puzzleInputs::readAll(input).size();
+        return std::make_pair(size, size * 2);
+    });
+
+    puzzleInputs::ChunkReader streamed("abcde", 2);
+    Result result = run(*registry.select(2001, 1).front(), streamed);
+    EXPECT_TRUE(result.streamed);
+    EXPECT_EQ("-", result.input.string());
+    EXPECT_EQ("5", result.answers[0]);
+    EXPECT_EQ("10", result.answers[1]);
+
+    puzzleInputs::ChunkReader whole("3 1 4\n", 2);
+    result = run(*registry.select(2000, 1).front(), whole);
+    EXPECT_FALSE(result.streamed);
+    EXPECT_EQ("3", result.answers[0]);
+    EXPECT_EQ("3!", result.answers[1]);
+
+    EXPECT_THROW(registry.addStream(1999, 1, [](puzzleInputs::ChunkReader&) { return std::make_pair(0, 0); }),
+        std::invalid_argument);
+}
+
+TEST(Registry, errorsAreReported)
+{
+    Registry registry = createRegistry();
+    Result result = run(*registry.select(2000, 2).front(), std::string_view("text"));
+    EXPECT_EQ("no answer", result.error);
+
+    result = run(*registry.select(2000, 1).front(), std::filesystem::path("/nonexistent/input.txt"));
+    EXPECT_FALSE(result.error.empty());
+}
+
+TEST(Registry, runBuild)
+{
+    Registry registry;
+    int builds = 0;
+    registry.add(2000, 1, "numbers.txt",
+        [](std::string_view text) { return std::string(text); },
+        [&builds](const std::string& text) {
+            // The built value may refer to the parsed one
+            ++builds;
+            return std::string_view(text).substr(1);
+        },
+        [](std::string_view rest) { return rest.size(); },
+        [](std::string_view rest) { return rest; });
+    const Solver& solver = *registry.select(2000, 1).front();
+    EXPECT_TRUE(solver.hasBuild());
+    EXPECT_FALSE(createRegistry().select(2000, 1).front()->hasBuild());
+
+    Result result = run(solver, std::string_view("abcd"));
+    EXPECT_TRUE(result.error.empty());
+    EXPECT_EQ(1, builds);
+    EXPECT_EQ("3", result.answers[0]);
+    EXPECT_EQ("bcd", result.answers[1]);
+
+    std::vector<Result> results = runConcurrently({{&solver, "/nonexistent"}}, parallel::getSharedPool());
+    EXPECT_FALSE(results[0].error.empty());
+
+    std::ostringstream text;
+    printText(text, {result});
+    EXPECT_NE(std::string::npos, text.str().find("  build "));
+    std::ostringstream json;
+    printJson(json, {result});
+    EXPECT_NE(std::string::npos, json.str().find("\"build_ns\": "));
+}
+
+TEST(Latencies, measure)
+{
+    Registry registry = createRegistry();
+    Latencies latencies = measureLatencies(*registry.select(2000, 1).front(), std::string_view("3 1 4\n"), 20);
+    EXPECT_TRUE(latencies.error.empty());
+    EXPECT_EQ("3", latencies.answers[0]);
+    for (const auto& histogram : latencies.phases)
+    {
+        EXPECT_EQ(20u, histogram.getCount());
+    }
+    EXPECT_LE(latencies.get(Phase::part1).getPercentile(50), latencies.get(Phase::part1).getPercentile(99));
+    EXPECT_LE(latencies.get(Phase::parse).getMax(), latencies.get(Phase::total).getMax());
+
+    std::ostringstream text;
+    printLatencies(text, {latencies});
+    EXPECT_NE(std::string::npos, text.str().find("20 runs"));
+    EXPECT_NE(std::string::npos, text.str().find("  part2 "));
+    EXPECT_EQ(std::string::npos, text.str().find("  build "));
+
+    std::ostringstream json;
+    printJsonLatencies(json, {latencies});
+    EXPECT_NE(std::string::npos, json.str().find("\"runs\": 20"));
+    EXPECT_NE(std::string::npos, json.str().find("\"total\": {\"min_ns\": "));
+}
+
+TEST(Latencies, stopsAtErrors)
+{
+    Registry registry = createRegistry();
+    Latencies latencies = measureLatencies(*registry.select(2000, 2).front(), std::string_view("text"), 5);
+    EXPECT_EQ("no answer", latencies.error);
+    EXPECT_EQ(0u, latencies.get(Phase::total).getCount());
+
+    int calls = 0;
+    registry.add(2002, 1, "changing.txt",
+        [](std::string_view text) { return text; },
+        [](std::string_view) { return 1; },
+        [&calls](std::string_view) { return ++calls; });
+    latencies = measureLatencies(*registry.select(2002, 1).front(), std::string_view("text"), 5);
+    EXPECT_EQ("Answers differ between repetitions", latencies.error);
+    EXPECT_EQ(1u, latencies.get(Phase::total).getCount());
+
+    latencies = measureLatencies(*registry.select(2000, 1).front(), std::filesystem::path("/nonexistent/input.txt"), 5);
+    EXPECT_FALSE(latencies.error.empty());
+    EXPECT_EQ("/nonexistent/input.txt", latencies.input.string());
+}
+
+TEST(Report, json)
+{
+    Registry registry = createRegistry();
+    Result result = run(*registry.select(2001, 1).front(), std::string_view("a\"b\n"));
+    result.parseTime = std::chrono::nanoseconds(1);
+    result.solveTimes = {std::chrono::nanoseconds(2), std::chrono::nanoseconds(3)};
+    // The library tests track allocations
+    result.parseAllocations = {1, 16, 16};
+    result.solveAllocations = {allocations::Stats{0, 0, 0}, allocations::Stats{2, 64, 32}};
+
+    std::ostringstream out;
+    printJson(out, {result});
+    EXPECT_EQ("[\n"
+        "  {\"year\": 2001, \"day\": 1, \"input\": \"\", \"cached\": false, \"streamed\": false, \"parse_ns\": 1, "
+        "\"parse_allocations\": {\"count\": 1, \"bytes\": 16, \"peak\": 16}, \"parts\": ["
+        "{\"part\": 1, \"answer\": \"4\", \"solve_ns\": 2, "
+        "\"allocations\": {\"count\": 0, \"bytes\": 0, \"peak\": 0}}, "
+        "{\"part\": 2, \"answer\": \"8\", \"solve_ns\": 3, "
+        "\"allocations\": {\"count\": 2, \"bytes\": 64, \"peak\": 32}}]}\n"
+        "]\n", out.str());
+    EXPECT_EQ("a\\\"b\\n\\u0001", escapeJson("a\"b\n\x01"));
+}
+
+TEST(ConcurrentRunner, sameResultsAsSequential)
+{
+    Registry registry = createRegistry();
+    auto filepath = std::filesystem::temp_directory_path() /
+        ("concurrentRunner_" + std::to_string(::getpid()) + ".txt");
+    {
+        std::ofstream output(filepath, std::ios::binary);
+        output << "2 7 1 8\n";
+    }
+
+    std::vector<Job> jobs;
+    for (const auto* solver : registry.select())
+    {
+        jobs.push_back({solver, filepath});
+    }
+
+    parallel::ThreadPool pool(3);
+    Summary summary;
+    std::vector<Result> results = runConcurrently(jobs, pool, &summary);
+    std::filesystem::remove(filepath);
+
+    ASSERT_EQ(jobs.size(), results.size());
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        Result expected = run(*jobs[i].solver, std::string_view("2 7 1 8\n"));
+        EXPECT_EQ(jobs[i].solver, results[i].solver);
+        EXPECT_EQ(expected.error, results[i].error);
+        if (expected.error.empty())
+        {
+            EXPECT_EQ(expected.answers, results[i].answers);
+        }
+    }
+
+    EXPECT_EQ(3u, summary.numOfThreads);
+    ASSERT_NE(nullptr, summary.criticalPath.result);
+    EXPECT_LE(summary.criticalPath.length, summary.work);
+}
+
+class BatchRunnerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory = std::filesystem::temp_directory_path() / ("batchRunner_" + std::to_string(::getpid()));
+        std::filesystem::create_directories(directory);
+        for (int i = 0; i < 20; ++i)
+        {
+            std::ofstream output(directory / ("input" + std::to_string(100 + i) + ".txt"), std::ios::binary);
+            output << i;
+            for (int j = 0; j < i * 50; ++j)
+            {
+                output << " 1";
+            }
+            output << '\n';
+        }
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::filesystem::path directory;
+};
+
+TEST_F(BatchRunnerTest, findInputs)
+{
+    auto inputs = findBatchInputs(directory);
+    ASSERT_EQ(20u, inputs.size());
+    EXPECT_EQ(directory / "input100.txt", inputs.front());
+    EXPECT_EQ(directory / "input119.txt", inputs.back());
+
+    auto manifest = directory / "manifest";
+    {
+        std::ofstream output(manifest);
+        output << "# inputs\ninput101.txt\n\n" << (directory / "input100.txt").string() << "\r\n";
+    }
+    EXPECT_EQ((std::vector<std::filesystem::path>{directory / "input101.txt", directory / "input100.txt"}),
+        findBatchInputs(manifest));
+    EXPECT_THROW(findBatchInputs(directory / "missing"), std::system_error);
+}
+
+TEST_F(BatchRunnerTest, sameResultsAsSingleRuns)
+{
+    Registry registry = createRegistry();
+    const Solver& solver = *registry.select(2000, 1).front();
+    auto inputs = findBatchInputs(directory);
+    inputs.push_back(directory / "missing.txt");
+
+    parallel::ThreadPool pool(3);
+    std::vector<Result> results(inputs.size());
+    std::vector<int> calls(inputs.size());
+    BatchSummary summary = runBatch(solver, inputs, &pool, [&](size_t index, const Result& result) {
+        calls[index]++;
+        results[index] = result;
+    });
+
+    EXPECT_EQ(3u, summary.numOfThreads);
+    EXPECT_EQ(21u, summary.numOfInputs);
+    EXPECT_EQ(1u, summary.numOfFailures);
+    EXPECT_EQ(std::vector<int>(inputs.size(), 1), calls);
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        Result expected = run(solver, inputs[i]);
+        EXPECT_EQ(inputs[i], results[i].input);
+        EXPECT_EQ(expected.error.empty(), results[i].error.empty());
+        EXPECT_EQ(expected.answers, results[i].answers);
+    }
+
+    // Without a pool everything runs on the calling thread
+    size_t numOfResults = 0;
+    summary = runBatch(solver, inputs, nullptr, [&](size_t, const Result&) { numOfResults++; });
+    EXPECT_EQ(1u, summary.numOfThreads);
+    EXPECT_EQ(inputs.size(), numOfResults);
+}
+
+TEST_F(BatchRunnerTest, reusesScratchMemory)
+{
+    Registry registry;
+    registry.add(2000, 1, "letters.txt",
+        [](std::string_view text) { return std::pmr::string(text, allocations::getResource()); },
+        [](const std::pmr::string& text) { return std::pmr::string(text, allocations::getResource()).size(); },
+        [](const std::pmr::string& text) { return text.substr(0, 1); });
+
+    // Every input is as large as the first one, only the first grows the
+    // arenas beyond their initial size
+    auto large = directory / "large.txt";
+    {
+        std::ofstream output(large, std::ios::binary);
+        output << std::string(4 * allocations::Arena::defaultInitialSize, 'x');
+    }
+    std::vector<std::filesystem::path> inputs(10, large);
+    std::vector<allocations::Stats> parseAllocations;
+    std::vector<allocations::Stats> partAllocations;
+    runBatch(*registry.select().front(), inputs, nullptr, [&](size_t, const Result& result) {
+        EXPECT_EQ(std::to_string(4 * allocations::Arena::defaultInitialSize), result.answers[0]);
+        parseAllocations.push_back(result.parseAllocations);
+        partAllocations.push_back(result.solveAllocations[0]);
+    });
+    ASSERT_EQ(10u, parseAllocations.size());
+    EXPECT_LT(parseAllocations.back().count, parseAllocations.front().count);
+    EXPECT_LT(parseAllocations.back().bytes, allocations::Arena::defaultInitialSize);
+    EXPECT_EQ(0u, partAllocations.back().count);
+}
+
+TEST(ConcurrentRunner, criticalPath)
+{
+    Registry registry = createRegistry();
+    std::vector<Result> results(2);
+    results[0].solver = registry.select(2000, 1).front();
+    results[0].parseTime = std::chrono::nanoseconds(5);
+    results[0].solveTimes = {std::chrono::nanoseconds(1), std::chrono::nanoseconds(7)};
+    results[1].solver = registry.select(2000, 2).front();
+    results[1].parseTime = std::chrono::nanoseconds(1);
+    results[1].solveTimes = {std::chrono::nanoseconds(10), std::chrono::nanoseconds(2)};
+
+    CriticalPath path = findCriticalPath(results);
+    EXPECT_EQ(&results[0], path.result);
+    EXPECT_EQ(2, path.part);
+    EXPECT_EQ(std::chrono::nanoseconds(12), path.length);
+}
+
+TEST(Hash, hash64)
+{
+    EXPECT_EQ(hash64("abc"), hash64(std::string("abc")));
+    EXPECT_NE(hash64("abc"), hash64("abd"));
+    EXPECT_NE(hash64("abc"), hash64("abc", 1));
+    EXPECT_NE(hash64(""), hash64(std::string_view("\0", 1)));
+    EXPECT_NE(hash64("0123456789abcdef"), hash64("0123456789abcdeg"));
+    EXPECT_EQ("00000000000000ff", toHex(0xFF));
+}
+
+class ResultCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory = std::filesystem::temp_directory_path() /
+            ("resultCache_" + std::to_string(::getpid()));
+        calls = 0;
+        registry.add(2000, 1, "numbers.txt",
+            [](std::string_view text) { return std::string(text); },
+            [this](const std::string& text) { calls++; return "line1\n" + text; },
+            [this](const std::string&) { return answer; });
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    std::filesystem::path directory;
+    Registry registry;
+    int calls;
+    std::string answer = "first";
+};
+
+TEST_F(ResultCacheTest, returnsStoredResults)
+{
+    const Solver& solver = *registry.select().front();
+    ResultCache cache(directory, ResultCache::Mode::use, 42);
+
+    Result first = runCached(solver, std::string_view("input"), cache);
+    EXPECT_FALSE(first.cached);
+    EXPECT_EQ(1, calls);
+
+    Result second = runCached(solver, std::string_view("input"), cache);
+    EXPECT_TRUE(second.cached);
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(first.answers, second.answers);
+    EXPECT_EQ(first.parseTime, second.parseTime);
+    EXPECT_EQ(first.solveTimes, second.solveTimes);
+
+    // Other input or other build
+    EXPECT_FALSE(runCached(solver, std::string_view("input2"), cache).cached);
+    EXPECT_FALSE(runCached(solver, std::string_view("input"), ResultCache(directory, ResultCache::Mode::use, 43)).cached);
+    EXPECT_EQ(3, calls);
+}
+
+TEST_F(ResultCacheTest, disabledWithoutBuildHash)
+{
+    const Solver& solver = *registry.select().front();
+    ResultCache cache(directory, ResultCache::Mode::use, std::nullopt);
+    EXPECT_FALSE(cache.isEnabled());
+
+    EXPECT_FALSE(runCached(solver, std::string_view("input"), cache).cached);
+    EXPECT_FALSE(runCached(solver, std::string_view("input"), cache).cached);
+    EXPECT_EQ(2, calls);
+    EXPECT_FALSE(std::filesystem::exists(directory));
+}
+
+TEST_F(ResultCacheTest, verify)
+{
+    const Solver& solver = *registry.select().front();
+    runCached(solver, std::string_view("input"), ResultCache(directory, ResultCache::Mode::use, 42));
+
+    ResultCache verify(directory, ResultCache::Mode::verify, 42);
+    Result result = runCached(solver, std::string_view("input"), verify);
+    EXPECT_FALSE(result.cached);
+    EXPECT_TRUE(result.error.empty());
+    EXPECT_EQ(2, calls);
+
+    answer = "second";
+    result = runCached(solver, std::string_view("input"), verify);
+    EXPECT_EQ("Part 2 differs from the cached answer \"first\"", result.error);
+}
+
+TEST_F(ResultCacheTest, concurrentRunnerUsesCache)
+{
+    auto filepath = directory.string() + ".txt";
+    {
+        std::ofstream output(filepath, std::ios::binary);
+        output << "input";
+    }
+    ResultCache cache(directory, ResultCache::Mode::use, 42);
+    std::vector<Job> jobs = {{registry.select().front(), filepath}};
+    parallel::ThreadPool pool(2);
+
+    EXPECT_FALSE(runConcurrently(jobs, pool, nullptr, &cache).front().cached);
+    std::vector<Result> results = runConcurrently(jobs, pool, nullptr, &cache);
+    std::filesystem::remove(filepath);
+
+    EXPECT_TRUE(results.front().cached);
+    EXPECT_EQ("line1\ninput", results.front().answers[0]);
+    EXPECT_EQ(1, calls);
+}
+
+}
@@ -0,0 +1,90 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "MappedInput.hpp"
+#include "StreamInput.hpp"
+
+namespace puzzleInputs {
+
+static std::vector<std::string> readLines(ChunkReader& reader)
+{
+    LineReader lines(reader);
+    std::vector<std::string> result;
+    while (auto line = lines.next())
+    {
+        result.emplace_back(*line);
+    }
+    return result;
+}
+
+TEST(StreamInput, chunks)
+{
+    ChunkReader reader("abcdefg", 3);
+    EXPECT_EQ("abc", reader.next());
+    EXPECT_EQ("def", reader.next());
+    EXPECT_EQ("g", reader.next());
+    EXPECT_FALSE(reader.next());
+}
+
+TEST(StreamInput, linesLikeLines)
+{
+    for (std::string_view text : {"", "\n", "a", "a\n", "a\nbb\n\nccc", "line one\nline two\n\n\nlast\n",
+        "a\r\nbb\r\n\r\nccc\r"})
+    {
+        Lines lines(text);
+        std::vector<std::string> expected(lines.begin(), lines.end());
+        for (size_t chunkSize : {1, 2, 3, 5, 100})
+        {
+            ChunkReader reader(text, chunkSize);
+            EXPECT_EQ(expected, readLines(reader)) << "\"" << text << "\" in chunks of " << chunkSize;
+        }
+    }
+}
+
+TEST(StreamInput, windowsLineEndings)
+{
+    // The '\r' and the '\n' of a line ending in different chunks
+    for (size_t chunkSize : {1, 2, 3, 4, 100})
+    {
+        ChunkReader reader("ab\r\n\r\ncde\r\nf\r", chunkSize);
+        EXPECT_EQ((std::vector<std::string>{"ab", "", "cde", "f"}), readLines(reader)) << "in chunks of " << chunkSize;
+    }
+}
+
+TEST(StreamInput, readAll)
+{
+    ChunkReader reader("abc\ndef\n", 3);
+    EXPECT_EQ("abc\ndef\n", readAll(reader));
+}
+
+TEST(StreamInput, pipe)
+{
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    std::string_view text = "first\nsecond\nthird";
+    ASSERT_EQ(static_cast<ssize_t>(text.size()), ::write(fds[1], text.data(), text.size()));
+    ::close(fds[1]);
+
+    ChunkReader reader(fds[0], 4);
+    EXPECT_EQ((std::vector<std::string>{"first", "second", "third"}), readLines(reader));
+    ::close(fds[0]);
+}
+
+TEST(StreamInput, pipeWithWindowsLineEndings)
+{
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    std::string_view text = "first\r\nsecond\r\nthird\r\n";
+    ASSERT_EQ(static_cast<ssize_t>(text.size()), ::write(fds[1], text.data(), text.size()));
+    ::close(fds[1]);
+
+    ChunkReader reader(fds[0], 6);
+    EXPECT_EQ((std::vector<std::string>{"first", "second", "third"}), readLines(reader));
+    ::close(fds[0]);
+}
+
+}
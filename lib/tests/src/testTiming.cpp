@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Baseline.hpp"
+#include "Json.hpp"
+#include "TestTiming.hpp"
+
+namespace testTiming {
+
+TEST(TestTiming, measures)
+{
+    Recorder recorder;
+    recorder.start();
+    std::vector<char> memory(64 << 20, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    recorder.stop("Suite.first", true);
+
+    const auto& samples = recorder.getSamples("Suite.first");
+    ASSERT_EQ(1u, samples.size());
+    EXPECT_GE(samples[0].wallTime, std::chrono::milliseconds(5));
+    EXPECT_GE(samples[0].cpuTime.count(), 0);
+    EXPECT_GE(samples[0].peakRss, memory.size());
+    EXPECT_TRUE(samples[0].passed);
+}
+
+TEST(TestTiming, writesBenchmarkResults)
+{
+    Recorder recorder;
+    for (int i = 0; i < 3; ++i)
+    {
+        recorder.start();
+        recorder.stop("Suite.second", true);
+        recorder.start();
+        recorder.stop("Suite.first", i != 1);
+    }
+    EXPECT_EQ(2u, recorder.getNumOfTests());
+
+    benchmarking::Json output = recorder.toJson("tests");
+    EXPECT_EQ("tests", output.find("context")->find("executable")->asString());
+    const auto& benchmarks = output.find("benchmarks")->asArray();
+    ASSERT_EQ(6u, benchmarks.size());
+    EXPECT_EQ("Suite.second", benchmarks[0].find("name")->asString());
+    EXPECT_EQ(3, benchmarks[0].find("repetitions")->asNumber());
+    EXPECT_EQ("Suite.first", benchmarks[3].find("name")->asString());
+
+    // The failed run is left out
+    benchmarking::Runs runs;
+    benchmarking::collectRuns(output, runs);
+    EXPECT_EQ(3u, runs.at("Suite.second").realTimes.size());
+    EXPECT_EQ(2u, runs.at("Suite.first").realTimes.size());
+    EXPECT_EQ(2u, runs.at("Suite.first").counters.at("peak_rss_bytes").size());
+}
+
+TEST(TestTiming, options)
+{
+    ::setenv("AOC_TEST_TIMING", "timing.json", 1);
+    ::setenv("AOC_TEST_REPEAT", "5", 1);
+    Options options = Options::fromEnvironment();
+    EXPECT_EQ("timing.json", options.output);
+    EXPECT_EQ(5, options.repeat);
+
+    ::unsetenv("AOC_TEST_TIMING");
+    ::setenv("AOC_TEST_REPEAT", "x", 1);
+    options = Options::fromEnvironment();
+    EXPECT_FALSE(options.output);
+    EXPECT_EQ(1, options.repeat);
+    ::unsetenv("AOC_TEST_REPEAT");
+}
+
+}
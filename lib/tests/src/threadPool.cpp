@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Parallel.hpp"
+#include "ThreadPool.hpp"
+
+namespace parallel {
+
+TEST(ThreadPool, runsAllTasks)
+{
+    for (size_t threads : {1, 2, 4})
+    {
+        ThreadPool pool(threads);
+        EXPECT_EQ(threads, pool.getNumOfThreads());
+
+        std::atomic<int> sum{0};
+        for (int i = 1; i <= 1000; ++i)
+        {
+            pool.submit([&sum, i]() { sum += i; });
+        }
+        pool.wait();
+        EXPECT_EQ(500500, sum.load());
+    }
+}
+
+TEST(ThreadPool, waitsForNestedTasks)
+{
+    ThreadPool pool(3);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 10; ++i)
+    {
+        pool.submit([&]() {
+            for (int j = 0; j < 10; ++j)
+            {
+                pool.submit([&]() { count++; });
+            }
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(100, count.load());
+}
+
+TEST(ThreadPool, rethrowsFirstException)
+{
+    ThreadPool pool(2);
+    std::atomic<int> count{0};
+    pool.submit([]() { throw std::runtime_error("failed"); });
+    for (int i = 0; i < 10; ++i)
+    {
+        pool.submit([&count]() { count++; });
+    }
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(10, count.load());
+
+    // The pool stays usable
+    pool.submit([&count]() { count++; });
+    EXPECT_NO_THROW(pool.wait());
+    EXPECT_EQ(11, count.load());
+}
+
+TEST(ThreadPool, defaultsToHardwareThreads)
+{
+    EXPECT_GE(resolveNumOfThreads(0), 1u);
+    EXPECT_EQ(3u, resolveNumOfThreads(3));
+}
+
+TEST(Parallel, forVisitsEveryIndexOnce)
+{
+    ThreadPool pool(4);
+    for (size_t grain : {1, 3, 1000})
+    {
+        std::vector<int> visits(1000, 0);
+        parallelFor(pool, 0, visits.size(), [&visits](size_t i) { visits[i]++; }, grain);
+        EXPECT_EQ(std::vector<int>(1000, 1), visits);
+    }
+    parallelFor(pool, 5, 5, [](size_t) { FAIL(); });
+}
+
+TEST(Parallel, reduceIsDeterministic)
+{
+    // Floating point addition is not associative, the chunking must not
+    // depend on the number of threads
+    auto sum = [](ThreadPool* pool) {
+        return parallelReduce(pool, 0, 100000, 0.0,
+            [](size_t i) { return 1.0 / (i + 1); },
+            [](double lhs, double rhs) { return lhs + rhs; }, 64);
+    };
+    double expected = sum(nullptr);
+    for (size_t threads : {1, 2, 4})
+    {
+        ThreadPool pool(threads);
+        EXPECT_EQ(expected, sum(&pool));
+    }
+
+    ThreadPool pool(3);
+    EXPECT_EQ(4950, parallelReduce(pool, 0, 100, 0, [](size_t i) { return static_cast<int>(i); }, std::plus<int>()));
+    EXPECT_EQ(7, parallelReduce(pool, 0, 0, 7, [](size_t) { return 1; }, std::plus<int>()));
+}
+
+TEST(Parallel, nestedInPoolTasks)
+{
+    ThreadPool pool(2);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 8; ++i)
+    {
+        pool.submit([&]() {
+            parallelFor(pool, 0, 100, [&count](size_t) { count++; });
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(800, count.load());
+}
+
+TEST(Parallel, forRethrows)
+{
+    ThreadPool pool(3);
+    EXPECT_THROW(parallelFor(pool, 0, 100, [](size_t i) {
+        if (i == 42)
+        {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST(Parallel, sharedPool)
+{
+    EXPECT_EQ(45u, parallelReduce(size_t(0), size_t(10), size_t(0), [](size_t i) { return i; }, std::plus<size_t>()));
+    EXPECT_EQ(getNumOfThreads(), getSharedPool().getNumOfThreads());
+    EXPECT_NO_THROW(setNumOfThreads(getNumOfThreads()));
+    EXPECT_THROW(setNumOfThreads(getNumOfThreads() + 1), std::logic_error);
+}
+
+TEST(TaskGraph, respectsDependencies)
+{
+    ThreadPool pool(4);
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int task) {
+        return [&, task]() {
+            std::lock_guard lock(mutex);
+            order.push_back(task);
+        };
+    };
+
+    //   0   1
+    //  / \ /
+    // 2   3
+    //  \ /
+    //   4
+    TaskGraph graph;
+    TaskGraph::Id a = graph.add(record(0));
+    TaskGraph::Id b = graph.add(record(1));
+    TaskGraph::Id c = graph.add(record(2), {a});
+    TaskGraph::Id d = graph.add(record(3), {a, b});
+    graph.add(record(4), {c, d});
+    EXPECT_EQ(5u, graph.size());
+
+    for (int run = 0; run < 20; ++run)
+    {
+        order.clear();
+        graph.run(pool);
+        ASSERT_EQ(5u, order.size());
+        auto position = [&order](int task) { return std::find(order.begin(), order.end(), task) - order.begin(); };
+        EXPECT_LT(position(0), position(2));
+        EXPECT_LT(position(0), position(3));
+        EXPECT_LT(position(1), position(3));
+        EXPECT_LT(position(2), position(4));
+        EXPECT_LT(position(3), position(4));
+    }
+
+    EXPECT_THROW(graph.add([]() {}, {7}), std::invalid_argument);
+}
+
+TEST(TaskGraph, skipsTasksAfterFailure)
+{
+    ThreadPool pool(2);
+    std::atomic<int> count{0};
+    TaskGraph graph;
+    TaskGraph::Id failing = graph.add([]() { throw std::runtime_error("failed"); });
+    graph.add([&count]() { count++; }, {failing});
+    EXPECT_THROW(graph.run(pool), std::runtime_error);
+    EXPECT_EQ(0, count.load());
+}
+
+TEST(TaskGraph, runsInsidePoolTasks)
+{
+    ThreadPool pool(2);
+    std::atomic<int> count{0};
+    TaskGraph graph;
+    std::vector<TaskGraph::Id> leaves;
+    for (int i = 0; i < 10; ++i)
+    {
+        leaves.push_back(graph.add([&count]() { count++; }));
+    }
+    graph.add([&count]() { count += 100; }, leaves);
+
+    pool.submit([&]() { graph.run(pool); });
+    pool.wait();
+    EXPECT_EQ(110, count.load());
+}
+
+}
@@ -0,0 +1,309 @@
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+#include "BatchRunner.hpp"
+#include "ConcurrentRunner.hpp"
+#include "Latencies.hpp"
+#include "Parallel.hpp"
+#include "Registry.hpp"
+#include "Report.hpp"
+#include "ResultCache.hpp"
+#include "Runner.hpp"
+#include "Scanner.hpp"
+#include "StreamInput.hpp"
+#include "solvers2018.hpp"
+#include "solvers2023.hpp"
+
+namespace
+{
+void printUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [--json] [--list] [--threads <n>]\n"
+        << "           [--no-cache | --verify-cache] [--cache-dir <dir>] [<year> [<day> [<input>]]]\n"
+        << "       " << name << " --batch <dir|manifest> [--json] [--threads <n>] <year> <day>\n"
+        << "       " << name << " --repeat <n> [--json] [--threads <n>] [<year> [<day> [<input>]]]\n"
+        << "  Runs every solver, the ones of a year or a single day on its\n"
+        << "  default puzzle input or on the given input file, - reads stdin.\n"
+        << "  --batch <dir|manifest>  solve every file of the directory or every\n"
+        << "                 file listed in the manifest, one path per line, with\n"
+        << "                 the solver of one day. Results are printed as each\n"
+        << "                 input is solved, with --json as JSON Lines, and are\n"
+        << "                 not cached\n"
+        << "  --repeat <n>   solve every input n times and report p50, p99 and max\n"
+        << "                 of the parse, build and part phases; nothing is cached\n"
+        << "  --json  print the answers and timings as JSON\n"
+        << "  --list  only list the available solvers\n"
+        << "  --threads <n>  run days and parts concurrently on n threads\n"
+        << "                 (0: all cores) and report the critical path,\n"
+        << "                 solvers that split their work use as many threads\n"
+        << "                 (default: all cores), with --batch one shard of\n"
+        << "                 inputs per thread\n"
+        << "  --no-cache     always solve, neither read nor write cached results\n"
+        << "  --verify-cache always solve and fail on answers that differ from the cache\n"
+        << "  --cache-dir <dir>  where results are cached, default "
+        << solvers::getDefaultCacheDirectory().string() << std::endl;
+}
+}
+
+
+int main(int argc, char* argv[])
+{
+    solvers::Registry registry;
+    aoc2018::registerSolvers(registry);
+    aoc2023::registerSolvers(registry);
+
+    bool json = false;
+    bool list = false;
+    std::optional<std::string_view> threads;
+    bool useCache = true;
+    auto cacheMode = solvers::ResultCache::Mode::use;
+    std::filesystem::path cacheDirectory = solvers::getDefaultCacheDirectory();
+    std::optional<std::filesystem::path> batch;
+    std::optional<std::string_view> repeat;
+    std::vector<std::string_view> positional;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg(argv[i]);
+        if (arg == "--json")
+        {
+            json = true;
+        }
+        else if (arg == "--list")
+        {
+            list = true;
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            threads = argv[++i];
+        }
+        else if (arg == "--no-cache")
+        {
+            useCache = false;
+        }
+        else if (arg == "--verify-cache")
+        {
+            cacheMode = solvers::ResultCache::Mode::verify;
+        }
+        else if (arg == "--cache-dir" && i + 1 < argc)
+        {
+            cacheDirectory = argv[++i];
+        }
+        else if (arg == "--batch" && i + 1 < argc)
+        {
+            batch = argv[++i];
+        }
+        else if (arg == "--repeat" && i + 1 < argc)
+        {
+            repeat = argv[++i];
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (arg.starts_with("--"))
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() > 3 || (batch && positional.size() != 2) || (batch && repeat))
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::vector<const solvers::Solver*> selected;
+    std::optional<std::filesystem::path> input;
+    std::optional<size_t> numOfThreads;
+    int repetitions = 0;
+    try
+    {
+        if (repeat)
+        {
+            repetitions = scanner::toInteger<int>(*repeat);
+            if (repetitions < 1)
+            {
+                throw std::invalid_argument("--repeat needs at least 1");
+            }
+        }
+        if (threads)
+        {
+            numOfThreads = scanner::toInteger<size_t>(*threads);
+            parallel::setNumOfThreads(*numOfThreads);
+        }
+        std::optional<int> year;
+        std::optional<int> day;
+        if (positional.size() > 0)
+        {
+            year = scanner::toInteger<int>(positional[0]);
+        }
+        if (positional.size() > 1)
+        {
+            day = scanner::toInteger<int>(positional[1]);
+        }
+        if (positional.size() > 2)
+        {
+            input = std::filesystem::path(positional[2]);
+        }
+        selected = registry.select(year, day);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (selected.empty())
+    {
+        std::cerr << "No solver found" << std::endl;
+        return 1;
+    }
+
+    if (list)
+    {
+        for (const auto* solver : selected)
+        {
+            std::cout << solver->getName() << "  " << solver->getDefaultInput().string() << '\n';
+        }
+        return 0;
+    }
+
+    if (batch)
+    {
+        std::vector<std::filesystem::path> inputs;
+        try
+        {
+            inputs = solvers::findBatchInputs(*batch);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 2;
+        }
+
+        auto batchSummary = solvers::runBatch(*selected.front(), inputs,
+            [json](size_t, const solvers::Result& result) {
+                if (json)
+                {
+                    solvers::printBatchJsonResult(std::cout, result);
+                }
+                else
+                {
+                    solvers::printBatchResult(std::cout, result);
+                }
+            });
+        solvers::printBatchSummary(json ? std::cerr : std::cout, batchSummary);
+        return batchSummary.numOfFailures > 0 ? 1 : 0;
+    }
+
+    if (repeat)
+    {
+        if (input == "-")
+        {
+            std::cerr << "Stdin can only be read once, --repeat needs an input file" << std::endl;
+            return 2;
+        }
+
+        std::vector<solvers::Latencies> latencies;
+        for (const auto* solver : selected)
+        {
+            latencies.push_back(solvers::measureLatencies(*solver, input.value_or(solver->getDefaultInput()), repetitions));
+        }
+        if (json)
+        {
+            solvers::printJsonLatencies(std::cout, latencies);
+        }
+        else
+        {
+            solvers::printLatencies(std::cout, latencies);
+        }
+        bool failed = std::any_of(latencies.begin(), latencies.end(),
+            [](const solvers::Latencies& result) { return !result.error.empty(); });
+        return failed ? 1 : 0;
+    }
+
+    std::vector<solvers::Result> results;
+    std::optional<solvers::Summary> summary;
+    if (input == "-")
+    {
+        // Piped input can be read once, by one solver and is not cached
+        if (selected.size() != 1)
+        {
+            std::cerr << "Reading stdin needs a year and a day" << std::endl;
+            return 2;
+        }
+        puzzleInputs::ChunkReader reader(STDIN_FILENO);
+        results.push_back(solvers::run(*selected.front(), reader));
+    }
+    else
+    {
+        std::optional<solvers::ResultCache> cache;
+        if (useCache && !solvers::hashExecutable())
+        {
+            std::cerr << "Cannot read the executable to identify the build, results are not cached" << std::endl;
+        }
+        else if (useCache)
+        {
+            cache.emplace(cacheDirectory, cacheMode);
+        }
+
+        if (numOfThreads)
+        {
+            std::vector<solvers::Job> jobs;
+            for (const auto* solver : selected)
+            {
+                jobs.push_back({solver, input.value_or(solver->getDefaultInput())});
+            }
+
+            // The same pool the solvers split their work on
+            summary.emplace();
+            results = solvers::runConcurrently(jobs, parallel::getSharedPool(), &*summary, cache ? &*cache : nullptr);
+        }
+        else
+        {
+            for (const auto* solver : selected)
+            {
+                auto path = input.value_or(solver->getDefaultInput());
+                results.push_back(cache ? solvers::runCached(*solver, path, *cache) : solvers::run(*solver, path));
+            }
+        }
+    }
+
+    if (json && summary)
+    {
+        solvers::printJson(std::cout, results, *summary);
+    }
+    else if (json)
+    {
+        solvers::printJson(std::cout, results);
+    }
+    else
+    {
+        solvers::printText(std::cout, results);
+        if (summary)
+        {
+            solvers::printSummary(std::cout, *summary);
+        }
+    }
+
+    bool failed = std::any_of(results.begin(), results.end(),
+        [](const solvers::Result& result) { return !result.error.empty(); });
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,364 @@
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Baseline.hpp"
+#include "Json.hpp"
+#include "Scanner.hpp"
+
+namespace
+{
+void printUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " record|compare <baseline> [<results.json>...] [--bench <binary>]\n"
+        << "           [--repetitions <n>] [--runs <n>] [--confirm <n>] [--filter <regex>]\n"
+        << "           [--threshold <t>] [--noise <k>] [--ignore-machine] [--all]\n"
+        << "  record   store the results as the new baseline, thresholds set per\n"
+        << "           benchmark in an existing baseline are kept\n"
+        << "  compare  compare the results with the baseline, exits with 1 if a\n"
+        << "           benchmark got slower, allocates more than allowed or is\n"
+        << "           missing, and with 2 if the baseline is from another machine\n"
+        << "  <results.json>  output of a benchmark binary run with\n"
+        << "                  --benchmark_format=json --benchmark_repetitions=<n>,\n"
+        << "                  each file counts as a separate run\n"
+        << "  --bench <binary>     run the benchmark binary instead\n"
+        << "  --repetitions <n>    repetitions of each benchmark with --bench (default: 10)\n"
+        << "  --runs <n>           separate runs of the binary, the fastest of each\n"
+        << "                       benchmark counts (default: 3 for record, 1 for compare)\n"
+        << "  --confirm <n>        run the slower benchmarks up to n times again before\n"
+        << "                       failing, the fastest run counts (default: 2)\n"
+        << "  --filter <regex>     only run the matching benchmarks with --bench\n"
+        << "  --threshold <t>      relative change that counts, default 0.1 for 10%\n"
+        << "  --noise <k>          the change also has to exceed k times the noise\n"
+        << "                       of both runs and between runs (default: 3)\n"
+        << "  --ignore-machine     compare with a baseline from another machine or\n"
+        << "                       build anyway\n"
+        << "  --all                also list the unchanged benchmarks" << std::endl;
+}
+
+
+std::string quote(std::string_view arg)
+{
+    std::string quoted = "'";
+    for (char c : arg)
+    {
+        if (c == '\'')
+        {
+            quoted += "'\\''";
+        }
+        else
+        {
+            quoted += c;
+        }
+    }
+    quoted += '\'';
+    return quoted;
+}
+
+
+benchmarking::Json runBenchmarks(const std::filesystem::path& binary, int repetitions, std::optional<std::string_view> filter)
+{
+    // Interleaved, the repetitions of a benchmark are spread over the run,
+    // and a while the machine is busy slows a few of each, not all of a few
+    std::string command = quote(binary.string());
+    command += " --benchmark_format=json --benchmark_enable_random_interleaving=true";
+    command += " --benchmark_repetitions=" + std::to_string(repetitions);
+    if (filter)
+    {
+        command += " --benchmark_filter=";
+        command += quote(*filter);
+    }
+
+    std::FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe)
+    {
+        throw std::runtime_error("Cannot run " + binary.string());
+    }
+    std::string output;
+    char buffer[4096];
+    while (size_t size = std::fread(buffer, 1, sizeof(buffer), pipe))
+    {
+        output.append(buffer, size);
+    }
+    if (pclose(pipe) != 0)
+    {
+        throw std::runtime_error(binary.string() + " failed");
+    }
+    return benchmarking::Json::parse(output);
+}
+
+
+// Regular expression matching exactly the given benchmarks
+std::string matchExactly(const std::vector<std::string>& names)
+{
+    std::string regex = "^(";
+    for (const auto& name : names)
+    {
+        if (regex.size() > 2)
+        {
+            regex += '|';
+        }
+        for (char c : name)
+        {
+            if (std::string_view(".[]()*+?{}|^$\\").find(c) != std::string_view::npos)
+            {
+                regex += '\\';
+            }
+            regex += c;
+        }
+    }
+    regex += ")$";
+    return regex;
+}
+
+
+std::vector<std::string> getRegressed(const std::vector<benchmarking::Comparison>& comparisons)
+{
+    std::vector<std::string> names;
+    for (const auto& comparison : comparisons)
+    {
+        bool listed = !names.empty() && names.back() == comparison.benchmark;
+        if (comparison.verdict == benchmarking::Verdict::regressed && !listed)
+        {
+            names.push_back(comparison.benchmark);
+        }
+    }
+    return names;
+}
+
+
+std::string formatValue(double value, std::string_view metric)
+{
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(3);
+    if (metric == "real_time_ns")
+    {
+        if (value >= 1e6)
+        {
+            text << value / 1e6 << " ms";
+        }
+        else if (value >= 1e3)
+        {
+            text << value / 1e3 << " us";
+        }
+        else
+        {
+            text << value << " ns";
+        }
+    }
+    else
+    {
+        text << std::setprecision(0) << value;
+    }
+    return text.str();
+}
+
+
+void printComparisons(std::ostream& out, const std::vector<benchmarking::Comparison>& comparisons, bool all)
+{
+    size_t numOfRegressions = 0;
+    size_t numOfMissing = 0;
+    size_t numOfImprovements = 0;
+    for (const auto& comparison : comparisons)
+    {
+        using benchmarking::Verdict;
+        numOfRegressions += comparison.verdict == Verdict::regressed;
+        numOfMissing += comparison.verdict == Verdict::missing;
+        numOfImprovements += comparison.verdict == Verdict::improved;
+        if (comparison.verdict == Verdict::unchanged && !all)
+        {
+            continue;
+        }
+
+        out << std::left << std::setw(40) << comparison.benchmark << ' ' << std::setw(16) << comparison.metric << std::right;
+        if (comparison.verdict == Verdict::added)
+        {
+            out << std::setw(14) << "" << "    " << std::setw(14) << formatValue(comparison.current, comparison.metric);
+        }
+        else if (comparison.verdict == Verdict::missing)
+        {
+            out << std::setw(14) << formatValue(comparison.baseline, comparison.metric);
+        }
+        else
+        {
+            out << std::setw(14) << formatValue(comparison.baseline, comparison.metric) << " -> "
+                << std::setw(14) << formatValue(comparison.current, comparison.metric)
+                << std::showpos << std::fixed << std::setprecision(1) << std::setw(9) << comparison.getChange() * 100 << '%'
+                << std::noshowpos;
+        }
+        out << "  " << benchmarking::toString(comparison.verdict) << '\n';
+    }
+    out << numOfRegressions << " regressions, " << numOfMissing << " missing, "
+        << numOfImprovements << " improvements" << std::endl;
+}
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string_view> positional;
+    std::optional<std::filesystem::path> bench;
+    int repetitions = 10;
+    std::optional<int> runs;
+    int confirm = 2;
+    std::optional<std::string_view> filter;
+    benchmarking::GateOptions options;
+    bool ignoreMachine = false;
+    bool all = false;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg(argv[i]);
+            if (arg == "--bench" && i + 1 < argc)
+            {
+                bench = argv[++i];
+            }
+            else if (arg == "--repetitions" && i + 1 < argc)
+            {
+                repetitions = scanner::toInteger<int>(argv[++i]);
+            }
+            else if (arg == "--runs" && i + 1 < argc)
+            {
+                runs = scanner::toInteger<int>(argv[++i]);
+            }
+            else if (arg == "--confirm" && i + 1 < argc)
+            {
+                confirm = scanner::toInteger<int>(argv[++i]);
+            }
+            else if (arg == "--filter" && i + 1 < argc)
+            {
+                filter = argv[++i];
+            }
+            else if (arg == "--threshold" && i + 1 < argc)
+            {
+                options.threshold = std::stod(argv[++i]);
+            }
+            else if (arg == "--noise" && i + 1 < argc)
+            {
+                options.noise = std::stod(argv[++i]);
+            }
+            else if (arg == "--ignore-machine")
+            {
+                ignoreMachine = true;
+            }
+            else if (arg == "--all")
+            {
+                all = true;
+            }
+            else if (arg == "--help" || arg == "-h")
+            {
+                printUsage(argv[0]);
+                return 0;
+            }
+            else if (arg.starts_with("--"))
+            {
+                std::cerr << "Unknown option " << arg << std::endl;
+                printUsage(argv[0]);
+                return 2;
+            }
+            else
+            {
+                positional.push_back(arg);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (positional.size() < 2 || (positional[0] != "record" && positional[0] != "compare") ||
+        (positional.size() == 2 && !bench))
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+    std::filesystem::path baselinePath(positional[1]);
+
+    try
+    {
+        bool record = positional[0] == "record";
+        std::vector<benchmarking::Runs> rounds;
+        benchmarking::Json machine;
+        for (int i = 0; bench && i < runs.value_or(record ? 3 : 1); ++i)
+        {
+            benchmarking::Json output = runBenchmarks(*bench, repetitions, filter);
+            if (const auto* context = output.find("context"))
+            {
+                machine = benchmarking::getMachine(*context);
+            }
+            benchmarking::collectRuns(output, rounds.emplace_back());
+        }
+        for (size_t i = 2; i < positional.size(); ++i)
+        {
+            benchmarking::Json output = benchmarking::readJson(positional[i]);
+            if (const auto* context = output.find("context"))
+            {
+                machine = benchmarking::getMachine(*context);
+            }
+            benchmarking::collectRuns(output, rounds.emplace_back());
+        }
+        benchmarking::Baseline current = benchmarking::summarize(rounds, machine);
+
+        if (record)
+        {
+            if (std::filesystem::exists(baselinePath))
+            {
+                benchmarking::keepThresholds(current, benchmarking::loadBaseline(baselinePath));
+            }
+            benchmarking::saveBaseline(baselinePath, current);
+            std::cout << "Recorded " << current.benchmarks.size() << " benchmarks from " << rounds.size()
+                << " runs in " << baselinePath.string() << std::endl;
+            return 0;
+        }
+
+        // Timings from another machine or build would fail or pass the gate
+        // for reasons that have nothing to do with the change
+        benchmarking::Baseline baseline = benchmarking::loadBaseline(baselinePath);
+        auto mismatches = benchmarking::findMachineMismatches(baseline.context, current.context);
+        for (const auto& mismatch : mismatches)
+        {
+            std::cerr << "Baseline from another machine or build, " << mismatch << std::endl;
+        }
+        if (!mismatches.empty() && !ignoreMachine)
+        {
+            std::cerr << "Record a baseline here or pass --ignore-machine" << std::endl;
+            return 2;
+        }
+
+        auto comparisons = benchmarking::compare(baseline, current, options);
+        for (int i = 0; bench && i < confirm && benchmarking::hasRegressions(comparisons); ++i)
+        {
+            auto regressed = getRegressed(comparisons);
+            std::cerr << "Running " << regressed.size() << " slower benchmarks again" << std::endl;
+            benchmarking::Runs rerun;
+            benchmarking::collectRuns(runBenchmarks(*bench, repetitions, matchExactly(regressed)), rerun);
+            benchmarking::keepFastest(current, benchmarking::summarize(rerun));
+            comparisons = benchmarking::compare(baseline, current, options);
+        }
+        if (filter)
+        {
+            // Benchmarks the filter left out are not missing
+            std::erase_if(comparisons, [](const benchmarking::Comparison& comparison) {
+                return comparison.verdict == benchmarking::Verdict::missing;
+            });
+        }
+        printComparisons(std::cout, comparisons, all);
+        return benchmarking::failsGate(comparisons) ? 1 : 0;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+}